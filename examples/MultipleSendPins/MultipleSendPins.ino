@@ -2,6 +2,7 @@
  * MultipleSendPins.cpp
  *
  *  Demonstrates sending IR codes toggling between 2 different send pins.
+ *  If USE_MULTIPLE_SEND_PINS is defined, the codes are sent simultaneously at both pins.
  *  Based on SimpleSender.
  *
  *  Copyright (C) 2025  Armin Joachimsmeyer
@@ -19,6 +20,7 @@
 
 //#define USE_NO_SEND_PWM           // Use no carrier PWM, just simulate an active low receiver signal. Overrides SEND_PWM_BY_TIMER definition
 //#define NO_LED_FEEDBACK_CODE      // Saves 52 bytes program memory
+//#define USE_MULTIPLE_SEND_PINS    // Send simultaneously at pin 3 and 4
 
 #include <IRremote.hpp> // include the library
 
@@ -29,12 +31,20 @@ void setup() {
 
     // Just to know which program is running on my Arduino
     Serial.println(F("START " __FILE__ " from " __DATE__ "\r\nUsing library version " VERSION_IRREMOTE));
+#if defined(USE_MULTIPLE_SEND_PINS)
+    Serial.print(F("Send IR signals simultaneously at pin 3 and 4"));
+#else
     Serial.print(F("Send IR signals alternating at pin 3 and 4"));
+#endif
 
     /*
      * The IR library setup. That's all!
      */
     IrSender.begin(3); // Start with pin3 as send pin and enable feedback LED at default feedback LED pin
+#if defined(USE_MULTIPLE_SEND_PINS)
+    const uint8_t tSendPins[] = { 3, 4 };
+    IrSender.setSendPins(tSendPins, sizeof(tSendPins));
+#endif
     disableLEDFeedback(); // Disable feedback LED at default feedback LED pin
 }
 
@@ -84,6 +94,7 @@ void loop() {
         sRepeats = 4;
     }
 
+#if !defined(USE_MULTIPLE_SEND_PINS)
     /*
      * Toggle between send pin 3 and 4
      */
@@ -92,5 +103,6 @@ void loop() {
     } else {
         IrSender.setSendPin(3);
     }
+#endif
     delay(1000);  // delay must be greater than 5 ms (RECORD_GAP_MICROS), otherwise the receiver sees it as one long signal
 }
@@ -48,6 +48,7 @@
 
 #include "PinDefinitionsAndMore.h" // Define macros for input and output pin etc. Sets FLASHEND and RAMSIZE and evaluates value of SEND_PWM_BY_TIMER.
 
+//#define USE_TIMER_FOR_TINY_SENDER // Use non blocking sending by hardware timer. Only for ATtiny85 and ATmega328.
 #include "TinyIRSender.hpp"
 
 void setup() {
@@ -86,6 +87,19 @@ void loop() {
     Serial.print(sRepeats);
     Serial.println();
 
+#if defined(USE_TIMER_FOR_TINY_SENDER)
+    // Send NEC in the background and do something useful in the meantime
+    Serial.println(F("Send NEC non blocking"));
+    Serial.flush();
+    startSendNEC(sAddress, sCommand, sRepeats);
+    uint16_t tLoopCount = 0;
+    while (isTinyIRSenderBusy()) {
+        tLoopCount++;
+    }
+    Serial.print(F("Loops while sending="));
+    Serial.println(tLoopCount);
+#endif
+
     // Send with FAST
     // No address and only 16 bits of data, interpreted as 8 bit command and 8 bit inverted command for parity checking
     Serial.println(F("Send FAST with 8 bit command"));
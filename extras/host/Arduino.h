@@ -0,0 +1,264 @@
+/*
+ * Arduino.h
+ *
+ * Minimal Arduino API for compiling the IRremote library with a host compiler like g++ or clang++.
+ * It defines IR_HOST_BUILD, which selects the empty timer functions in IRTimer.hpp.
+ * There is no IR hardware, received frames must be supplied by readBinaryRecord() or replayRawFrame().
+ * Only the functions used by the library and the tools in this directory are implemented.
+ *
+ *  This file is part of Arduino-IRremote https://github.com/Arduino-IRremote/Arduino-IRremote.
+ *
+ *************************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2026 Armin Joachimsmeyer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ ************************************************************************************
+ */
+#ifndef _IR_HOST_ARDUINO_H
+#define _IR_HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <math.h>
+#include <chrono>
+#include <string>
+
+#define IR_HOST_BUILD
+#if !defined(F_CPU)
+#define F_CPU 16000000L
+#endif
+
+#define HIGH            1
+#define LOW             0
+#define INPUT           0
+#define OUTPUT          1
+#define INPUT_PULLUP    2
+#define LED_BUILTIN     13
+#define BIN             2
+#define DEC             10
+#define HEX             16
+#define CHANGE          1
+
+#define PROGMEM
+#define PGM_P const char*
+#define pgm_read_byte(aAddress)     (*(const uint8_t*)(aAddress))
+#define pgm_read_word(aAddress)     (*(const uint16_t*)(aAddress))
+#define pgm_read_dword(aAddress)    (*(const uint32_t*)(aAddress))
+#define memcpy_P                    memcpy
+#define strcpy_P                    strcpy
+#define strlen_P                    strlen
+#define clockCyclesPerMicrosecond() (F_CPU / 1000000L)
+
+class __FlashStringHelper;
+#define F(aString)      (reinterpret_cast<const __FlashStringHelper *>(aString))
+#define FPSTR(aString)  (reinterpret_cast<const __FlashStringHelper *>(aString))
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+/*
+ * Timing
+ */
+inline unsigned long micros() {
+    return (unsigned long) std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+inline unsigned long millis() {
+    return micros() / 1000;
+}
+// No waiting on host, e.g. the gaps between repeats are skipped
+inline void delay(unsigned long aMillis) {
+    (void) aMillis;
+}
+inline void delayMicroseconds(unsigned int aMicros) {
+    (void) aMicros;
+}
+inline void yield() {
+}
+
+/*
+ * No pins and interrupts on host
+ */
+inline void pinMode(uint8_t aPin, uint8_t aMode) {
+    (void) aPin;
+    (void) aMode;
+}
+inline void digitalWrite(uint8_t aPin, uint8_t aValue) {
+    (void) aPin;
+    (void) aValue;
+}
+inline int digitalRead(uint8_t aPin) {
+    (void) aPin;
+    return HIGH; // inactive level of IR receiver modules
+}
+inline void noInterrupts() {
+}
+inline void interrupts() {
+}
+#define digitalPinToInterrupt(aPin) (aPin)
+inline void attachInterrupt(uint8_t aInterruptNumber, void (*aFunction)(), int aMode) {
+    (void) aInterruptNumber;
+    (void) aFunction;
+    (void) aMode;
+}
+inline void detachInterrupt(uint8_t aInterruptNumber) {
+    (void) aInterruptNumber;
+}
+
+/*
+ * Print writes to stdout
+ */
+class Print {
+public:
+    virtual ~Print() {
+    }
+    virtual size_t write(uint8_t aByte) {
+        putchar(aByte);
+        return 1;
+    }
+    size_t write(const uint8_t *aBuffer, size_t aSize) {
+        for (size_t i = 0; i < aSize; i++) {
+            write(aBuffer[i]);
+        }
+        return aSize;
+    }
+    size_t print(const __FlashStringHelper *aString) {
+        return print(reinterpret_cast<const char*>(aString));
+    }
+    size_t print(const char *aString) {
+        size_t tLength = 0;
+        while (*aString) {
+            tLength += write(*aString++);
+        }
+        return tLength;
+    }
+    size_t print(char aChar) {
+        return write(aChar);
+    }
+    size_t print(unsigned long aValue, int aBase = DEC) {
+        char tBuffer[8 * sizeof(aValue) + 1];
+        char *tPtr = &tBuffer[sizeof(tBuffer) - 1];
+        *tPtr = '\0';
+        do {
+            uint_fast8_t tDigit = aValue % aBase;
+            *--tPtr = tDigit < 10 ? '0' + tDigit : 'A' + tDigit - 10;
+            aValue /= aBase;
+        } while (aValue);
+        return print(tPtr);
+    }
+    size_t print(long aValue, int aBase = DEC) {
+        if (aBase == DEC && aValue < 0) {
+            return print('-') + print((unsigned long) -aValue, DEC);
+        }
+        return print((unsigned long) aValue, aBase);
+    }
+    size_t print(unsigned int aValue, int aBase = DEC) {
+        return print((unsigned long) aValue, aBase);
+    }
+    size_t print(int aValue, int aBase = DEC) {
+        return print((long) aValue, aBase);
+    }
+    size_t print(unsigned char aValue, int aBase = DEC) {
+        return print((unsigned long) aValue, aBase);
+    }
+    size_t print(double aValue, int aDigits = 2) {
+        char tBuffer[40];
+        snprintf(tBuffer, sizeof(tBuffer), "%.*f", aDigits, aValue);
+        return print(tBuffer);
+    }
+    template<typename T> size_t println(T aValue) {
+        return print(aValue) + println();
+    }
+    template<typename T> size_t println(T aValue, int aBaseOrDigits) {
+        return print(aValue, aBaseOrDigits) + println();
+    }
+    size_t println() {
+        return print("\r\n");
+    }
+    void flush() {
+        fflush(stdout);
+    }
+};
+
+class HardwareSerial: public Print {
+public:
+    void begin(unsigned long aBaudrate) {
+        (void) aBaudrate;
+    }
+    operator bool() {
+        return true;
+    }
+    int available() {
+        return 0;
+    }
+    int read() {
+        return -1;
+    }
+};
+extern HardwareSerial Serial;
+
+/*
+ * Only the functions used for Pronto output
+ */
+class String {
+public:
+    String() {
+    }
+    String(const char *aString) :
+            Content(aString) {
+    }
+    size_t length() const {
+        return Content.size();
+    }
+    bool reserve(size_t aSize) {
+        Content.reserve(aSize);
+        return true;
+    }
+    bool concat(char aChar) {
+        Content += aChar;
+        return true;
+    }
+    bool concat(const char *aString) {
+        Content += aString;
+        return true;
+    }
+    bool concat(unsigned int aValue) {
+        Content += std::to_string(aValue);
+        return true;
+    }
+    String& operator +=(char aChar) {
+        Content += aChar;
+        return *this;
+    }
+    String& operator +=(const char *aString) {
+        Content += aString;
+        return *this;
+    }
+    const char* c_str() const {
+        return Content.c_str();
+    }
+private:
+    std::string Content;
+};
+
+#endif // _IR_HOST_ARDUINO_H
@@ -0,0 +1,261 @@
+/*
+ * IRChannelSimulator.hpp
+ *
+ * Host model of the path between the IR LED of the sender and the output of the receiver module.
+ * It converts the durations generated by IrSender.encode() into the durations, which a real receiver would capture.
+ * The impairments are applied in the order, in which they occur in reality:
+ * 1. Sender clock deviation: all durations are scaled by 1 + ClockDeviationPercent / 100.
+ * 2. Ambient light noise: short noise marks are inserted into the spaces and into the gap before the frame,
+ *    e.g. by fluorescent lamps or sunlight. The bursts occur at random times with the average rate NoiseBurstsPerSecond.
+ *    The receiver ends a frame at a space longer than RecordGapMicros. So bursts in the gap, which are followed by such a space,
+ *    are captured as separate noise frames and shorten the gap before the next frame, and bursts shortly before the frame
+ *    become the start of the frame. The first RecordGapMicros of the gap are kept free of noise,
+ *    since a burst there would belong to the already captured previous frame.
+ * 3. Weak signal: with the probability DropMarkPercent a mark is not detected and merges with the surrounding spaces,
+ *    and with the probability MergeSpacePercent a space is not detected and merges with the surrounding marks.
+ * 4. Receiver AGC: all marks are extended by MarkExcessMicros and the following space is shortened by the same value.
+ *    The AGC gain recovers during spaces, so a mark after a space of at least AGCRecoveryMicros is extended by additional
+ *    AGCStretchMicros. After shorter spaces, the additional stretch is proportional to the length of the space.
+ * 5. Edge jitter: each edge is moved by a random value between -JitterMicros and +JitterMicros.
+ *
+ * All random values are generated by the simulator's own generator, so a channel is reproducible by its seed,
+ * independent of the generation of the sent values.
+ * The first and the last mark of a frame are never dropped, to keep the frame boundaries.
+ *
+ *  This file is part of Arduino-IRremote https://github.com/Arduino-IRremote/Arduino-IRremote.
+ *
+ *************************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2026 Armin Joachimsmeyer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ ************************************************************************************
+ */
+#ifndef _IR_CHANNEL_SIMULATOR_HPP
+#define _IR_CHANNEL_SIMULATOR_HPP
+
+#include <random>
+#include <vector>
+
+#define NOISE_BURST_MINIMUM_SPACE_MICROS    50 // Minimum space before and after an inserted noise mark
+
+struct IRChannelParameters {
+    int8_t ClockDeviationPercent = 0;
+    float NoiseBurstsPerSecond = 0;
+    uint16_t NoiseBurstMicros = 200;    // Maximum length of a noise mark, minimum is half of it
+    float DropMarkPercent = 0;
+    float MergeSpacePercent = 0;
+    int16_t MarkExcessMicros = 0;
+    uint16_t AGCStretchMicros = 0;
+    uint32_t AGCRecoveryMicros = 10000;
+    uint16_t JitterMicros = 0;
+    uint32_t RecordGapMicros = 8000;    // A space longer than this ends a frame in the receiver, like RECORD_GAP_MICROS
+};
+
+/*
+ * One frame as captured by the receiver
+ */
+struct IRCapturedFrame {
+    uint32_t GapMicros;                     // The space before the frame
+    std::vector<uint16_t> DurationsMicros;  // Can be passed directly to IrReceiver.replayRawFrame()
+    bool IsNoise;                           // Contains only noise bursts of the gap, and not the sent frame
+};
+
+class IRChannelSimulator {
+public:
+    IRChannelParameters Parameters;
+    uint32_t NumberOfNoiseBursts = 0;
+    uint32_t NumberOfDroppedMarks = 0;
+    uint32_t NumberOfMergedSpaces = 0;
+
+    explicit IRChannelSimulator(uint32_t aSeed = 1) :
+            Random(aSeed) {
+    }
+
+    void seed(uint32_t aSeed) {
+        Random.seed(aSeed);
+    }
+
+    /**
+     * Converts the sent durations of one frame and the gap before it into the frames, which the receiver captures.
+     * Without noise in the gap, this is only the sent frame.
+     * @param aDurationsMicros      Alternating marks and spaces starting with a mark
+     * @param aGapMicros            The space before the frame
+     * @param aCapturedFrames       Result. The noise frames captured in the gap and as last entry the sent frame.
+     */
+    void transmit(const std::vector<uint32_t> &aDurationsMicros, uint32_t aGapMicros, std::vector<IRCapturedFrame> &aCapturedFrames) {
+        std::vector<int32_t> tGapDurations;
+        tGapDurations.push_back(((int64_t) aGapMicros * (100 + Parameters.ClockDeviationPercent)) / 100);
+        if (Parameters.NoiseBurstsPerSecond > 0) {
+            addNoiseBursts(tGapDurations, true);
+        }
+
+        // Split the gap at each space longer than the record gap, like the receiver does
+        aCapturedFrames.clear();
+        IRCapturedFrame tFrame;
+        tFrame.GapMicros = tGapDurations[0];
+        tFrame.IsNoise = true;
+        for (size_t i = 1; i + 1 < tGapDurations.size(); i += 2) {
+            tFrame.DurationsMicros.push_back(clipDuration(tGapDurations[i] + Parameters.MarkExcessMicros));
+            if ((uint32_t) tGapDurations[i + 1] > Parameters.RecordGapMicros) {
+                aCapturedFrames.push_back(tFrame);
+                tFrame.GapMicros = tGapDurations[i + 1];
+                tFrame.DurationsMicros.clear();
+            } else {
+                tFrame.DurationsMicros.push_back(clipDuration(tGapDurations[i + 1] - Parameters.MarkExcessMicros));
+            }
+        }
+
+        std::vector<uint16_t> tDurations;
+        transmit(aDurationsMicros, tGapDurations.back(), tDurations);
+        tFrame.DurationsMicros.insert(tFrame.DurationsMicros.end(), tDurations.begin(), tDurations.end());
+        tFrame.IsNoise = false;
+        aCapturedFrames.push_back(tFrame);
+    }
+
+    /**
+     * Converts the sent durations of one frame into the captured durations, without noise in the gap before the frame
+     * @param aDurationsMicros      Alternating marks and spaces starting with a mark
+     * @param aGapMicros            The space before the frame. Required for the AGC stretch of the first mark.
+     * @param aCapturedDurations    Result, clipped to 1 to 65535 us. Can be passed directly to IrReceiver.replayRawFrame().
+     */
+    void transmit(const std::vector<uint32_t> &aDurationsMicros, uint32_t aGapMicros, std::vector<uint16_t> &aCapturedDurations) {
+        std::vector<int32_t> tDurations;
+        for (uint32_t tDuration : aDurationsMicros) {
+            tDurations.push_back(((int64_t) tDuration * (100 + Parameters.ClockDeviationPercent)) / 100);
+        }
+        if (Parameters.NoiseBurstsPerSecond > 0) {
+            addNoiseBursts(tDurations, false);
+        }
+        if (Parameters.DropMarkPercent > 0) {
+            mergeAround(tDurations, 2, Parameters.DropMarkPercent, &NumberOfDroppedMarks);
+        }
+        if (Parameters.MergeSpacePercent > 0) {
+            mergeAround(tDurations, 1, Parameters.MergeSpacePercent, &NumberOfMergedSpaces);
+        }
+        applyAGC(tDurations, aGapMicros);
+
+        std::uniform_int_distribution<int> tJitter(-Parameters.JitterMicros, Parameters.JitterMicros);
+        aCapturedDurations.clear();
+        int tLastEdgeShift = 0;
+        for (int32_t tDuration : tDurations) {
+            int tEdgeShift = (Parameters.JitterMicros > 0) ? tJitter(Random) : 0;
+            tDuration += tEdgeShift - tLastEdgeShift;
+            tLastEdgeShift = tEdgeShift;
+            aCapturedDurations.push_back(clipDuration(tDuration));
+        }
+    }
+
+private:
+    std::mt19937 Random;
+
+    static uint16_t clipDuration(int32_t aDuration) {
+        if (aDuration < 1) {
+            return 1;
+        } else if (aDuration > UINT16_MAX) {
+            return UINT16_MAX;
+        }
+        return aDuration;
+    }
+
+    /*
+     * The arrival times of the bursts are exponentially distributed, i.e. a burst can occur in each space with the same rate.
+     * A burst is only inserted, if it fits into the space with NOISE_BURST_MINIMUM_SPACE_MICROS on both sides.
+     * @param aIsGap    If true, aDurations contains only the gap before a frame, i.e. it starts with a space.
+     *                  Then a burst is only inserted after the first RecordGapMicros of the gap.
+     */
+    void addNoiseBursts(std::vector<int32_t> &aDurations, bool aIsGap) {
+        std::exponential_distribution<double> tArrival(Parameters.NoiseBurstsPerSecond / 1000000.0);
+        std::uniform_int_distribution<int> tBurstLengthDistribution(Parameters.NoiseBurstMicros / 2, Parameters.NoiseBurstMicros);
+        std::vector<int32_t> tResult;
+        double tNextBurstMicros = tArrival(Random);
+        int32_t tMinimumBurstStart = aIsGap ? Parameters.RecordGapMicros : NOISE_BURST_MINIMUM_SPACE_MICROS;
+        for (size_t i = 0; i < aDurations.size(); i++) {
+            int32_t tDuration = aDurations[i];
+            if ((i & 1) == aIsGap) {
+                tResult.push_back(tDuration); // mark
+                tNextBurstMicros -= tDuration;
+                continue;
+            }
+            // Split the space at each burst, which starts within it
+            while (tNextBurstMicros < tDuration) {
+                int32_t tBurstStart = tNextBurstMicros;
+                int32_t tBurstLength = tBurstLengthDistribution(Random);
+                if (tBurstStart >= tMinimumBurstStart
+                        && tBurstStart + tBurstLength + NOISE_BURST_MINIMUM_SPACE_MICROS <= tDuration) {
+                    tMinimumBurstStart = NOISE_BURST_MINIMUM_SPACE_MICROS;
+                    tResult.push_back(tBurstStart);
+                    tResult.push_back(tBurstLength);
+                    tDuration -= tBurstStart + tBurstLength;
+                    tNextBurstMicros -= tBurstStart + tBurstLength;
+                    NumberOfNoiseBursts++;
+                }
+                tNextBurstMicros += tArrival(Random);
+            }
+            tResult.push_back(tDuration);
+            tNextBurstMicros -= tDuration;
+        }
+        aDurations.swap(tResult);
+    }
+
+    /*
+     * Removes a mark (aFirstIndex = 2) or a space (aFirstIndex = 1) with the probability aPercent
+     * by merging it with its predecessor and successor. The first and the last mark are kept.
+     */
+    void mergeAround(std::vector<int32_t> &aDurations, size_t aFirstIndex, float aPercent, uint32_t *aCounter) {
+        if (aDurations.size() < 3) {
+            return;
+        }
+        std::uniform_real_distribution<float> tProbability(0, 100);
+        std::vector<int32_t> tResult;
+        size_t tLastMarkIndex = (aDurations.size() - 1) & ~1;
+        for (size_t i = 0; i < aDurations.size(); i++) {
+            if (i >= aFirstIndex && ((i - aFirstIndex) & 1) == 0 && i < tLastMarkIndex && tProbability(Random) < aPercent) {
+                tResult.back() += aDurations[i] + aDurations[i + 1];
+                i++; // successor is merged too
+                (*aCounter)++;
+            } else {
+                tResult.push_back(aDurations[i]);
+            }
+        }
+        aDurations.swap(tResult);
+    }
+
+    void applyAGC(std::vector<int32_t> &aDurations, uint32_t aGapMicros) {
+        uint32_t tSpaceBefore = aGapMicros;
+        for (size_t i = 0; i < aDurations.size(); i += 2) {
+            int32_t tStretch = Parameters.MarkExcessMicros;
+            if (Parameters.AGCStretchMicros > 0) {
+                if (tSpaceBefore >= Parameters.AGCRecoveryMicros) {
+                    tStretch += Parameters.AGCStretchMicros;
+                } else {
+                    tStretch += ((uint64_t) Parameters.AGCStretchMicros * tSpaceBefore) / Parameters.AGCRecoveryMicros;
+                }
+            }
+            aDurations[i] += tStretch;
+            if (i + 1 < aDurations.size()) {
+                tSpaceBefore = aDurations[i + 1]; // Gain recovery depends on the sent space
+                aDurations[i + 1] -= tStretch;
+            }
+        }
+    }
+};
+
+#endif // _IR_CHANNEL_SIMULATOR_HPP
@@ -0,0 +1,481 @@
+/*
+ * IRDecodeFuzzer.cpp
+ *
+ * Host fuzz target for all decoders. Feeds random and mutated rawbuf / rawlen combinations through IrReceiver.decode()
+ * and reports two kinds of findings:
+ * - Out of bounds read: decode() accesses rawbuf[0] or entries at or behind rawlen.
+ *   Each frame is decoded twice with different content of these entries and a different result is reported.
+ *   If compiled with -fsanitize=address, these entries are additionally poisoned, so the first such read aborts with a stack trace.
+ *   Reads outside of irparams are always detected by the address sanitizer.
+ * - Budget exceeded: the decode time of a frame is above the budget given with -b.
+ *   Pathological noise frames would block the loop() of the application for this time.
+ *   The budget is in host nanoseconds, scale it by the speed ratio of host and target, e.g. around 200 for a 16 MHz AVR.
+ * Each finding is printed as printIRResultAsCArray() output, which can be decoded again by IRReplayTool.
+ *
+ * The default configuration is RAW_BUFFER_LENGTH 200 with the 8 bit timing buffer like on an ATmega328,
+ * since the 8 bit indexes of this configuration are the most sensitive. All decoders including B&O are enabled.
+ *
+ * Build and run from the root of the library:
+ *   g++ -O1 -g -std=gnu++11 -fsanitize=address,undefined -I extras/host -I src extras/host/IRDecodeFuzzer.cpp -o irfuzz
+ *   ./irfuzz [-n <iterations>] [-d <seconds>] [-s <seed>] [-b <budget nanoseconds>]
+ * Use e.g. -DRAW_BUFFER_LENGTH=750 -DUSE_16_BIT_TIMING_BUFFER for the configuration of 32 bit CPUs.
+ * Add -DSUPPORT_DECODER_PROFILING to print the call and hit counts and the durations of each decoder at the end.
+ *
+ * For coverage guided fuzzing with libFuzzer, the first input bytes are the initial gap and the rest are the timings:
+ *   clang++ -O1 -g -std=gnu++11 -fsanitize=fuzzer,address -DUSE_LIBFUZZER -I extras/host -I src extras/host/IRDecodeFuzzer.cpp -o irfuzz
+ *   ./irfuzz -max_len=400
+ *
+ *  This file is part of Arduino-IRremote https://github.com/Arduino-IRremote/Arduino-IRremote.
+ *
+ *************************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2026 Armin Joachimsmeyer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ ************************************************************************************
+ */
+#include <Arduino.h>
+
+#include <random>
+#include <vector>
+
+#if !defined(RAW_BUFFER_LENGTH)
+#define RAW_BUFFER_LENGTH  200
+#endif
+#if !defined(FUZZ_WITHOUT_BEO)
+#define DECODE_BEO                          // Not enabled by default, since it prevents decoding of Sony
+#define RECORD_GAP_MICROS 12750             // Required for ENABLE_BEO_WITHOUT_FRAME_GAP
+#endif
+#define IR_REMOTE_DISABLE_RECEIVE_COMPLETE_CALLBACK
+#define USE_SEND_RECORDING_BACKEND          // To generate the valid frames used for mutation
+#include <IRremote.hpp>
+
+#if defined(__SANITIZE_ADDRESS__)
+#define FUZZ_WITH_ADDRESS_SANITIZER
+#elif defined(__has_feature)
+#  if __has_feature(address_sanitizer)
+#define FUZZ_WITH_ADDRESS_SANITIZER
+#  endif
+#endif
+#if defined(FUZZ_WITH_ADDRESS_SANITIZER)
+#include <sanitizer/asan_interface.h>
+#endif
+
+HardwareSerial Serial;
+
+#if defined(USE_16_BIT_TIMING_BUFFER)
+#define MAXIMUM_TICKS   UINT16_MAX
+#else
+#define MAXIMUM_TICKS   UINT8_MAX
+#endif
+#define MAXIMUM_NUMBER_OF_PRINTED_FINDINGS  10
+
+struct FuzzFrame {
+    uint16_t InitialGapTicks;
+    bool WasOverflow;
+    std::vector<uint16_t> Ticks; // Ticks[0] goes to rawbuf[1]
+};
+
+static uint32_t sBudgetNanos = 20000;
+static uint32_t sNumberOfFrames = 0;
+static uint32_t sNumberOfOutOfBoundsReads = 0;
+static uint32_t sNumberOfBudgetExceeded = 0;
+static uint64_t sDecodeNanos = 0;
+static uint32_t sMaximumDecodeNanos = 0;
+static decode_type_t sProtocolOfMaximumDecodeNanos = UNKNOWN;
+static uint32_t sNoiseFramesDecoded[OTHER + 1]; // Pure noise frames, which were accepted by a decoder
+
+static uint8_t sSavedReceiver[sizeof(IRrecv)]; // The receiver state before decode(), to decode the same frame twice
+
+/*
+ * Writes aTailTicks to all rawbuf entries, which are not part of the frame
+ */
+static void fillUnusedRawbufEntries(uint16_t aTailTicks) {
+    IrReceiver.irparams.rawbuf[0] = aTailTicks;
+    for (unsigned int i = IrReceiver.irparams.rawlen; i < RAW_BUFFER_LENGTH; i++) {
+        IrReceiver.irparams.rawbuf[i] = aTailTicks;
+    }
+}
+
+static void poisonUnusedRawbufEntries(bool aDoPoison) {
+#if defined(FUZZ_WITH_ADDRESS_SANITIZER)
+    volatile IRRawbufType *tRawbuf = IrReceiver.irparams.rawbuf;
+    size_t tSize = (RAW_BUFFER_LENGTH - IrReceiver.irparams.rawlen) * sizeof(IRRawbufType);
+    if (aDoPoison) {
+        ASAN_POISON_MEMORY_REGION((void* )&tRawbuf[IrReceiver.irparams.rawlen], tSize);
+    } else {
+        ASAN_UNPOISON_MEMORY_REGION((void* )&tRawbuf[IrReceiver.irparams.rawlen], tSize);
+    }
+#else
+    (void) aDoPoison;
+#endif
+}
+
+static uint32_t timedDecode() {
+    poisonUnusedRawbufEntries(true);
+    auto tStart = std::chrono::steady_clock::now();
+    IrReceiver.decode();
+    uint32_t tNanos = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - tStart).count();
+    poisonUnusedRawbufEntries(false);
+    return tNanos;
+}
+
+/*
+ * Restores the receiver state saved before the first decode() and fills the unused entries with aTailTicks
+ */
+static void restoreReceiver(uint16_t aTailTicks) {
+    memcpy((void*) &IrReceiver, sSavedReceiver, sizeof(IRrecv));
+    fillUnusedRawbufEntries(aTailTicks);
+}
+
+static void printFinding(const char *aFinding, uint32_t aNanos) {
+    printf("%s, decode time=%lu ns, initialGapTicks=%u%s\n", aFinding, (unsigned long) aNanos,
+            (unsigned int) IrReceiver.irparams.initialGapTicks, IrReceiver.irparams.OverflowFlag ? ", overflow" : "");
+    IrReceiver.printIRResultShort(&Serial);
+    IrReceiver.printIRResultAsCArray(&Serial);
+    printf("\n\n");
+}
+
+/*
+ * Loads the frame into irparams, decodes it and checks for findings.
+ * @return true if a finding was detected
+ */
+static bool fuzzOneFrame(FuzzFrame *aFrame, bool aIsNoise) {
+    unsigned int tRawlen = aFrame->Ticks.size() + 1;
+    if (tRawlen > RAW_BUFFER_LENGTH) {
+        tRawlen = RAW_BUFFER_LENGTH;
+    }
+    IrReceiver.irparams.rawlen = tRawlen;
+    IrReceiver.irparams.initialGapTicks = aFrame->InitialGapTicks;
+    IrReceiver.irparams.OverflowFlag = aFrame->WasOverflow;
+    for (unsigned int i = 1; i < tRawlen; i++) {
+        uint16_t tTicks = aFrame->Ticks[i - 1];
+        IrReceiver.irparams.rawbuf[i] = (tTicks > MAXIMUM_TICKS) ? MAXIMUM_TICKS : tTicks;
+    }
+    IrReceiver.handleCapturedFrameEnd(); // sets StateForISR and copies rawlen and initialGapTicks to decodedIRData
+    memcpy(sSavedReceiver, (void*) &IrReceiver, sizeof(IRrecv));
+
+    /*
+     * Decode twice with different content of the unused entries. The values are typical for NEC and Sony.
+     */
+    fillUnusedRawbufEntries(11);
+    uint32_t tNanos = timedDecode();
+    IRData tFirstIRData;
+    memcpy(&tFirstIRData, &IrReceiver.decodedIRData, sizeof(IRData)); // including padding bytes, which are compared too
+
+    restoreReceiver(34);
+    uint32_t tSecondNanos = timedDecode();
+    if (tSecondNanos < tNanos) {
+        tNanos = tSecondNanos;
+    }
+
+    bool tFoundOutOfBoundsRead = memcmp(&tFirstIRData, &IrReceiver.decodedIRData, sizeof(IRData)) != 0;
+    bool tFoundBudgetExceeded = false;
+    if (tNanos > sBudgetNanos) {
+        // Measure again, to skip delays caused by the operating system
+        for (uint_fast8_t i = 0; i < 3 && tNanos > sBudgetNanos; i++) {
+            restoreReceiver(11);
+            uint32_t tRepeatedNanos = timedDecode();
+            if (tRepeatedNanos < tNanos) {
+                tNanos = tRepeatedNanos;
+            }
+        }
+        tFoundBudgetExceeded = tNanos > sBudgetNanos;
+    }
+
+    decode_type_t tProtocol = IrReceiver.decodedIRData.protocol;
+    if (tProtocol > OTHER) {
+        tProtocol = OTHER;
+    }
+    if (aIsNoise) {
+        sNoiseFramesDecoded[tProtocol]++;
+    }
+    sNumberOfFrames++;
+    sDecodeNanos += tNanos;
+    if (tNanos > sMaximumDecodeNanos) {
+        sMaximumDecodeNanos = tNanos;
+        sProtocolOfMaximumDecodeNanos = tProtocol;
+    }
+
+    if (tFoundOutOfBoundsRead) {
+        if (sNumberOfOutOfBoundsReads++ < MAXIMUM_NUMBER_OF_PRINTED_FINDINGS) {
+            printf("Out of bounds read, result depends on unused rawbuf entries. First result was %s\n",
+                    getProtocolString(tFirstIRData.protocol));
+            printFinding("Out of bounds read", tNanos);
+        }
+    }
+    if (tFoundBudgetExceeded) {
+        if (sNumberOfBudgetExceeded++ < MAXIMUM_NUMBER_OF_PRINTED_FINDINGS) {
+            printFinding("Budget exceeded", tNanos);
+        }
+    }
+    return tFoundOutOfBoundsRead || tFoundBudgetExceeded;
+}
+
+#if defined(USE_LIBFUZZER)
+/*
+ * Input bytes: initial gap low byte, initial gap high byte, flags (bit 0 is overflow), timings.
+ * For the 16 bit timing buffer, a timing byte of 0xFF is followed by 2 bytes of a 16 bit timing.
+ */
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *aData, size_t aSize) {
+    static FuzzFrame sFrame;
+    if (aSize < 3) {
+        return 0;
+    }
+    sFrame.InitialGapTicks = aData[0] | (aData[1] << 8);
+    sFrame.WasOverflow = aData[2] & 0x01;
+    sFrame.Ticks.clear();
+    for (size_t i = 3; i < aSize && sFrame.Ticks.size() < RAW_BUFFER_LENGTH - 1; i++) {
+        uint16_t tTicks = aData[i];
+#  if defined(USE_16_BIT_TIMING_BUFFER)
+        if (tTicks == 0xFF && i + 2 < aSize) {
+            tTicks = aData[i + 1] | (aData[i + 2] << 8);
+            i += 2;
+        }
+#  endif
+        sFrame.Ticks.push_back(tTicks);
+    }
+    if (fuzzOneFrame(&sFrame, false)) {
+        abort(); // lets libFuzzer store the input
+    }
+    return 0;
+}
+
+#else // defined(USE_LIBFUZZER)
+static std::mt19937 sRandom;
+static std::vector<std::vector<uint16_t>> sValidFrames;
+
+static uint32_t randomNumber(uint32_t aMaximum) {
+    return std::uniform_int_distribution<uint32_t>(0, aMaximum)(sRandom);
+}
+
+/*
+ * Mostly values near the multiples of the units of the protocols, some glitches and some arbitrary values
+ */
+static uint16_t randomTicks() {
+    static const uint8_t sTypicalTicks[] = { 5, 6, 8, 9, 11, 12, 16, 17, 18, 24, 30, 34, 36, 45, 62, 68, 90, 125, 180, 240 };
+    switch (randomNumber(7)) {
+    case 0:
+        return 1 + randomNumber(2);
+    case 1:
+        return randomNumber(MAXIMUM_TICKS);
+    case 2:
+        return MAXIMUM_TICKS;
+    default:
+        return sTypicalTicks[randomNumber(sizeof(sTypicalTicks) - 1)] + randomNumber(4) - 2;
+    }
+}
+
+static void addValidFrame(uint16_t *aDurations, uint16_t aNumberOfDurations) {
+    if (aNumberOfDurations > 0) {
+        IrReceiver.replayRawFrame(aDurations, aNumberOfDurations);
+        sValidFrames.push_back(
+                std::vector<uint16_t>(&IrReceiver.irparams.rawbuf[1], &IrReceiver.irparams.rawbuf[IrReceiver.irparams.rawlen]));
+    }
+}
+
+/*
+ * Record the frames of all send functions with the recording backend and convert them to ticks with replayRawFrame()
+ * The recording is split at the gaps between repeats, like the receiver does.
+ */
+static void addValidFrame() {
+    static uint16_t sDurations[SEND_RECORDING_BUFFER_LENGTH];
+    uint16_t tNumberOfDurations = 0;
+    for (uint16_t i = 0; i < IRSendRecordingBackend::NumberOfEntries; i++) {
+        IRSendRecordEntry *tEntry = &IRSendRecordingBackend::Entries[i];
+        if (tNumberOfDurations == 0 && !tEntry->isMark) {
+            continue; // A leading space, like the first half of the RC5 start bit, belongs to the gap
+        }
+        if (!tEntry->isMark && tEntry->DurationMicros >= RECORD_GAP_MICROS) {
+            addValidFrame(sDurations, tNumberOfDurations);
+            tNumberOfDurations = 0;
+            continue;
+        }
+        sDurations[tNumberOfDurations++] = tEntry->DurationMicros;
+    }
+    addValidFrame(sDurations, tNumberOfDurations);
+    IRSendRecordingBackend::reset();
+}
+
+static void generateValidFrames() {
+    static const uint8_t sCommands[] = { 0x00, 0x12, 0x5A, 0xFF };
+    IRSendRecordingBackend::reset();
+    for (uint_fast8_t i = 0; i < sizeof(sCommands); i++) {
+        uint8_t tCommand = sCommands[i];
+        IrSender.sendNEC(0x04, tCommand, 0);
+        addValidFrame();
+        IrSender.sendNECRepeat();
+        addValidFrame();
+        IrSender.sendOnkyo(0x0102, tCommand, 0);
+        addValidFrame();
+        IrSender.sendSamsung(0x0707, tCommand, 0);
+        addValidFrame();
+        IrSender.sendSamsung48(0x0707, tCommand, 0);
+        addValidFrame();
+        IrSender.sendLG(0x44, tCommand, 0);
+        addValidFrame();
+        IrSender.sendSony(0x11, tCommand, 0, 12);
+        addValidFrame();
+        IrSender.sendSony(0x11, tCommand, 0, 20);
+        addValidFrame();
+        IrSender.sendPanasonic(0x0B, tCommand, 0);
+        addValidFrame();
+        IrSender.sendKaseikyo_Denon(0x123, tCommand, 0);
+        addValidFrame();
+        IrSender.sendDenon(0x11, tCommand, 0);
+        addValidFrame();
+        IrSender.sendJVC(0x11, tCommand, 0);
+        addValidFrame();
+        IrSender.sendRC5(0x11, tCommand & 0x3F, 0);
+        addValidFrame();
+        IrSender.sendRC6(0x11, tCommand, 0);
+        addValidFrame();
+        IrSender.sendRC6A(0x11, tCommand, 0, 0x1234);
+        addValidFrame();
+        IrSender.sendBoseWave(tCommand, 0);
+        addValidFrame();
+        IrSender.sendFAST(tCommand, 0);
+        addValidFrame();
+        IrSender.sendLegoPowerFunctions(1, tCommand & 0x0F, 0, false);
+        addValidFrame();
+        IrSender.sendMagiQuest(0x12345678, tCommand);
+        addValidFrame();
+        IrSender.sendWhynter(0x12345678 + tCommand, 0);
+        addValidFrame();
+        IrSender.sendOpenLASIR(0x11, tCommand, 0);
+        addValidFrame();
+        IrSender.sendBangOlufsen(0x0102, tCommand, 0);
+        addValidFrame();
+        IrSender.sendPulseDistanceWidth(38, 3000, 1500, 500, 1500, 500, 500, 0x123456789ABC0000 + tCommand, 64, PROTOCOL_IS_LSB_FIRST, 0, 0);
+        addValidFrame();
+    }
+}
+
+/*
+ * Generates pure noise or one of the valid frames with a random mutation
+ * @return true if frame is pure noise
+ */
+static bool generateFrame(FuzzFrame *aFrame) {
+    aFrame->InitialGapTicks = randomNumber(3) ? RECORD_GAP_TICKS + 1 + randomNumber(4000) : randomNumber(3000);
+    aFrame->WasOverflow = randomNumber(50) == 0;
+    std::vector<uint16_t> &tTicks = aFrame->Ticks;
+    uint_fast8_t tMutation = randomNumber(6);
+    if (tMutation == 0) {
+        tTicks.resize(randomNumber(RAW_BUFFER_LENGTH - 1));
+        for (size_t i = 0; i < tTicks.size(); i++) {
+            tTicks[i] = randomTicks();
+        }
+        return true;
+    }
+
+    tTicks = sValidFrames[randomNumber(sValidFrames.size() - 1)];
+    size_t tSize = tTicks.size();
+    switch (tMutation) {
+    case 1: // jitter
+        for (size_t i = 0; i < tSize; i++) {
+            int tJitteredTicks = tTicks[i] + (int) randomNumber(4) - 2;
+            tTicks[i] = (tJitteredTicks < 1) ? 1 : tJitteredTicks;
+        }
+        break;
+    case 2: // replace some entries
+        for (uint_fast8_t i = randomNumber(4); i < 5; i++) {
+            tTicks[randomNumber(tSize - 1)] = randomTicks();
+        }
+        break;
+    case 3: // truncate, even to 0 entries
+        tTicks.resize(randomNumber(tSize));
+        break;
+    case 4: // split a mark or space by a glitch
+    {
+        size_t tIndex = randomNumber(tSize - 1);
+        uint16_t tFirstPart = randomNumber(tTicks[tIndex]);
+        tTicks.insert(tTicks.begin() + tIndex, 2, 1);
+        tTicks[tIndex] = tFirstPart;
+        tTicks[tIndex + 2] -= tFirstPart;
+        break;
+    }
+    default: // append noise
+        while (tTicks.size() < RAW_BUFFER_LENGTH - 1 && randomNumber(15)) {
+            tTicks.push_back(randomTicks());
+        }
+        break;
+    }
+    return false;
+}
+
+static void printStatistics(double aElapsedSeconds) {
+    printf("Frames=%lu, %.0f frames/s, average decode time=%.0f ns, maximum=%lu ns for %s\n", (unsigned long) sNumberOfFrames,
+            sNumberOfFrames / aElapsedSeconds, (double) sDecodeNanos / sNumberOfFrames, (unsigned long) sMaximumDecodeNanos,
+            getProtocolString(sProtocolOfMaximumDecodeNanos));
+    printf("Noise frames accepted by decoders:");
+    for (uint_fast8_t i = UNKNOWN + 1; i <= OTHER; i++) {
+        if (sNoiseFramesDecoded[i] > 0) {
+            printf(" %s=%lu", getProtocolString((decode_type_t) i), (unsigned long) sNoiseFramesDecoded[i]);
+        }
+    }
+    printf("\nOut of bounds reads=%lu, budget of %lu ns exceeded=%lu\n", (unsigned long) sNumberOfOutOfBoundsReads,
+            (unsigned long) sBudgetNanos, (unsigned long) sNumberOfBudgetExceeded);
+#if defined(SUPPORT_DECODER_PROFILING)
+    IrReceiver.printDecoderProfile(&Serial);
+#endif
+}
+
+int main(int argc, char *argv[]) {
+    uint32_t tNumberOfIterations = 1000000;
+    uint32_t tMaximumSeconds = 0;
+    uint32_t tSeed = 1;
+    for (int i = 1; i < argc; i++) {
+        if (i + 1 < argc && strcmp(argv[i], "-n") == 0) {
+            tNumberOfIterations = strtoul(argv[++i], nullptr, 0);
+        } else if (i + 1 < argc && strcmp(argv[i], "-d") == 0) {
+            tMaximumSeconds = strtoul(argv[++i], nullptr, 0);
+            tNumberOfIterations = UINT32_MAX;
+        } else if (i + 1 < argc && strcmp(argv[i], "-s") == 0) {
+            tSeed = strtoul(argv[++i], nullptr, 0);
+        } else if (i + 1 < argc && strcmp(argv[i], "-b") == 0) {
+            sBudgetNanos = strtoul(argv[++i], nullptr, 0);
+        } else {
+            fprintf(stderr, "Usage: %s [-n <iterations>] [-d <seconds>] [-s <seed>] [-b <budget nanoseconds>]\n", argv[0]);
+            return 2;
+        }
+    }
+    sRandom.seed(tSeed);
+    generateValidFrames();
+    printf("Fuzzing %u decoders with %u valid frames, seed=%lu, RAW_BUFFER_LENGTH=%u, %u bit timing buffer\n",
+            (unsigned int) OTHER, (unsigned int) sValidFrames.size(), (unsigned long) tSeed, RAW_BUFFER_LENGTH,
+            (unsigned int) (8 * sizeof(IRRawbufType)));
+
+    auto tStart = std::chrono::steady_clock::now();
+    double tElapsedSeconds = 0;
+    FuzzFrame tFrame;
+    for (uint32_t i = 0; i < tNumberOfIterations; i++) {
+        bool tIsNoise = generateFrame(&tFrame);
+        fuzzOneFrame(&tFrame, tIsNoise);
+        if ((i & 0x3FF) == 0 || i + 1 == tNumberOfIterations) {
+            tElapsedSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - tStart).count();
+            if (tMaximumSeconds > 0 && tElapsedSeconds >= tMaximumSeconds) {
+                break;
+            }
+        }
+    }
+    printStatistics(tElapsedSeconds);
+    return (sNumberOfOutOfBoundsReads == 0 && sNumberOfBudgetExceeded == 0) ? 0 : 1;
+}
+#endif // defined(USE_LIBFUZZER)
@@ -0,0 +1,543 @@
+/*
+ * IRReplayTool.cpp
+ *
+ * Host command line tool to validate the decoders against recorded frames.
+ * Reads capture files, loads each frame into irparams, calls IrReceiver.decode() and prints
+ * the number of frames per protocol, the UNKNOWN rate, the decode throughput, the decode time per protocol
+ * and the time spent in each decoder.
+ *
+ * Supported file formats, detected by the first byte of the file:
+ * - Binary records written by IrReceiver.writeIRResultAsBinaryRecord().
+ *   The decoded data contained in the record is compared with the result of decode() and differences are counted,
+ *   so the effect of a decoder change can be checked on a large set of field captures.
+ *   Invalid records are skipped by searching the next start byte.
+ * - Text output of IrReceiver.printIRResultAsCArray(), with durations in microseconds or in ticks.
+ *   All numbers between { and } are one frame, all other text is ignored. The compensation done by
+ *   printIRResultAsCArray() is reverted. A "Protocol=<name>" after the array is compared with the result of decode().
+ *
+ * Build on Linux, macOS or MinGW, from the root of the library:
+ *   g++ -O2 -std=gnu++11 -pthread -I extras/host -I src extras/host/IRReplayTool.cpp -o irreplay
+ * To check a subset of decoders, add e.g. -DDECODE_NEC -DDECODE_SONY -DDECODE_DISTANCE_WIDTH.
+ *
+ * Usage: irreplay [-v] [-j <threads>] <file>...
+ *   -v  Print every frame, which was decoded as UNKNOWN or which differs from the recorded result.
+ *   -j  Read all frames into memory and decode them with multiple threads.
+ *       Each thread has its own context with an IRrecv instance, whose decodedIRData and data for repeat detection
+ *       are written by decode(const IRFrameView&, IRData&), which decodes the frames in place.
+ *       The timing values of the library, like MICROS_PER_TICK, are global and shared, but only read while decoding.
+ *       The frames are split into contiguous blocks. Before its block, each thread decodes the preceding frames
+ *       back to the start of their repeat sequence, so repeat detection gives the same results as sequential decoding.
+ *
+ * The decode time per protocol is the time decode() required for frames resulting in this protocol.
+ * Since decode() calls the decoders one after another until one succeeds, it includes the time of all preceding decoders.
+ * Thus the time for UNKNOWN is the time for trying all decoders.
+ * The time per decoder is measured by the SUPPORT_DECODER_PROFILING code of decode() with a nanosecond clock.
+ * It is listed separately for calls returning a result (hit) and calls rejecting the frame (miss).
+ *
+ *  This file is part of Arduino-IRremote https://github.com/Arduino-IRremote/Arduino-IRremote.
+ *
+ *************************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2026 Armin Joachimsmeyer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ ************************************************************************************
+ */
+#include <Arduino.h>
+
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if !defined(RAW_BUFFER_LENGTH)
+#define RAW_BUFFER_LENGTH  750              // Accept the frames of all receivers
+#endif
+#define USE_16_BIT_TIMING_BUFFER            // Keep timings above 12750 us of text files
+#define IR_REMOTE_DISABLE_RECEIVE_COMPLETE_CALLBACK
+#define SUPPORT_DECODER_PROFILING
+#define DECODER_PROFILE_TIMESTAMP()   ((uint32_t) std::chrono::duration_cast<std::chrono::nanoseconds>( \
+        std::chrono::steady_clock::now().time_since_epoch()).count()) // Only differences are used, so wrap around is no problem
+#define DECODER_PROFILE_UNIT_STRING   "ns"
+#include <IRremote.hpp>
+
+HardwareSerial Serial;
+
+#define READ_BUFFER_SIZE        0x10000
+#define MAXIMUM_RECORD_LENGTH   (64 + (3 * RAW_BUFFER_LENGTH)) // header + 3 bytes per timing, which is enough for 16 bit timings
+
+static bool sVerbose = false;
+static unsigned int sNumberOfThreads = 1;
+static std::mutex sPrintMutex;
+
+struct ProtocolStatistics {
+    uint32_t NumberOfFrames;
+    uint64_t DecodeNanos;
+};
+/*
+ * 64 bit sums of the decoderProfile[] entries, which are collected after each frame
+ */
+struct DecoderStatistics {
+    uint64_t NumberOfCalls;
+    uint64_t NumberOfHits;
+    uint64_t SumOfHitNanos;
+    uint64_t SumOfMissNanos;
+    uint32_t MaximumNanos;
+    decode_type_t Protocol;
+};
+/*
+ * One instance for the sequential replay and one per thread for parallel decoding
+ */
+struct ReplayStatistics {
+    ProtocolStatistics Protocols[OTHER + 1];
+    DecoderStatistics Decoders[NUMBER_OF_PROFILED_DECODERS];
+    uint32_t NumberOfFrames;
+    uint32_t NumberOfDifferences;
+    uint64_t DecodeNanos;
+};
+static ReplayStatistics sStatistics;
+static uint32_t sNumberOfSkippedBytes = 0;
+
+/*
+ * Frames are only stored for parallel decoding
+ */
+struct StoredFrame {
+    std::vector<IRRawbufType> Rawbuf; // Same layout as irparams.rawbuf
+    uint16_t InitialGapTicks;
+#if defined(LONG_INTERVALS_BUFFER_LENGTH)
+    std::vector<IRLongInterval> LongIntervals; // Exact values of the rawbuf entries clipped to UINT8_MAX
+#endif
+    bool WasOverflow;
+    bool HasRecordedIRData;
+    bool CompareAllValues;
+    IRData RecordedIRData;
+};
+static std::vector<StoredFrame> sStoredFrames;
+
+/*
+ * Adds the decoder profile of the last decode to the statistics and resets it, so the 32 bit sums of the profile cannot overflow
+ */
+static void collectDecoderProfile(IRrecv &aDecoder, ReplayStatistics &aStatistics) {
+    for (uint_fast8_t i = 0; i < NUMBER_OF_PROFILED_DECODERS; i++) {
+        DecoderProfileStruct *tProfilePtr = &aDecoder.decoderProfile[i];
+        if (tProfilePtr->NumberOfCalls == 0) {
+            continue;
+        }
+        DecoderStatistics *tStatistics = &aStatistics.Decoders[i];
+        tStatistics->Protocol = tProfilePtr->Protocol;
+        tStatistics->NumberOfCalls += tProfilePtr->NumberOfCalls;
+        tStatistics->NumberOfHits += tProfilePtr->NumberOfHits;
+        tStatistics->SumOfHitNanos += tProfilePtr->SumOfHitDurations;
+        tStatistics->SumOfMissNanos += tProfilePtr->SumOfMissDurations;
+        if (tStatistics->MaximumNanos < tProfilePtr->MaximumDuration) {
+            tStatistics->MaximumNanos = tProfilePtr->MaximumDuration;
+        }
+    }
+    aDecoder.resetDecoderProfile();
+}
+
+/*
+ * Updates the statistics with the result of one decode and prints the frame in verbose mode.
+ * aDecoder must contain the frame in irparams, if verbose output is enabled.
+ * @param aFrameNumber      1 based number of the frame in the order of the input files.
+ * @param aRecordedIRData   Data recorded together with the frame or nullptr if not available.
+ * @param aCompareAllValues If false, only the protocol of aRecordedIRData is compared.
+ */
+static void countDecodedFrame(IRrecv &aDecoder, ReplayStatistics &aStatistics, uint32_t aFrameNumber, uint64_t aDecodeNanos,
+        IRData *aRecordedIRData, bool aCompareAllValues) {
+    decode_type_t tProtocol = aDecoder.decodedIRData.protocol;
+    if (tProtocol > OTHER) {
+        tProtocol = OTHER;
+    }
+    aStatistics.Protocols[tProtocol].NumberOfFrames++;
+    aStatistics.Protocols[tProtocol].DecodeNanos += aDecodeNanos;
+    aStatistics.DecodeNanos += aDecodeNanos;
+    aStatistics.NumberOfFrames++;
+    collectDecoderProfile(aDecoder, aStatistics);
+
+    bool tIsDifferent = false;
+    if (aRecordedIRData != nullptr) {
+        IRData *tDecodedIRData = &aDecoder.decodedIRData;
+        tIsDifferent = aRecordedIRData->protocol != tDecodedIRData->protocol;
+        if (aCompareAllValues) {
+            tIsDifferent = tIsDifferent || aRecordedIRData->address != tDecodedIRData->address
+                    || aRecordedIRData->command != tDecodedIRData->command
+                    || aRecordedIRData->numberOfBits != tDecodedIRData->numberOfBits
+                    || aRecordedIRData->decodedRawData != tDecodedIRData->decodedRawData;
+        }
+        if (tIsDifferent) {
+            aStatistics.NumberOfDifferences++;
+        }
+    }
+    if (sVerbose && (tIsDifferent || tProtocol == UNKNOWN)) {
+        std::lock_guard<std::mutex> tLock(sPrintMutex);
+        printf("Frame %lu: ", (unsigned long) aFrameNumber);
+        if (tIsDifferent) {
+            printf("recorded %s, decoded ", getProtocolString(aRecordedIRData->protocol));
+        }
+        aDecoder.printIRResultShort(&Serial);
+        aDecoder.printIRResultRawFormatted(&Serial);
+    }
+}
+
+/*
+ * Decodes the frame, which is loaded to irparams of IrReceiver, and updates the statistics.
+ * For parallel decoding, the frame is only stored.
+ */
+static void decodeAndCount(IRData *aRecordedIRData, bool aCompareAllValues) {
+    if (sNumberOfThreads > 1) {
+        StoredFrame tFrame;
+        tFrame.Rawbuf.assign(IrReceiver.irparams.rawbuf, IrReceiver.irparams.rawbuf + IrReceiver.irparams.rawlen);
+        tFrame.InitialGapTicks = IrReceiver.irparams.initialGapTicks;
+#if defined(LONG_INTERVALS_BUFFER_LENGTH)
+        tFrame.LongIntervals.assign(IrReceiver.irparams.LongIntervals,
+                IrReceiver.irparams.LongIntervals + IrReceiver.irparams.NumberOfLongIntervals);
+#endif
+        tFrame.WasOverflow = IrReceiver.irparams.OverflowFlag;
+        tFrame.HasRecordedIRData = (aRecordedIRData != nullptr);
+        tFrame.CompareAllValues = aCompareAllValues;
+        if (aRecordedIRData != nullptr) {
+            tFrame.RecordedIRData = *aRecordedIRData;
+        }
+        sStoredFrames.push_back(tFrame);
+        IrReceiver.resume();
+        return;
+    }
+
+    auto tStart = std::chrono::steady_clock::now();
+    IrReceiver.decode();
+    uint64_t tNanos = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - tStart).count();
+    IrReceiver.resume();
+    countDecodedFrame(IrReceiver, sStatistics, sStatistics.NumberOfFrames + 1, tNanos, aRecordedIRData, aCompareAllValues);
+}
+
+/*
+ * Everything written by one decoding thread.
+ * The decoder instance is private to the thread, since decode() writes its decodedIRData, its data for repeat detection
+ * and its decoder profile. The timing and calibration values of the library, e.g. MICROS_PER_TICK for USE_RUNTIME_MICROS_PER_TICK,
+ * are global and shared by all threads. They are only read while decoding and must not be changed while the threads are running.
+ */
+struct DecoderThreadContext {
+    IRrecv Decoder;
+    IRData DecodedIRData;
+    ReplayStatistics Statistics;
+    size_t FirstFrameIndex; // The block of frames counted by this thread
+    size_t EndFrameIndex;
+};
+
+/*
+ * Decodes one stored frame in place with the decoder of the thread
+ * @return The decode time in nanoseconds
+ */
+static uint64_t decodeStoredFrame(DecoderThreadContext *aContext, StoredFrame &aFrame) {
+    if (aFrame.WasOverflow) {
+        // Like decode() for an overflowed frame
+        aContext->Decoder.decodedIRData.protocol = UNKNOWN;
+        aContext->Decoder.decodedIRData.flags = IRDATA_FLAGS_WAS_OVERFLOW;
+        return 0;
+    }
+    IRFrameView tFrameView;
+    tFrameView.RawbufPtr = &aFrame.Rawbuf[0];
+    tFrameView.Rawlen = aFrame.Rawbuf.size();
+    tFrameView.MicrosPerTick = MICROS_PER_TICK;
+    tFrameView.InitialGapTicks = aFrame.InitialGapTicks;
+#if defined(LONG_INTERVALS_BUFFER_LENGTH)
+    tFrameView.LongIntervalsPtr = aFrame.LongIntervals.data();
+    tFrameView.NumberOfLongIntervals = aFrame.LongIntervals.size();
+#endif
+    auto tStart = std::chrono::steady_clock::now();
+    aContext->Decoder.decode(tFrameView, aContext->DecodedIRData);
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - tStart).count();
+}
+
+/*
+ * Sets the data for repeat detection of the decoder to the values, which sequential decoding has before the first frame of the block.
+ * A repeat frame can only be decoded after the frame it repeats, so the frames before the block are searched backwards
+ * for the start of the repeat sequence, which is the first frame not decoded as repeat.
+ * Then the frames from this start up to the block are decoded without counting them.
+ */
+static void primeRepeatDetection(DecoderThreadContext *aContext) {
+    IRData *tDecodedIRData = &aContext->Decoder.decodedIRData;
+    size_t tStartIndex = aContext->FirstFrameIndex;
+    while (tStartIndex > 0) {
+        tStartIndex--;
+        decodeStoredFrame(aContext, sStoredFrames[tStartIndex]);
+        if (tDecodedIRData->protocol != UNKNOWN && !(tDecodedIRData->flags & (IRDATA_FLAGS_IS_REPEAT | IRDATA_FLAGS_IS_AUTO_REPEAT))) {
+            break;
+        }
+    }
+    for (size_t i = tStartIndex; i < aContext->FirstFrameIndex; i++) {
+        decodeStoredFrame(aContext, sStoredFrames[i]);
+    }
+    aContext->Decoder.resetDecoderProfile();
+}
+
+/*
+ * Thread function. Decodes a contiguous block of stored frames with the decoder of its context.
+ */
+static void decodeStoredFrames(DecoderThreadContext *aContext) {
+    IRrecv *tDecoder = &aContext->Decoder;
+    primeRepeatDetection(aContext);
+    for (size_t i = aContext->FirstFrameIndex; i < aContext->EndFrameIndex; i++) {
+        StoredFrame &tFrame = sStoredFrames[i];
+        uint64_t tNanos = decodeStoredFrame(aContext, tFrame);
+        if (sVerbose) {
+            // Printing of raw data reads irparams
+            memcpy(tDecoder->irparams.rawbuf, &tFrame.Rawbuf[0], tFrame.Rawbuf.size() * sizeof(IRRawbufType));
+            tDecoder->irparams.rawlen = tFrame.Rawbuf.size();
+            tDecoder->irparams.initialGapTicks = tFrame.InitialGapTicks;
+            tDecoder->decodedIRData.rawlen = tFrame.Rawbuf.size();
+            tDecoder->decodedIRData.initialGapTicks = tFrame.InitialGapTicks;
+#if defined(LONG_INTERVALS_BUFFER_LENGTH)
+            memcpy(tDecoder->irparams.LongIntervals, tFrame.LongIntervals.data(), tFrame.LongIntervals.size() * sizeof(IRLongInterval));
+            tDecoder->irparams.NumberOfLongIntervals = tFrame.LongIntervals.size();
+#endif
+        }
+        countDecodedFrame(*tDecoder, aContext->Statistics, i + 1, tNanos, tFrame.HasRecordedIRData ? &tFrame.RecordedIRData : nullptr,
+                tFrame.CompareAllValues);
+    }
+}
+
+static void decodeStoredFramesInParallel() {
+    std::vector<DecoderThreadContext> tContexts(sNumberOfThreads);
+    std::vector<std::thread> tThreads;
+    size_t tFramesPerThread = (sStoredFrames.size() + sNumberOfThreads - 1) / sNumberOfThreads;
+    for (unsigned int i = 0; i < sNumberOfThreads; i++) {
+        DecoderThreadContext *tContext = &tContexts[i];
+        memset(&tContext->Statistics, 0, sizeof(ReplayStatistics));
+        tContext->FirstFrameIndex = std::min(i * tFramesPerThread, sStoredFrames.size());
+        tContext->EndFrameIndex = std::min(tContext->FirstFrameIndex + tFramesPerThread, sStoredFrames.size());
+        tThreads.push_back(std::thread(decodeStoredFrames, tContext));
+    }
+
+    for (unsigned int i = 0; i < sNumberOfThreads; i++) {
+        tThreads[i].join();
+        ReplayStatistics *tStatistics = &tContexts[i].Statistics;
+        for (uint_fast8_t j = UNKNOWN; j <= OTHER; j++) {
+            sStatistics.Protocols[j].NumberOfFrames += tStatistics->Protocols[j].NumberOfFrames;
+            sStatistics.Protocols[j].DecodeNanos += tStatistics->Protocols[j].DecodeNanos;
+        }
+        for (uint_fast8_t j = 0; j < NUMBER_OF_PROFILED_DECODERS; j++) {
+            DecoderStatistics *tDecoder = &sStatistics.Decoders[j];
+            if (tStatistics->Decoders[j].NumberOfCalls > 0) {
+                tDecoder->Protocol = tStatistics->Decoders[j].Protocol;
+            }
+            tDecoder->NumberOfCalls += tStatistics->Decoders[j].NumberOfCalls;
+            tDecoder->NumberOfHits += tStatistics->Decoders[j].NumberOfHits;
+            tDecoder->SumOfHitNanos += tStatistics->Decoders[j].SumOfHitNanos;
+            tDecoder->SumOfMissNanos += tStatistics->Decoders[j].SumOfMissNanos;
+            if (tDecoder->MaximumNanos < tStatistics->Decoders[j].MaximumNanos) {
+                tDecoder->MaximumNanos = tStatistics->Decoders[j].MaximumNanos;
+            }
+        }
+        sStatistics.NumberOfFrames += tStatistics->NumberOfFrames;
+        sStatistics.NumberOfDifferences += tStatistics->NumberOfDifferences;
+        sStatistics.DecodeNanos += tStatistics->DecodeNanos;
+    }
+}
+
+/*
+ * Reads binary records with a fixed size buffer, so the file size is not limited by RAM
+ */
+static void replayBinaryFile(FILE *aFile) {
+    std::vector<uint8_t> tBuffer(READ_BUFFER_SIZE);
+    size_t tStart = 0;
+    size_t tEnd = 0;
+    bool tIsEndOfFile = false;
+    IRData tRecordedIRData;
+
+    while (true) {
+        if (!tIsEndOfFile && tEnd - tStart < MAXIMUM_RECORD_LENGTH) {
+            // move remaining bytes to front and refill buffer
+            memmove(&tBuffer[0], &tBuffer[tStart], tEnd - tStart);
+            tEnd -= tStart;
+            tStart = 0;
+            size_t tBytesRead = fread(&tBuffer[tEnd], 1, tBuffer.size() - tEnd, aFile);
+            tEnd += tBytesRead;
+            tIsEndOfFile = (tBytesRead == 0);
+        }
+        if (tStart >= tEnd) {
+            break;
+        }
+
+        size_t tRecordLength = IrReceiver.readBinaryRecord(&tBuffer[tStart], tEnd - tStart, &tRecordedIRData);
+        if (tRecordLength == 0) {
+            // Invalid or truncated record, resynchronize at next start byte
+            sNumberOfSkippedBytes++;
+            tStart++;
+        } else {
+            decodeAndCount(&tRecordedIRData, true);
+            tStart += tRecordLength;
+        }
+    }
+}
+
+/*
+ * Parses all arrays of printIRResultAsCArray() output. An array may span multiple lines.
+ */
+static void replayTextFile(std::ifstream &aFile) {
+    std::vector<uint16_t> tDurations;
+    std::string tLine;
+    bool tIsInsideArray = false;
+    bool tIsTicks = false;
+
+    while (std::getline(aFile, tLine)) {
+        const char *tPtr = tLine.c_str();
+        while (*tPtr != '\0') {
+            if (!tIsInsideArray) {
+                const char *tArrayStart = strchr(tPtr, '{');
+                if (tArrayStart == nullptr) {
+                    break;
+                }
+                tIsTicks = strstr(tLine.c_str(), "rawTicks") != nullptr;
+                tDurations.clear();
+                tIsInsideArray = true;
+                tPtr = tArrayStart + 1;
+            } else if (*tPtr == '}') {
+                tIsInsideArray = false;
+                tPtr++;
+                if (tDurations.empty()) {
+                    continue; // e.g. an empty array or an array of text, which is no frame
+                }
+
+                // Revert the compensation of printIRResultAsCArray()
+                for (size_t i = 0; i < tDurations.size(); i++) {
+                    if (tIsTicks) {
+                        uint32_t tMicros = (uint32_t) tDurations[i] * MICROS_PER_TICK;
+                        tDurations[i] = (tMicros > UINT16_MAX) ? UINT16_MAX : tMicros;
+                    }
+                    if (i & 1) {
+                        tDurations[i] = (tDurations[i] > MARK_EXCESS_MICROS) ? tDurations[i] - MARK_EXCESS_MICROS : 0;
+                    } else {
+                        tDurations[i] += MARK_EXCESS_MICROS;
+                    }
+                }
+                IrReceiver.replayRawFrame(&tDurations[0], tDurations.size());
+
+                // Use the protocol of the printIRResultShort() comment for comparison
+                IRData tRecordedIRData;
+                const char *tProtocolString = strstr(tPtr, "Protocol=");
+                if (tProtocolString != nullptr) {
+                    tProtocolString += strlen("Protocol=");
+                    size_t tLength = strcspn(tProtocolString, " \r");
+                    tRecordedIRData.protocol = UNKNOWN;
+                    for (uint_fast8_t i = UNKNOWN; i <= OTHER; i++) {
+                        const char *tName = getProtocolString((decode_type_t) i);
+                        if (strlen(tName) == tLength && strncmp(tName, tProtocolString, tLength) == 0) {
+                            tRecordedIRData.protocol = (decode_type_t) i;
+                        }
+                    }
+                    decodeAndCount(&tRecordedIRData, false);
+                } else {
+                    decodeAndCount(nullptr, false);
+                }
+            } else if (*tPtr >= '0' && *tPtr <= '9') {
+                char *tNumberEnd;
+                unsigned long tValue = strtoul(tPtr, &tNumberEnd, 10);
+                if (tDurations.size() < RAW_BUFFER_LENGTH) {
+                    tDurations.push_back(tValue > UINT16_MAX ? UINT16_MAX : tValue);
+                }
+                tPtr = tNumberEnd;
+            } else {
+                tPtr++;
+            }
+        }
+    }
+}
+
+static void printStatistics(double aElapsedSeconds) {
+    printf("\n%-16s %10s %8s %12s\n", "Protocol", "Frames", "Percent", "ns/decode");
+    for (uint_fast8_t i = UNKNOWN; i <= OTHER; i++) {
+        ProtocolStatistics *tStatistics = &sStatistics.Protocols[i];
+        if (tStatistics->NumberOfFrames > 0) {
+            printf("%-16s %10lu %7.2f%% %12.0f\n", getProtocolString((decode_type_t) i), (unsigned long) tStatistics->NumberOfFrames,
+                    (100.0 * tStatistics->NumberOfFrames) / sStatistics.NumberOfFrames,
+                    (double) tStatistics->DecodeNanos / tStatistics->NumberOfFrames);
+        }
+    }
+
+    printf("\n%-16s %12s %12s %10s %10s %10s\n", "Decoder", "Calls", "Hits", "ns/hit", "ns/miss", "max ns");
+    for (uint_fast8_t i = 0; i < NUMBER_OF_PROFILED_DECODERS; i++) {
+        DecoderStatistics *tStatistics = &sStatistics.Decoders[i];
+        if (tStatistics->NumberOfCalls > 0) {
+            uint64_t tNumberOfMisses = tStatistics->NumberOfCalls - tStatistics->NumberOfHits;
+            printf("%-16s %12llu %12llu %10.0f %10.0f %10lu\n", getProtocolString(tStatistics->Protocol),
+                    (unsigned long long) tStatistics->NumberOfCalls, (unsigned long long) tStatistics->NumberOfHits,
+                    tStatistics->NumberOfHits ? (double) tStatistics->SumOfHitNanos / tStatistics->NumberOfHits : 0.0,
+                    tNumberOfMisses ? (double) tStatistics->SumOfMissNanos / tNumberOfMisses : 0.0,
+                    (unsigned long) tStatistics->MaximumNanos);
+        }
+    }
+    printf("\nFrames=%lu UNKNOWN=%.2f%% Differences to recorded=%lu Skipped bytes=%lu\n", (unsigned long) sStatistics.NumberOfFrames,
+            sStatistics.NumberOfFrames ? (100.0 * sStatistics.Protocols[UNKNOWN].NumberOfFrames) / sStatistics.NumberOfFrames : 0.0,
+            (unsigned long) sStatistics.NumberOfDifferences, (unsigned long) sNumberOfSkippedBytes);
+    if (sStatistics.DecodeNanos > 0 && aElapsedSeconds > 0) {
+        printf("Decode only: %.0f frames/s", sStatistics.NumberOfFrames * 1e9 / sStatistics.DecodeNanos);
+        if (sNumberOfThreads > 1) {
+            printf(" per thread, %u threads", sNumberOfThreads);
+        }
+        printf(", including file parsing: %.0f frames/s\n", sStatistics.NumberOfFrames / aElapsedSeconds);
+    }
+}
+
+int main(int argc, char *argv[]) {
+    int tFirstFileArgument = 1;
+    while (tFirstFileArgument < argc) {
+        if (strcmp(argv[tFirstFileArgument], "-v") == 0) {
+            sVerbose = true;
+            tFirstFileArgument++;
+        } else if (strcmp(argv[tFirstFileArgument], "-j") == 0 && tFirstFileArgument + 1 < argc) {
+            int tNumberOfThreads = atoi(argv[tFirstFileArgument + 1]);
+            sNumberOfThreads = (tNumberOfThreads > 1) ? tNumberOfThreads : 1;
+            tFirstFileArgument += 2;
+        } else {
+            break;
+        }
+    }
+    if (tFirstFileArgument >= argc) {
+        fprintf(stderr, "Usage: %s [-v] [-j <threads>] <file>...\n", argv[0]);
+        fprintf(stderr, "Decodes binary records of writeIRResultAsBinaryRecord() or text output of printIRResultAsCArray()\n");
+        return 2;
+    }
+
+    auto tStart = std::chrono::steady_clock::now();
+    for (int i = tFirstFileArgument; i < argc; i++) {
+        FILE *tFile = fopen(argv[i], "rb");
+        if (tFile == nullptr) {
+            perror(argv[i]);
+            return 1;
+        }
+        int tFirstByte = fgetc(tFile);
+        if (tFirstByte == IR_BINARY_RECORD_START) {
+            ungetc(tFirstByte, tFile);
+            replayBinaryFile(tFile);
+            fclose(tFile);
+        } else {
+            fclose(tFile);
+            std::ifstream tTextFile(argv[i]);
+            replayTextFile(tTextFile);
+        }
+    }
+    if (sNumberOfThreads > 1) {
+        decodeStoredFramesInParallel();
+    }
+    printStatistics(std::chrono::duration<double>(std::chrono::steady_clock::now() - tStart).count());
+    return (sStatistics.NumberOfDifferences == 0) ? 0 : 1;
+}
@@ -0,0 +1,553 @@
+/*
+ * IRRoundTripTest.cpp
+ *
+ * Host round trip test and benchmark for all protocols, which can be sent by IrSender.write().
+ * For each protocol, frames with random address, command and number of repeats are generated by IrSender.encode().
+ * The marks and spaces are distorted like by a real receiver and then decoded frame by frame with IrReceiver.decode().
+ * The decoded protocol, address, command and repeat flag must be equal to the sent values, otherwise the frame is printed as failure.
+ * Before, an empty frame is replayed, which must be ignored.
+ * And NEC, LG and SamsungLG frames with repeats are encoded by a second IRsend instance,
+ * which must generate the same frames and durations, i.e. also the special repeat frames, as IrSender.
+ *
+ * Protocols, which are not tested:
+ * - PULSE_DISTANCE and PULSE_WIDTH, since write() cannot send them. They need the timing and the raw data array of the universal decoder,
+ *   which can be sent with sendPulseDistanceWidthFromArray().
+ * - OPENLASIR as OPENLASIR. The NEC decoder runs before the OpenLASIR decoder and decodes each OpenLASIR frame as ONKYO,
+ *   so OpenLASIR frames are checked to be decoded as ONKYO. OPENLASIR is only decoded if DECODE_NEC is not defined.
+ * - KASEIKYO with a vendor ID other than the one of KASEIKYO_JVC, KASEIKYO_DENON, KASEIKYO_SHARP and KASEIKYO_MITSUBISHI,
+ *   since write() cannot send it.
+ *
+ * The distortion of the simulated capture is done by the channel model in IRChannelSimulator.hpp.
+ * Noise in the gap before a frame is captured as separate noise frames, which are decoded but not checked,
+ * or becomes the start of the frame, which then usually fails.
+ * By default, each edge is moved by a random value between -30 and +30 microseconds
+ * and all marks are extended by the mark excess of the receiver module and the spaces are shortened by the same value.
+ *
+ * After the test, the tolerance margin of each protocol is determined with fewer frames:
+ * - The maximum edge jitter in steps of 10 us, for which all frames are decoded correctly.
+ * - The maximum deviation of the sender clock in percent, i.e. all durations are scaled by 1 +/- deviation.
+ *
+ * With -c <parameter>, the decode success rate and the decode time of each protocol are printed as CSV
+ * for increasing values of the parameter, instead of the test. Use these curves to evaluate changes of the tolerance of the decoders.
+ * If built with -DSUPPORT_RECEIVER_CALIBRATION, the tolerance in percent is set by -t <tolerance>.
+ * Without it, the tolerance of matchMark() and matchSpace() is fixed to 25% and cannot be changed by
+ * TOLERANCE_FOR_DECODERS_MARK_OR_SPACE_MATCHING_PERCENT, which is only used by USE_OLD_MATCH_FUNCTIONS.
+ *
+ * Build and run from the root of the library:
+ *   g++ -O2 -std=gnu++11 -I extras/host -I src extras/host/IRRoundTripTest.cpp -o irroundtrip
+ *   ./irroundtrip [-n <frames per protocol>] [-s <seed>] [-j <jitter micros>] [-e <mark excess micros>]
+ *                 [-a <AGC stretch micros>] [-d <drop mark percent>] [-m <merge space percent>] [-b <noise bursts per second>]
+ *                 [-c jitter|agc|drop|merge|noise] [-t <tolerance percent>] [-v]
+ *   -v  Print all failing frames instead of only the first one of each protocol.
+ * Add -DUSE_TEMPLATE_SEND_FUNCTIONS to the build command to encode NEC, NEC2, Apple, Onkyo, Samsung, SamsungLG, LG and Sony
+ * with the template send functions. The results must be the same as without.
+ * Returns 1 if a frame failed. Drop, merge and noise destroy frames, so they are only useful with -c.
+ * Frames per second is the number of decode() calls per second, i.e. it contains the repeats and excludes encoding and distortion.
+ *
+ *  This file is part of Arduino-IRremote https://github.com/Arduino-IRremote/Arduino-IRremote.
+ *
+ *************************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2026 Armin Joachimsmeyer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ ************************************************************************************
+ */
+#include <Arduino.h>
+
+#include <random>
+#include <vector>
+
+#if !defined(RAW_BUFFER_LENGTH)
+#define RAW_BUFFER_LENGTH  750              // For Bose, Samsung48 and Kaseikyo with 3 repeats
+#endif
+#define USE_16_BIT_TIMING_BUFFER
+#define DECODE_BEO                          // Not enabled by default
+#define USE_PROTOCOL_SPECIFIC_FRAME_GAP     // Required for B&O without increasing RECORD_GAP_MICROS
+#define SUPPORT_ENCODE_TO_DURATION_SINK
+#define IR_REMOTE_DISABLE_RECEIVE_COMPLETE_CALLBACK
+#include <IRremote.hpp>
+#include "IRChannelSimulator.hpp"
+
+HardwareSerial Serial;
+
+#define MAXIMUM_NUMBER_OF_REPEATS   3
+#define FIRST_FRAME_GAP_MICROS      1000000 // Greater than all maximum repeat distances
+#define FRAME_SPLIT_GAP_MICROS      20000   // Greater than the 15.6 ms start space of B&O and less than all gaps between repeats
+#define MARGIN_FRAMES_PER_STEP      200
+#define MARGIN_JITTER_STEP_MICROS   10
+#define MARGIN_MAXIMUM_JITTER       1000
+#define MARGIN_MAXIMUM_PERCENT      50
+#define CURVE_NUMBER_OF_STEPS       20
+
+/*
+ * Some protocols are decoded as a different protocol, if the distinguishing part is not contained in the current frame,
+ * e.g. the first frame of NEC2 is decoded as NEC, only its repeats are decoded as NEC2.
+ */
+struct RoundTripProtocol {
+    decode_type_t Protocol;
+    uint8_t NumberOfAddressBits;
+    uint8_t NumberOfCommandBits;
+    decode_type_t FirstFrameProtocol;
+    decode_type_t RepeatFrameProtocol;
+    bool HasRepeats;                    // false for protocols, which ignore aNumberOfRepeats or send repeats back to back
+};
+
+const RoundTripProtocol sRoundTripProtocols[] = {
+/*  Protocol             Address, Command, first frame          repeat frames        repeats */
+{ NEC, 8, 8, NEC, NEC, true },
+{ NEC2, 8, 8, NEC, NEC2, true },
+{ ONKYO, 16, 16, ONKYO, ONKYO, true },
+{ APPLE, 8, 8, APPLE, APPLE, true },
+{ SAMSUNG, 16, 8, SAMSUNG, SAMSUNG, true },
+{ SAMSUNGLG, 16, 8, SAMSUNG, SAMSUNGLG, true },
+{ SAMSUNG48, 16, 16, SAMSUNG48, SAMSUNG48, true },
+{ SONY, 5, 7, SONY, SONY, true },
+{ PANASONIC, 12, 8, PANASONIC, PANASONIC, true },
+{ KASEIKYO_JVC, 12, 8, KASEIKYO_JVC, KASEIKYO_JVC, true },
+{ KASEIKYO_DENON, 12, 8, KASEIKYO_DENON, KASEIKYO_DENON, true },
+{ KASEIKYO_SHARP, 12, 8, KASEIKYO_SHARP, KASEIKYO_SHARP, true },
+{ KASEIKYO_MITSUBISHI, 12, 8, KASEIKYO_MITSUBISHI, KASEIKYO_MITSUBISHI, true },
+{ DENON, 5, 8, DENON, DENON, true },
+{ SHARP, 5, 8, SHARP, SHARP, true },
+{ LG, 8, 16, LG, LG, true },
+{ JVC, 8, 8, JVC, JVC, true },
+{ RC5, 5, 7, RC5, RC5, true },
+{ RC6, 8, 8, RC6, RC6, true },
+{ RC6A, 8, 8, RC6A, RC6A, true }, // The 14 bit customer code is sent and checked in extra
+{ MARANTZ, 5, 7, MARANTZ, MARANTZ, true }, // The 6 bit command extension is sent and checked in extra
+{ BOSEWAVE, 0, 8, BOSEWAVE, BOSEWAVE, true },
+{ FAST, 0, 8, FAST, FAST, true },
+{ LEGO_PF, 0, 0, LEGO_PF, LEGO_PF, false },
+{ WHYNTER, 0, 0, WHYNTER, WHYNTER, false }, // The 32 bit raw data is sent and checked. The decoder does not flag repeats.
+{ OPENLASIR, 8, 16, ONKYO, ONKYO, true }, // The NEC decoder runs before the OpenLASIR decoder and accepts each OpenLASIR frame as ONKYO
+{ MAGIQUEST, 16, 9, MAGIQUEST, MAGIQUEST, false },
+{ BANG_OLUFSEN, 8, 8, BANG_OLUFSEN, BANG_OLUFSEN, false } };
+
+/*
+ * Splits the encoded durations at the gaps between the repeats
+ */
+struct EncodedFrame {
+    uint32_t GapMicros; // Gap before the frame
+    std::vector<uint32_t> DurationsMicros;
+};
+
+class FrameSplittingSink: public IRDurationSink {
+public:
+    std::vector<EncodedFrame> Frames;
+    bool LastWasMark = false;
+
+    void reset() {
+        Frames.clear();
+        LastWasMark = false;
+    }
+    void setFrequency(uint_fast16_t aFrequencyKHz) override {
+        (void) aFrequencyKHz;
+    }
+    void mark(uint16_t aMarkMicros) override {
+        if (Frames.empty()) {
+            Frames.push_back(EncodedFrame { FIRST_FRAME_GAP_MICROS, { } });
+        }
+        std::vector<uint32_t> &tDurations = Frames.back().DurationsMicros;
+        if (LastWasMark) {
+            tDurations.back() += aMarkMicros;
+        } else {
+            tDurations.push_back(aMarkMicros);
+        }
+        LastWasMark = true;
+    }
+    void space(uint32_t aSpaceMicros) override {
+        if (Frames.empty()) {
+            return; // leading space
+        }
+        EncodedFrame &tFrame = Frames.back();
+        if (tFrame.DurationsMicros.empty()) {
+            tFrame.GapMicros += aSpaceMicros; // Gap consists of multiple spaces
+            return;
+        }
+        if (LastWasMark) {
+            tFrame.DurationsMicros.push_back(aSpaceMicros);
+        } else {
+            tFrame.DurationsMicros.back() += aSpaceMicros;
+        }
+        LastWasMark = false;
+        if (tFrame.DurationsMicros.back() > FRAME_SPLIT_GAP_MICROS) {
+            // Gap to next frame
+            uint32_t tGapMicros = tFrame.DurationsMicros.back();
+            tFrame.DurationsMicros.pop_back();
+            Frames.push_back(EncodedFrame { tGapMicros, { } });
+        }
+    }
+};
+
+static std::mt19937 sRandom;
+static FrameSplittingSink sSink;
+static IRChannelSimulator sChannel;
+static bool sVerbose = false;
+static uint64_t sDecodeNanos;
+static uint32_t sNumberOfDecodedFrames;
+static uint32_t sNumberOfCorrectFrames;
+
+static void printFailure(const RoundTripProtocol &aProtocol, IRData *aSentIRData, uint_fast8_t aFrameIndex,
+        const std::vector<uint16_t> &aDurations) {
+    printf("%s address=0x%X command=0x%X frame %u decoded as: ", getProtocolString(aProtocol.Protocol), aSentIRData->address,
+            aSentIRData->command, aFrameIndex);
+    IrReceiver.printIRResultShort(&Serial);
+    printf("uint16_t rawData[%u] = {", (unsigned int) aDurations.size());
+    for (size_t i = 0; i < aDurations.size(); i++) {
+        printf(i ? ", %u" : "%u", aDurations[i]);
+    }
+    printf("};\n");
+}
+
+static bool hasNECParity(uint16_t aValue) {
+    return (aValue & 0xFF) == (uint8_t) ~(aValue >> 8);
+}
+
+/*
+ * Encodes one random frame with random number of repeats, decodes all resulting frames and checks the result.
+ * @return true if all frames were decoded correctly.
+ */
+static bool roundTripOneFrame(const RoundTripProtocol &aProtocol, const IRChannelParameters &aChannelParameters, bool aPrintFailure) {
+    IRData tSentIRData;
+    memset(&tSentIRData, 0, sizeof(tSentIRData));
+    tSentIRData.protocol = aProtocol.Protocol;
+    tSentIRData.address = sRandom() & ((1UL << aProtocol.NumberOfAddressBits) - 1);
+    tSentIRData.command = sRandom() & ((1UL << aProtocol.NumberOfCommandBits) - 1);
+    if (aProtocol.Protocol == SONY) {
+        static const uint8_t sSonyBits[] = { SIRCS_12_PROTOCOL, SIRCS_15_PROTOCOL, SIRCS_20_PROTOCOL };
+        tSentIRData.numberOfBits = sSonyBits[sRandom() % 3];
+        tSentIRData.address &= (tSentIRData.numberOfBits == SIRCS_20_PROTOCOL) ? 0x1FFF : 0xFF;
+        if (tSentIRData.numberOfBits == SIRCS_12_PROTOCOL) {
+            tSentIRData.address &= 0x1F;
+        }
+    } else if (aProtocol.Protocol == ONKYO || aProtocol.Protocol == OPENLASIR) {
+        // 16 bit values with valid NEC parity are decoded as 8 bit NEC values, see "Ambiguous protocols" in README
+        while (hasNECParity(tSentIRData.command)) {
+            tSentIRData.command = sRandom();
+        }
+        while (aProtocol.Protocol == ONKYO && (hasNECParity(tSentIRData.address) || tSentIRData.address == APPLE_ADDRESS)) {
+            tSentIRData.address = sRandom();
+        }
+    } else if (aProtocol.Protocol == SAMSUNG || aProtocol.Protocol == SAMSUNGLG) {
+        // 16 bit addresses with 2 equal bytes are decoded as 8 bit addresses
+        while ((tSentIRData.address >> 8) == (tSentIRData.address & 0xFF)) {
+            tSentIRData.address = sRandom() & 0xFFFF;
+        }
+    } else if (aProtocol.Protocol == MAGIQUEST) {
+        tSentIRData.decodedRawData = sRandom();
+        tSentIRData.address = tSentIRData.decodedRawData & 0xFFFF;
+    } else if (aProtocol.Protocol == WHYNTER) {
+        tSentIRData.decodedRawData = sRandom();
+    } else if (aProtocol.Protocol == RC6A) {
+        tSentIRData.extra = sRandom() & 0x3FFF;
+    } else if (aProtocol.Protocol == MARANTZ) {
+        tSentIRData.extra = sRandom() & 0x3F;
+    }
+    int_fast8_t tNumberOfRepeats = aProtocol.HasRepeats ? sRandom() % (MAXIMUM_NUMBER_OF_REPEATS + 1) : 0;
+
+    sSink.reset();
+    IrSender.encode(&tSentIRData, &sSink, tNumberOfRepeats);
+
+    bool tIsOK = true;
+    std::vector<IRCapturedFrame> tCapturedFrames;
+    sChannel.Parameters = aChannelParameters;
+    for (uint_fast8_t i = 0; i < sSink.Frames.size(); i++) {
+        EncodedFrame &tFrame = sSink.Frames[i];
+        if (tFrame.DurationsMicros.empty()) {
+            continue;
+        }
+        sChannel.transmit(tFrame.DurationsMicros, tFrame.GapMicros, tCapturedFrames);
+        for (size_t j = 0; j + 1 < tCapturedFrames.size(); j++) {
+            // Noise captured in the gap. It is decoded like by a real application, which changes the data for repeat detection.
+            IRCapturedFrame &tNoiseFrame = tCapturedFrames[j];
+            IrReceiver.replayRawFrame(&tNoiseFrame.DurationsMicros[0], tNoiseFrame.DurationsMicros.size(), tNoiseFrame.GapMicros);
+            IrReceiver.decode();
+            IrReceiver.resume();
+        }
+        IRCapturedFrame &tCapturedFrame = tCapturedFrames.back();
+        std::vector<uint16_t> &tDurations = tCapturedFrame.DurationsMicros;
+        IrReceiver.replayRawFrame(&tDurations[0], tDurations.size(), tCapturedFrame.GapMicros);
+
+        auto tStart = std::chrono::steady_clock::now();
+        IrReceiver.decode();
+        sDecodeNanos += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - tStart).count();
+        sNumberOfDecodedFrames++;
+
+        IRData *tDecodedIRData = &IrReceiver.decodedIRData;
+        decode_type_t tExpectedProtocol = (i == 0) ? aProtocol.FirstFrameProtocol : aProtocol.RepeatFrameProtocol;
+        bool tFrameIsOK = tDecodedIRData->protocol == tExpectedProtocol && tDecodedIRData->address == tSentIRData.address
+                && tDecodedIRData->command == tSentIRData.command
+                && ((aProtocol.Protocol != RC6A && aProtocol.Protocol != MARANTZ) || tDecodedIRData->extra == tSentIRData.extra)
+                && (aProtocol.Protocol != WHYNTER || tDecodedIRData->decodedRawData == tSentIRData.decodedRawData)
+                && ((i == 0) == !(tDecodedIRData->flags & (IRDATA_FLAGS_IS_REPEAT | IRDATA_FLAGS_IS_AUTO_REPEAT)));
+        if (tFrameIsOK) {
+            sNumberOfCorrectFrames++;
+        } else if (aPrintFailure) {
+            printFailure(aProtocol, &tSentIRData, i, tDurations);
+            aPrintFailure = sVerbose;
+        }
+        tIsOK = tIsOK && tFrameIsOK;
+        IrReceiver.resume();
+    }
+    return tIsOK;
+}
+
+/*
+ * @return true if all aNumberOfFrames frames were decoded correctly
+ */
+static bool roundTrip(const RoundTripProtocol &aProtocol, const IRChannelParameters &aChannelParameters, uint32_t aNumberOfFrames,
+        uint32_t *aNumberOfFailures, bool aPrintFailure) {
+    uint32_t tNumberOfFailures = 0;
+    for (uint32_t i = 0; i < aNumberOfFrames; i++) {
+        if (!roundTripOneFrame(aProtocol, aChannelParameters, aPrintFailure && (tNumberOfFailures == 0 || sVerbose))) {
+            tNumberOfFailures++;
+        }
+    }
+    if (aNumberOfFailures != nullptr) {
+        *aNumberOfFailures = tNumberOfFailures;
+    }
+    return tNumberOfFailures == 0;
+}
+
+/*
+ * Replays an empty frame after a valid one, which must neither read the durations nor leave the previous frame available
+ * @return true if the empty frame was ignored
+ */
+static bool checkEmptyFrame() {
+    const uint16_t tValidFrame[] = { 9000, 4500, 560, 40000 }; // NEC repeat with trailing space
+    IrReceiver.replayRawFrame(tValidFrame, sizeof(tValidFrame) / sizeof(tValidFrame[0]));
+    IrReceiver.decode();
+    IrReceiver.resume();
+    IrReceiver.replayRawFrame(tValidFrame, 0);
+    if (IrReceiver.available()) {
+        printf("Empty frame is available after replay\n");
+        return false;
+    }
+    return true;
+}
+
+/*
+ * Encodes NEC, LG and SamsungLG frames with repeats by a second IRsend instance.
+ * The special repeat frames must be generated by this instance into its sink, and not be sent by IrSender.
+ * @return true if the second instance generates the same frames and durations as IrSender.
+ */
+static bool checkSecondSender() {
+    static const decode_type_t sSpecialRepeatProtocols[] = { NEC, LG, SAMSUNGLG };
+    const int_fast8_t tNumberOfRepeats = 2;
+    IRsend tSecondSender;
+    bool tSuccess = true;
+    for (decode_type_t tProtocol : sSpecialRepeatProtocols) {
+        IRData tSentIRData;
+        memset(&tSentIRData, 0, sizeof(tSentIRData));
+        tSentIRData.protocol = tProtocol;
+        tSentIRData.address = 0x12;
+        tSentIRData.command = 0x34;
+        sSink.reset();
+        IrSender.encode(&tSentIRData, &sSink, tNumberOfRepeats);
+        std::vector<EncodedFrame> tExpectedFrames = sSink.Frames;
+        sSink.reset();
+        tSecondSender.encode(&tSentIRData, &sSink, tNumberOfRepeats);
+        size_t tNumberOfDurations = 0;
+        size_t tExpectedNumberOfDurations = 0;
+        for (size_t i = 0; i < sSink.Frames.size(); i++) {
+            tNumberOfDurations += sSink.Frames[i].DurationsMicros.size();
+        }
+        for (size_t i = 0; i < tExpectedFrames.size(); i++) {
+            tExpectedNumberOfDurations += tExpectedFrames[i].DurationsMicros.size();
+        }
+        if (tExpectedFrames.size() != (size_t) tNumberOfRepeats + 1 || sSink.Frames.size() != tExpectedFrames.size()
+                || tNumberOfDurations != tExpectedNumberOfDurations) {
+            printf("%s encoded by second IRsend: frames=%u durations=%u, expected frames=%u durations=%u\n",
+                    getProtocolString(tProtocol), (unsigned int) sSink.Frames.size(), (unsigned int) tNumberOfDurations,
+                    (unsigned int) tExpectedFrames.size(), (unsigned int) tExpectedNumberOfDurations);
+            tSuccess = false;
+        }
+    }
+    return tSuccess;
+}
+
+/*
+ * @return The maximum jitter, for which all frames are decoded correctly or -1 if even 0 fails
+ */
+static int getJitterMargin(const RoundTripProtocol &aProtocol, const IRChannelParameters &aChannelParameters) {
+    IRChannelParameters tChannelParameters = aChannelParameters;
+    int tMargin = -1;
+    for (int tJitter = 0; tJitter <= MARGIN_MAXIMUM_JITTER; tJitter += MARGIN_JITTER_STEP_MICROS) {
+        tChannelParameters.JitterMicros = tJitter;
+        if (!roundTrip(aProtocol, tChannelParameters, MARGIN_FRAMES_PER_STEP, nullptr, false)) {
+            break;
+        }
+        tMargin = tJitter;
+    }
+    return tMargin;
+}
+
+/*
+ * @return The maximum clock deviation in percent for both directions, for which all frames are decoded correctly or -1 if even 0 fails
+ */
+static int getClockMargin(const RoundTripProtocol &aProtocol, const IRChannelParameters &aChannelParameters) {
+    IRChannelParameters tChannelParameters = aChannelParameters;
+    int tMargin = -1;
+    for (int tPercent = 0; tPercent <= MARGIN_MAXIMUM_PERCENT; tPercent++) {
+        tChannelParameters.ClockDeviationPercent = tPercent;
+        if (!roundTrip(aProtocol, tChannelParameters, MARGIN_FRAMES_PER_STEP / 2, nullptr, false)) {
+            break;
+        }
+        tChannelParameters.ClockDeviationPercent = -tPercent;
+        if (!roundTrip(aProtocol, tChannelParameters, MARGIN_FRAMES_PER_STEP / 2, nullptr, false)) {
+            break;
+        }
+        tMargin = tPercent;
+    }
+    return tMargin;
+}
+
+/*
+ * Sets the parameter selected by aCurveParameter to the value for step aStep of CURVE_NUMBER_OF_STEPS
+ * @return The value of the parameter or -1 if aCurveParameter is unknown
+ */
+static float setCurveParameter(const char *aCurveParameter, uint_fast8_t aStep, IRChannelParameters *aChannelParameters) {
+    if (strcmp(aCurveParameter, "jitter") == 0) {
+        return aChannelParameters->JitterMicros = aStep * 20; // 0 to 400 us
+    } else if (strcmp(aCurveParameter, "agc") == 0) {
+        return aChannelParameters->AGCStretchMicros = aStep * 20; // 0 to 400 us
+    } else if (strcmp(aCurveParameter, "drop") == 0) {
+        return aChannelParameters->DropMarkPercent = aStep * 0.5; // 0 to 10 %
+    } else if (strcmp(aCurveParameter, "merge") == 0) {
+        return aChannelParameters->MergeSpacePercent = aStep * 0.5; // 0 to 10 %
+    } else if (strcmp(aCurveParameter, "noise") == 0) {
+        return aChannelParameters->NoiseBurstsPerSecond = aStep * 10; // 0 to 200 bursts per second
+    }
+    return -1;
+}
+
+/*
+ * Prints one CSV line per protocol and parameter value with the percentage of correctly decoded frames
+ * and the average decode time of a frame
+ */
+static void printCurves(const char *aCurveParameter, const IRChannelParameters &aChannelParameters, uint32_t aFramesPerStep) {
+    printf("Protocol,%s,Correct frames [%%],Decode time [ns]\n", aCurveParameter);
+    for (const RoundTripProtocol &tProtocol : sRoundTripProtocols) {
+        for (uint_fast8_t tStep = 0; tStep <= CURVE_NUMBER_OF_STEPS; tStep++) {
+            IRChannelParameters tChannelParameters = aChannelParameters;
+            float tValue = setCurveParameter(aCurveParameter, tStep, &tChannelParameters);
+            sDecodeNanos = 0;
+            sNumberOfDecodedFrames = 0;
+            sNumberOfCorrectFrames = 0;
+            roundTrip(tProtocol, tChannelParameters, aFramesPerStep, nullptr, false);
+            printf("%s,%g,%.2f,%.0f\n", getProtocolString(tProtocol.Protocol), tValue,
+                    sNumberOfCorrectFrames * 100.0 / sNumberOfDecodedFrames, (double) sDecodeNanos / sNumberOfDecodedFrames);
+        }
+    }
+}
+
+int main(int argc, char *argv[]) {
+    uint32_t tFramesPerProtocol = 1000;
+    uint32_t tSeed = 1;
+    const char *tCurveParameter = nullptr;
+    IRChannelParameters tChannelParameters;
+    tChannelParameters.JitterMicros = 30;
+    tChannelParameters.MarkExcessMicros = MARK_EXCESS_MICROS;
+    tChannelParameters.RecordGapMicros = RECORD_GAP_MICROS;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-v") == 0) {
+            sVerbose = true;
+        } else if (i + 1 < argc && strcmp(argv[i], "-n") == 0) {
+            tFramesPerProtocol = strtoul(argv[++i], nullptr, 0);
+        } else if (i + 1 < argc && strcmp(argv[i], "-s") == 0) {
+            tSeed = strtoul(argv[++i], nullptr, 0);
+        } else if (i + 1 < argc && strcmp(argv[i], "-j") == 0) {
+            tChannelParameters.JitterMicros = strtoul(argv[++i], nullptr, 0);
+        } else if (i + 1 < argc && strcmp(argv[i], "-e") == 0) {
+            tChannelParameters.MarkExcessMicros = strtol(argv[++i], nullptr, 0);
+        } else if (i + 1 < argc && strcmp(argv[i], "-a") == 0) {
+            tChannelParameters.AGCStretchMicros = strtoul(argv[++i], nullptr, 0);
+        } else if (i + 1 < argc && strcmp(argv[i], "-d") == 0) {
+            tChannelParameters.DropMarkPercent = strtof(argv[++i], nullptr);
+        } else if (i + 1 < argc && strcmp(argv[i], "-m") == 0) {
+            tChannelParameters.MergeSpacePercent = strtof(argv[++i], nullptr);
+        } else if (i + 1 < argc && strcmp(argv[i], "-b") == 0) {
+            tChannelParameters.NoiseBurstsPerSecond = strtof(argv[++i], nullptr);
+#if defined(SUPPORT_RECEIVER_CALIBRATION)
+        } else if (i + 1 < argc && strcmp(argv[i], "-t") == 0) {
+            IRReceiverCalibration tCalibration;
+            IrReceiver.getReceiverCalibration(&tCalibration);
+            tCalibration.TolerancePercent = strtoul(argv[++i], nullptr, 0);
+            IrReceiver.setReceiverCalibration(&tCalibration);
+#endif
+        } else if (i + 1 < argc && strcmp(argv[i], "-c") == 0) {
+            tCurveParameter = argv[++i];
+            IRChannelParameters tCheckedParameters;
+            if (setCurveParameter(tCurveParameter, 0, &tCheckedParameters) < 0) {
+                fprintf(stderr, "Unknown parameter %s for -c\n", tCurveParameter);
+                return 2;
+            }
+        } else {
+            fprintf(stderr, "Usage: %s [-n <frames per protocol>] [-s <seed>] [-j <jitter micros>] [-e <mark excess micros>]\n"
+                    "  [-a <AGC stretch micros>] [-d <drop mark percent>] [-m <merge space percent>] [-b <noise bursts per second>]\n"
+                    "  [-c jitter|agc|drop|merge|noise] [-t <tolerance percent>] [-v]\n", argv[0]);
+            return 2;
+        }
+    }
+    sRandom.seed(tSeed);
+    sChannel.seed(tSeed);
+    if (tCurveParameter != nullptr) {
+        printCurves(tCurveParameter, tChannelParameters, tFramesPerProtocol / CURVE_NUMBER_OF_STEPS + 1);
+        return 0;
+    }
+    printf("Seed=%lu, jitter=+/-%u us, mark excess=%d us, AGC stretch=%u us, drop=%g%%, merge=%g%%, noise=%g/s\n",
+            (unsigned long) tSeed, tChannelParameters.JitterMicros, tChannelParameters.MarkExcessMicros,
+            tChannelParameters.AGCStretchMicros, tChannelParameters.DropMarkPercent, tChannelParameters.MergeSpacePercent,
+            tChannelParameters.NoiseBurstsPerSecond);
+    printf("%lu frames per protocol with 0 to %d repeats\n", (unsigned long) tFramesPerProtocol, MAXIMUM_NUMBER_OF_REPEATS);
+#if defined(USE_TEMPLATE_SEND_FUNCTIONS)
+    printf("Encoded with template send functions\n");
+#endif
+    printf("\n");
+
+    uint32_t tTotalFailures = 0;
+    if (!checkEmptyFrame()) {
+        tTotalFailures++;
+    }
+    if (!checkSecondSender()) {
+        tTotalFailures++;
+    }
+    std::vector<uint32_t> tFailures;
+    std::vector<double> tFramesPerSecond;
+    for (const RoundTripProtocol &tProtocol : sRoundTripProtocols) {
+        sDecodeNanos = 0;
+        sNumberOfDecodedFrames = 0;
+        uint32_t tNumberOfFailures;
+        roundTrip(tProtocol, tChannelParameters, tFramesPerProtocol, &tNumberOfFailures, true);
+        tFailures.push_back(tNumberOfFailures);
+        tFramesPerSecond.push_back(sDecodeNanos ? sNumberOfDecodedFrames * 1e9 / sDecodeNanos : 0);
+        tTotalFailures += tNumberOfFailures;
+    }
+
+    printf("\n%-20s %8s %12s %12s %12s\n", "Protocol", "Failures", "Frames/s", "Jitter [us]", "Clock [%]");
+    for (size_t i = 0; i < sizeof(sRoundTripProtocols) / sizeof(sRoundTripProtocols[0]); i++) {
+        const RoundTripProtocol &tProtocol = sRoundTripProtocols[i];
+        printf("%-20s %8lu %12.0f %12d %12d\n", getProtocolString(tProtocol.Protocol), (unsigned long) tFailures[i], tFramesPerSecond[i],
+                getJitterMargin(tProtocol, tChannelParameters), getClockMargin(tProtocol, tChannelParameters));
+    }
+    printf("\nFailures=%lu\n", (unsigned long) tTotalFailures);
+    return (tTotalFailures == 0) ? 0 : 1;
+}
@@ -88,7 +88,7 @@
 #  endif
 #endif // !defined(NO_DECODER)
 
-//#define DECODE_BEO // Bang & Olufsen protocol always must be enabled explicitly. It prevents decoding of SONY!
+//#define DECODE_BEO // Bang & Olufsen protocol always must be enabled explicitly. It prevents decoding of SONY, if USE_PROTOCOL_SPECIFIC_FRAME_GAP is not defined!
 
 #if defined(DECODE_NEC) && !(~(~DECODE_NEC + 0) == 0 && ~(~DECODE_NEC + 1) == 1)
 #warning "The macros DECODE_XXX no longer require a value. Decoding is now switched by defining / non defining the macro."
@@ -110,6 +110,14 @@ typedef enum {
 } decode_type_t;
 extern const char *const ProtocolNames[]; // The array of name strings for the decode_type_t enum
 
+/*
+ * Bit masks of protocols for IrReceiver.setEnabledProtocols(). All protocols except OTHER fit into 32 bit.
+ * UNKNOWN stands for the hash decoder. The mask of OTHER and of invalid values is 0, since shifting by 32 is undefined.
+ */
+#define PROTOCOL_MASK(aProtocol)    (((uint_fast8_t) (aProtocol) < 32) ? (1UL << (aProtocol)) : 0UL)
+#define ALL_PROTOCOLS_MASK          0xFFFFFFFF
+static_assert(OPENLASIR < 32, "All decodable protocols must fit into the 32 bit mask of setEnabledProtocols()");
+
 #define SIRCS_12_PROTOCOL       12
 #define SIRCS_15_PROTOCOL       15
 #define SIRCS_20_PROTOCOL       20
@@ -141,15 +149,27 @@ struct DistanceWidthTimingInfoStruct {
 
 extern uint8_t sLastSendToggleValue; // Currently used by RC5 + RC6
 
+class IRsend;
 struct PulseDistanceWidthProtocolConstants {
     decode_type_t ProtocolIndex;
     uint_fast8_t FrequencyKHz;
     DistanceWidthTimingInfoStruct DistanceWidthTimingInfo;
     uint8_t Flags;
     unsigned int RepeatPeriodMillis; // Time between start of two frames. Thus independent from frame length.
+#if defined(SUPPORT_ENCODE_TO_DURATION_SINK)
+    void (IRsend::*SpecialSendRepeatFunction)(); // The repeat must be generated by the instance, which encodes to its sink
+#else
     void (*SpecialSendRepeatFunction)(); // using non member functions here saves up to 250 bytes for send demo
-//    void (IRsend::*SpecialSendRepeatFunction)();
+#endif
 };
+/*
+ * Selects the static or the member function for SpecialSendRepeatFunction, e.g. SPECIAL_SEND_REPEAT_FUNCTION(sendNECSpecialRepeat, sendNECRepeat)
+ */
+#if defined(SUPPORT_ENCODE_TO_DURATION_SINK)
+#define SPECIAL_SEND_REPEAT_FUNCTION(aStaticFunction, aMemberFunction)  (&IRsend::aMemberFunction)
+#else
+#define SPECIAL_SEND_REPEAT_FUNCTION(aStaticFunction, aMemberFunction)  (&aStaticFunction)
+#endif
 /*
  * Definitions for member PulseDistanceWidthProtocolConstants.Flags
  */
@@ -162,6 +182,45 @@ struct PulseDistanceWidthProtocolConstants {
 #define PROTOCOL_IS_LSB_FIRST           IRDATA_FLAGS_IS_LSB_FIRST
 #define PROTOCOL_IS_MSB_MASK            IRDATA_FLAGS_IS_MSB_FIRST
 
+/**
+ * Compile time view of a constexpr PulseDistanceWidthProtocolConstants, used as template parameter for the
+ * IRsend::sendPulseDistanceWidth<>() and IRsend::sendPulseDistanceWidthData<>() functions.
+ * All values are taken from the constants struct at compile time, so the compiler can generate a send loop
+ * with fixed timing and bit order and without evaluating the flags for each bit.
+ * E.g. typedef PulseDistanceWidthProtocolDescriptor<NECProtocolConstants> NECProtocolDescriptor;
+ */
+template<const PulseDistanceWidthProtocolConstants &tConstants>
+struct PulseDistanceWidthProtocolDescriptor {
+    static constexpr decode_type_t ProtocolIndex = tConstants.ProtocolIndex;
+    static constexpr uint_fast8_t FrequencyKHz = tConstants.FrequencyKHz;
+    static constexpr uint16_t HeaderMarkMicros = tConstants.DistanceWidthTimingInfo.HeaderMarkMicros;
+    static constexpr uint16_t HeaderSpaceMicros = tConstants.DistanceWidthTimingInfo.HeaderSpaceMicros;
+    static constexpr uint16_t OneMarkMicros = tConstants.DistanceWidthTimingInfo.OneMarkMicros;
+    static constexpr uint16_t OneSpaceMicros = tConstants.DistanceWidthTimingInfo.OneSpaceMicros;
+    static constexpr uint16_t ZeroMarkMicros = tConstants.DistanceWidthTimingInfo.ZeroMarkMicros;
+    static constexpr uint16_t ZeroSpaceMicros = tConstants.DistanceWidthTimingInfo.ZeroSpaceMicros;
+    static constexpr uint8_t Flags = tConstants.Flags;
+    static constexpr uint16_t RepeatPeriodMillis = tConstants.RepeatPeriodMillis;
+    static constexpr bool isMSBFirst = (Flags & PROTOCOL_IS_MSB_MASK);
+    /*
+     * Same condition as in the runtime sendPulseDistanceWidthData(): stop bit is sent for pulse distance protocols
+     */
+    static constexpr bool hasStopBit = !(Flags & SUPPRESS_STOP_BIT)
+            && ((OneSpaceMicros > ZeroSpaceMicros ? OneSpaceMicros - ZeroSpaceMicros : ZeroSpaceMicros - OneSpaceMicros)
+                    > (OneSpaceMicros / 4));
+    static void sendSpecialRepeat(IRsend *aIRsend) {
+#if defined(SUPPORT_ENCODE_TO_DURATION_SINK)
+        (aIRsend->*tConstants.SpecialSendRepeatFunction)();
+#else
+        (void) aIRsend;
+        tConstants.SpecialSendRepeatFunction();
+#endif
+    }
+    static constexpr bool hasSpecialRepeat() {
+        return tConstants.SpecialSendRepeatFunction != nullptr;
+    }
+};
+
 /*
  * Carrier frequencies for various protocols
  */
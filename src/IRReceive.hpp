@@ -48,6 +48,19 @@
 #endif
 
 unsigned long sMicrosAtLastStopTimer = 0; // Used to adjust TickCounterForISR with uncounted ticks between stopTimer() and restartTimer()
+#if defined(USE_RUNTIME_MICROS_PER_TICK)
+uint8_t sMicrosPerTick = 50;
+uint16_t sRecordGapTicks = RECORD_GAP_MICROS / 50;
+#  if defined(MINIMUM_PULSE_MICROS)
+uint8_t sMinimumPulseTicks = MINIMUM_PULSE_MICROS / 50;
+#  endif
+#endif
+#if defined(USE_LOW_POWER_IDLE_FOR_RECEIVE)
+// The receive timer interrupt is stopped in idle state after the gap and restarted by the wake up interrupt at the next edge
+volatile bool sReceiveTimerIsParked = false;
+unsigned long sMicrosAtReceiveTimerParking;
+void IRReceiveWakeupInterruptHandler();
+#endif
 
 /** \addtogroup Receiving Receiving IR data for multiple protocols
  * @{
@@ -93,6 +106,7 @@ IRrecv::IRrecv(uint_fast8_t aReceivePin, uint_fast8_t aFeedbackLEDPin) {
  * First entry is the SPACE between transmissions.
  *
  * As soon as one SPACE entry gets longer than RECORD_GAP_TICKS, state switches to STOP (frame received). Timing of SPACE continues.
+ * With USE_PROTOCOL_SPECIFIC_FRAME_GAP, the limit for the SPACE entry is irparams.FrameGapTicks, which may be increased by setProtocolSpecificFrameGap().
  * A call of resume() switches from STOP to IDLE.
  * As soon as first MARK arrives in IDLE, gap width is recorded and new logging starts.
  *
@@ -119,6 +133,18 @@ void IRrecv::ReceiveInterruptHandler() {
     timerResetInterruptPending(); // reset TickCounterForISR interrupt flag if required (currently only for Teensy and ATmega4809)
 #endif
 
+#if defined(USE_EDGE_CAPTURE_FOR_RECEIVE)
+    /*
+     * With edge capture, the timer only runs during a frame, if a receive complete callback is registered.
+     * It detects the gap after the last mark and stops itself afterwards.
+     */
+    handleCapturedFrameTimeout();
+    if (irparams.StateForISR != IR_REC_STATE_MARK && irparams.StateForISR != IR_REC_STATE_SPACE) {
+        timerDisableReceiveInterrupt();
+    }
+    return;
+#endif
+
 // Read if IR Receiver -> SPACE [xmt LED off] or a MARK [xmt LED on]
 #if defined(__AVR__)
     uint8_t tIRInputLevel = *irparams.IRReceivePinPortInputRegister & irparams.IRReceivePinMask;
@@ -162,13 +188,54 @@ void IRrecv::ReceiveInterruptHandler() {
                 // because the big gap value is not stored in this buffer any more
                 irparams.initialGapTicks = tTickCounterForISR;
                 irparams.rawlen = 1;
+#if defined(LONG_INTERVALS_BUFFER_LENGTH)
+                irparams.NumberOfLongIntervals = 0;
+#endif
+#if defined(USE_PROTOCOL_SPECIFIC_FRAME_GAP)
+                irparams.FrameGapTicks = RECORD_GAP_TICKS;
+#endif
                 irparams.StateForISR = IR_REC_STATE_MARK;
             } // otherwise stay in idle state
             irparams.TickCounterForISR = 0; // reset counter in both cases
         }
+#if defined(USE_LOW_POWER_IDLE_FOR_RECEIVE)
+        else if (tTickCounterForISR > RECORD_GAP_TICKS) {
+            /*
+             * The gap is long enough for the next frame, so we need no more ticks until its first edge.
+             * The wake up interrupt is only attached while parked, since it detaches itself at the first mark.
+             * A LOW level interrupt is triggered by a mark, which started after reading the input, too.
+             */
+            timerDisableReceiveInterrupt();
+            sMicrosAtReceiveTimerParking = micros();
+            sReceiveTimerIsParked = true;
+            attachInterrupt(digitalPinToInterrupt(irparams.IRReceivePin), IRReceiveWakeupInterruptHandler, IR_WAKEUP_INTERRUPT_MODE);
+#  if defined(IR_WAKEUP_BY_EDGE)
+            if ((uint_fast8_t) digitalRead(irparams.IRReceivePin) == INPUT_MARK) {
+                // The mark started after reading the input and before attaching, so its edge was missed
+                IRReceiveWakeupInterruptHandler();
+            }
+#  endif
+        }
+#endif
 
     } else if (tStateForISR == IR_REC_STATE_MARK) {
         // Timing mark here, rawlen is even
+#if defined(MINIMUM_PULSE_TICKS)
+        if (tIRInputLevel != INPUT_MARK && tTickCounterForISR < MINIMUM_PULSE_TICKS) {
+            /*
+             * Glitch mark ended here. Merge it with the preceding space and continue timing this space.
+             * A glitch as first mark of a frame is discarded and we continue timing the gap in idle state.
+             */
+            if (irparams.rawlen > 1) {
+                tTickCounterForISR += getRawbufTicks(--irparams.rawlen);
+                irparams.StateForISR = IR_REC_STATE_SPACE;
+            } else {
+                tTickCounterForISR = irparams.initialGapTicks; // the glitch ticks are negligible here
+                irparams.StateForISR = IR_REC_STATE_IDLE;
+            }
+            irparams.TickCounterForISR = tTickCounterForISR;
+        } else
+#endif
         if (tIRInputLevel != INPUT_MARK) {
             /*
              * Mark ended here. Record mark time in rawbuf array
@@ -179,10 +246,18 @@ void IRrecv::ReceiveInterruptHandler() {
 #if !defined(USE_16_BIT_TIMING_BUFFER)
             // Clip timings > 12750 us (255 * 50) to 12750
             if (tTickCounterForISR > UINT8_MAX) {
+#  if defined(LONG_INTERVALS_BUFFER_LENGTH)
+                storeLongInterval(irparams.rawlen, tTickCounterForISR);
+#  endif
                 tTickCounterForISR = UINT8_MAX;
             }
 #endif
             irparams.rawbuf[irparams.rawlen++] = tTickCounterForISR; // record mark
+#if defined(USE_PROTOCOL_SPECIFIC_FRAME_GAP)
+            if (irparams.rawlen == 6) {
+                setProtocolSpecificFrameGap(); // 3 marks and 2 spaces are recorded
+            }
+#endif
             irparams.StateForISR = IR_REC_STATE_SPACE;
             irparams.TickCounterForISR = 0; // This resets the tick counter also at end of frame :-)
         }
@@ -192,7 +267,7 @@ void IRrecv::ReceiveInterruptHandler() {
          * Timing space here, rawlen is odd
          * Check for timeout or overflow
          */
-        if (tTickCounterForISR > RECORD_GAP_TICKS || irparams.rawlen >= RAW_BUFFER_LENGTH - 1) {
+        if (tTickCounterForISR > FRAME_GAP_TICKS || irparams.rawlen >= RAW_BUFFER_LENGTH - 1) {
             if (irparams.rawlen >= RAW_BUFFER_LENGTH) {
                 // Flag up a read OverflowFlag; Stop the state machine
                 irparams.OverflowFlag = true;
@@ -226,7 +301,17 @@ void IRrecv::ReceiveInterruptHandler() {
                 irparams.ReceiveCompleteCallbackFunction();
             }
 #endif
-        } else if (tIRInputLevel == INPUT_MARK) {
+        } else
+#if defined(MINIMUM_PULSE_TICKS)
+        if (tIRInputLevel == INPUT_MARK && tTickCounterForISR < MINIMUM_PULSE_TICKS) {
+            /*
+             * Glitch space ended here. Merge it with the preceding mark and continue timing this mark.
+             */
+            irparams.TickCounterForISR = tTickCounterForISR + getRawbufTicks(--irparams.rawlen);
+            irparams.StateForISR = IR_REC_STATE_MARK;
+        } else
+#endif
+        if (tIRInputLevel == INPUT_MARK) {
             /*
              * Space ended here.
              */
@@ -237,6 +322,9 @@ void IRrecv::ReceiveInterruptHandler() {
 #if !defined(USE_16_BIT_TIMING_BUFFER)
             // Clip timings > 12750 us (255 * 50) to 12750
             if (tTickCounterForISR > UINT8_MAX) {
+#  if defined(LONG_INTERVALS_BUFFER_LENGTH)
+                storeLongInterval(irparams.rawlen, tTickCounterForISR);
+#  endif
                 tTickCounterForISR = UINT8_MAX;
             }
 #endif
@@ -301,6 +389,323 @@ ISR()
 }
 #endif
 
+/**********************************************************************************************************************
+ * Capture backends
+ * The polling timer ISR above is the default backend. It samples the input every 50 us and writes the tick counts directly into rawbuf.
+ * All other backends supply the durations of completed marks and spaces to feedCapturedDuration(),
+ * which runs the same state machine and fills rawbuf for the decoders.
+ * - Edge capture: USE_EDGE_CAPTURE_FOR_RECEIVE uses a pin change interrupt and micros() instead of the 50 us timer interrupt.
+ * - Replay: replayRawFrame() feeds a recorded frame at full speed, e.g. to test decoders on a host or build server.
+ **********************************************************************************************************************/
+/**
+ * Common sink for all capture backends except the polling timer.
+ * Feeds the duration of a completed mark or space into the receive state machine.
+ * A space longer than RECORD_GAP_TICKS is the gap before a new frame or ends the current frame.
+ * With USE_PROTOCOL_SPECIFIC_FRAME_GAP, the current frame is ended by a space longer than irparams.FrameGapTicks.
+ * @param aDurationTicks  Duration in ticks of MICROS_PER_TICK. Is clipped to the range of rawbuf.
+ * @param aIsMark         True if the duration was a mark
+ */
+#if defined(ESP8266) || defined(ESP32)
+IRAM_ATTR
+#endif
+void IRrecv::feedCapturedDuration(uint_fast16_t aDurationTicks, bool aIsMark) {
+#if defined(MINIMUM_PULSE_TICKS)
+    /*
+     * TickCounterForISR is not required for the capture backends, so it holds the ticks of a merged glitch
+     * and the merged interval before the glitch, which must be added to this duration.
+     */
+    aDurationTicks += irparams.TickCounterForISR;
+    irparams.TickCounterForISR = 0;
+#endif
+    uint_fast8_t tStateForISR = irparams.StateForISR;
+    if (tStateForISR == IR_REC_STATE_IDLE) {
+        /*
+         * Wait for the gap before the first mark
+         */
+        if (!aIsMark && aDurationTicks > RECORD_GAP_TICKS) {
+            irparams.OverflowFlag = false;
+            irparams.initialGapTicks = aDurationTicks;
+            irparams.rawlen = 1;
+#if defined(LONG_INTERVALS_BUFFER_LENGTH)
+            irparams.NumberOfLongIntervals = 0;
+#endif
+#if defined(USE_PROTOCOL_SPECIFIC_FRAME_GAP)
+            irparams.FrameGapTicks = RECORD_GAP_TICKS;
+#endif
+            irparams.StateForISR = IR_REC_STATE_MARK;
+        }
+
+    } else if (tStateForISR == IR_REC_STATE_MARK || tStateForISR == IR_REC_STATE_SPACE) {
+        if (!aIsMark && aDurationTicks > FRAME_GAP_TICKS) {
+            // The gap after the last mark, which was not yet detected by checkForCapturedFrameTimeout()
+            handleCapturedFrameEnd();
+            return;
+        }
+        if (aIsMark != (tStateForISR == IR_REC_STATE_MARK)) {
+            return; // We missed an edge, skip this duration
+        }
+#if defined(MINIMUM_PULSE_TICKS)
+        if (aDurationTicks < MINIMUM_PULSE_TICKS) {
+            /*
+             * Glitch. Merge it with the preceding interval, which is continued by the next duration.
+             * A glitch as first mark of a frame is discarded and the gap is continued in idle state.
+             */
+            if (irparams.rawlen > 1) {
+                irparams.TickCounterForISR = aDurationTicks + getRawbufTicks(--irparams.rawlen);
+                irparams.StateForISR = aIsMark ? IR_REC_STATE_SPACE : IR_REC_STATE_MARK;
+            } else {
+                irparams.TickCounterForISR = irparams.initialGapTicks;
+                irparams.StateForISR = IR_REC_STATE_IDLE;
+            }
+            return;
+        }
+#endif
+#if !defined(USE_16_BIT_TIMING_BUFFER)
+        // Clip timings > 12750 us (255 * 50) to 12750
+        if (aDurationTicks > UINT8_MAX) {
+#  if defined(LONG_INTERVALS_BUFFER_LENGTH)
+            storeLongInterval(irparams.rawlen, aDurationTicks);
+#  endif
+            aDurationTicks = UINT8_MAX;
+        }
+#endif
+        irparams.rawbuf[irparams.rawlen++] = aDurationTicks;
+        if (aIsMark) {
+#if defined(USE_PROTOCOL_SPECIFIC_FRAME_GAP)
+            if (irparams.rawlen == 6) {
+                setProtocolSpecificFrameGap();
+            }
+#endif
+            irparams.StateForISR = IR_REC_STATE_SPACE;
+            if (irparams.rawlen >= RAW_BUFFER_LENGTH) {
+                irparams.OverflowFlag = true;
+                handleCapturedFrameEnd();
+            }
+        } else {
+            irparams.StateForISR = IR_REC_STATE_MARK;
+        }
+    }
+    // Nothing to do for IR_REC_STATE_STOP
+}
+
+/**
+ * Ends the current frame and signals it to decode() and the receive complete callback.
+ * Does the same as the polling timer ISR on detection of the gap.
+ */
+#if defined(ESP8266) || defined(ESP32)
+IRAM_ATTR
+#endif
+void IRrecv::handleCapturedFrameEnd() {
+    decodedIRData.initialGapTicks = irparams.initialGapTicks;
+    decodedIRData.rawlen = irparams.rawlen;
+    irparams.StateForISR = IR_REC_STATE_STOP; // This signals the decode(), that a complete frame was received
+#if !defined(IR_REMOTE_DISABLE_RECEIVE_COMPLETE_CALLBACK)
+    if (irparams.ReceiveCompleteCallbackFunction != nullptr) {
+        irparams.ReceiveCompleteCallbackFunction();
+    }
+#endif
+}
+
+#if defined(USE_PROTOCOL_SPECIFIC_FRAME_GAP)
+/**
+ * Called by the receive state machine after the 3. mark of a frame was recorded, i.e. at the start of the 3. space.
+ * Protocols with a space longer than RECORD_GAP_MICROS set irparams.FrameGapTicks to a greater value here,
+ * if they recognize their start bits. Must be short, since it runs in the ISR.
+ */
+#if defined(ESP8266) || defined(ESP32)
+IRAM_ATTR
+#endif
+void IRrecv::setProtocolSpecificFrameGap() {
+    checkForBangOlufsenFrameStart(); // The 3. start space of B&O is 15.6 ms
+}
+#endif
+
+/**
+ * Replay backend. Feeds a complete frame with a preceding gap at full speed into the receive state machine.
+ * After return, available() is true and decode() can be called.
+ * Call stop() before, to avoid interference with the receive interrupt.
+ * @param aDurationsMicros  Array of mark and space durations starting with a mark, as printed by printIRResultAsCArray(). Must be in RAM.
+ * @param aNumberOfDurations Number of entries in aDurationsMicros. A trailing space is ignored. If 0, nothing is replayed.
+ * @param aGapMicros        The gap before the frame. Is used for repeat detection. Values below RECORD_GAP_MICROS are increased to RECORD_GAP_MICROS.
+ */
+void IRrecv::replayRawFrame(const uint16_t *aDurationsMicros, IRRawlenType aNumberOfDurations, uint32_t aGapMicros) {
+    irparams.StateForISR = IR_REC_STATE_IDLE;
+#if defined(MINIMUM_PULSE_TICKS)
+    irparams.TickCounterForISR = 0; // no glitch of a previous frame pending
+#endif
+    if (aNumberOfDurations == 0) {
+        return; // Nothing to replay, available() stays false
+    }
+
+    uint32_t tGapTicks = aGapMicros / MICROS_PER_TICK;
+    if (tGapTicks <= RECORD_GAP_TICKS) {
+        tGapTicks = RECORD_GAP_TICKS + 1;
+    } else if (tGapTicks > UINT16_MAX) {
+        tGapTicks = UINT16_MAX;
+    }
+    feedCapturedDuration(tGapTicks, false);
+
+    if (!(aNumberOfDurations & 1)) {
+        aNumberOfDurations--; // A trailing space is part of the gap after the frame and never recorded by a real receiver
+    }
+    for (IRRawlenType i = 0; i < aNumberOfDurations && irparams.StateForISR != IR_REC_STATE_STOP; ++i) {
+        // rounding, since the values are not quantized to ticks like the received values
+        feedCapturedDuration((aDurationsMicros[i] + (MICROS_PER_TICK / 2)) / MICROS_PER_TICK, !(i & 1));
+    }
+    if (irparams.StateForISR != IR_REC_STATE_STOP) {
+        handleCapturedFrameEnd();
+    }
+}
+
+#if defined(USE_EDGE_CAPTURE_FOR_RECEIVE)
+unsigned long sMicrosOfLastCaptureEdge;
+
+/**
+ * Edge capture backend. Called at each level change of the receive pin.
+ * The level after the change determines, if the finished duration was a mark or a space.
+ */
+#if defined(ESP8266) || defined(ESP32)
+IRAM_ATTR
+#endif
+void IRrecv::EdgeInterruptHandler() {
+    unsigned long tMicros = micros();
+#if defined(__AVR__)
+    uint8_t tIRInputLevel = *irparams.IRReceivePinPortInputRegister & irparams.IRReceivePinMask;
+#else
+    uint_fast8_t tIRInputLevel = (uint_fast8_t) digitalReadFast(irparams.IRReceivePin);
+#endif
+    uint32_t tDurationTicks = ((tMicros - sMicrosOfLastCaptureEdge) + (MICROS_PER_TICK / 2)) / MICROS_PER_TICK;
+    if (tDurationTicks > UINT16_MAX) {
+        tDurationTicks = UINT16_MAX;
+    }
+    sMicrosOfLastCaptureEdge = tMicros;
+
+#if !defined(IR_REMOTE_DISABLE_RECEIVE_COMPLETE_CALLBACK)
+    bool tWasIdle = irparams.StateForISR == IR_REC_STATE_IDLE;
+#endif
+    feedCapturedDuration(tDurationTicks, tIRInputLevel != INPUT_MARK);
+
+#if !defined(IR_REMOTE_DISABLE_RECEIVE_COMPLETE_CALLBACK)
+    /*
+     * There is no next edge after the last mark of a frame, which could detect the gap.
+     * So the timer must call the callback, since the application may not poll with available() or decode().
+     * It is started at the first mark of a frame and stops itself after the frame.
+     */
+    if (tWasIdle && irparams.StateForISR == IR_REC_STATE_MARK && irparams.ReceiveCompleteCallbackFunction != nullptr) {
+        timerEnableReceiveInterrupt();
+    }
+#endif
+
+#if defined(LED_RECEIVE_FEEDBACK_CODE)
+    if (FeedbackLEDControl.LedFeedbackEnabled) {
+        setFeedbackLED(tIRInputLevel == INPUT_MARK);
+    }
+#endif
+}
+
+#if defined(ESP8266) || defined(ESP32)
+IRAM_ATTR
+#endif
+void IRReceiveEdgeInterruptHandler() {
+    IrReceiver.EdgeInterruptHandler();
+}
+
+void enableEdgeCaptureForReceive() {
+#if !defined(IR_REMOTE_DISABLE_RECEIVE_COMPLETE_CALLBACK)
+    if (IrReceiver.irparams.ReceiveCompleteCallbackFunction != nullptr) {
+        timerConfigForReceive(); // e.g. after sending with the receive timer. The interrupt is enabled at the edges of a frame.
+    }
+#endif
+    attachInterrupt(digitalPinToInterrupt(IrReceiver.irparams.IRReceivePin), IRReceiveEdgeInterruptHandler, CHANGE);
+}
+void disableEdgeCaptureForReceive() {
+    detachInterrupt(digitalPinToInterrupt(IrReceiver.irparams.IRReceivePin));
+#if !defined(IR_REMOTE_DISABLE_RECEIVE_COMPLETE_CALLBACK)
+    if (IrReceiver.irparams.ReceiveCompleteCallbackFunction != nullptr) {
+        timerDisableReceiveInterrupt(); // in case it runs for the receive complete callback
+    }
+#endif
+}
+
+/**
+ * Ends the frame, if the last edge was a mark end and is longer ago than the frame gap.
+ * Called by the timer ISR, which runs only during a frame and only if a receive complete callback is registered.
+ */
+#if defined(ESP8266) || defined(ESP32)
+IRAM_ATTR
+#endif
+void IRrecv::handleCapturedFrameTimeout() {
+    if (irparams.StateForISR == IR_REC_STATE_SPACE && (micros() - sMicrosOfLastCaptureEdge) > FRAME_GAP_MICROS) {
+        handleCapturedFrameEnd();
+    }
+}
+
+/**
+ * Without a receive complete callback, there is no timer, which can detect the gap after the last mark of a frame.
+ * So we check for it, if the main loop asks for a frame.
+ */
+void IRrecv::checkForCapturedFrameTimeout() {
+    if (irparams.StateForISR == IR_REC_STATE_SPACE) {
+        noInterrupts();
+        handleCapturedFrameTimeout();
+        interrupts();
+    }
+}
+#endif // defined(USE_EDGE_CAPTURE_FOR_RECEIVE)
+
+#if defined(USE_LOW_POWER_IDLE_FOR_RECEIVE)
+/**
+ * Adds the ticks, the timer was parked, to the gap counter. Does not enable the timer.
+ */
+#if defined(ESP8266) || defined(ESP32)
+IRAM_ATTR
+#endif
+void unparkReceiveTimer() {
+    sReceiveTimerIsParked = false;
+    uint32_t tTickCounter = IrReceiver.irparams.TickCounterForISR
+            + ((micros() - sMicrosAtReceiveTimerParking) / MICROS_PER_TICK);
+    if (tTickCounter > UINT16_MAX) {
+        tTickCounter = UINT16_MAX; // as the clipping in ReceiveInterruptHandler()
+    }
+    IrReceiver.irparams.TickCounterForISR = tTickCounter;
+}
+
+/**
+ * Is attached by the receive timer ISR when parking and called at the first mark of the next frame.
+ * Detaches itself, since a LOW level interrupt would be called again and again during the mark.
+ * The flag is checked, because sending may have disabled the receive timer after parking.
+ */
+#if defined(ESP8266) || defined(ESP32)
+IRAM_ATTR
+#endif
+void IRReceiveWakeupInterruptHandler() {
+    detachInterrupt(digitalPinToInterrupt(IrReceiver.irparams.IRReceivePin));
+    if (sReceiveTimerIsParked) {
+        unparkReceiveTimer();
+        timerEnableReceiveInterrupt(); // The mark is sampled by the next tick
+    }
+}
+
+/**
+ * Detaches the wake up interrupt and adds the ticks, the timer was parked, to the gap.
+ * Called before the receive timer is enabled or disabled by start(), stop() etc.
+ */
+void disableWakeupForReceive() {
+    detachInterrupt(digitalPinToInterrupt(IrReceiver.irparams.IRReceivePin));
+    if (sReceiveTimerIsParked) {
+        unparkReceiveTimer(); // keep the gap up to now for restartTimer()
+    }
+}
+
+/**
+ * @return true if the receive timer is stopped, because the receiver waits for the first edge of the next frame.
+ * Then a sleep mode can be entered, which is woken up by the pin change interrupt of the receive pin.
+ */
+bool IRrecv::isReceiveTimerParked() {
+    return sReceiveTimerIsParked;
+}
+#endif // defined(USE_LOW_POWER_IDLE_FOR_RECEIVE)
+
 /**********************************************************************************************************************
  * Stream like API
  **********************************************************************************************************************/
@@ -365,12 +770,38 @@ void IRrecv::setReceivePin(uint_fast8_t aReceivePinNumber) {
     }
 }
 
+#if defined(USE_RUNTIME_MICROS_PER_TICK)
+/**
+ * Sets the resolution of the receive timer and of the rawbuf values. Must be called before begin() or start().
+ * Ticks of a previous resolution, e.g. in binary records, are no longer valid.
+ * @param aMicrosPerTick 10 to 100, other values are clipped to this range.
+ *                       For values below 50 the CPU must be fast enough, to handle an interrupt every aMicrosPerTick.
+ */
+void IRrecv::setMicrosPerTick(uint8_t aMicrosPerTick) {
+    if (aMicrosPerTick < MINIMUM_MICROS_PER_TICK) {
+        aMicrosPerTick = MINIMUM_MICROS_PER_TICK; // 0 would divide by zero
+    } else if (aMicrosPerTick > MAXIMUM_MICROS_PER_TICK) {
+        aMicrosPerTick = MAXIMUM_MICROS_PER_TICK;
+    }
+    sMicrosPerTick = aMicrosPerTick;
+    sRecordGapTicks = RECORD_GAP_MICROS / aMicrosPerTick;
+#  if defined(MINIMUM_PULSE_MICROS)
+    sMinimumPulseTicks = MINIMUM_PULSE_MICROS / aMicrosPerTick;
+#  endif
+}
+#endif
+
 #if !defined(IR_REMOTE_DISABLE_RECEIVE_COMPLETE_CALLBACK)
 /**
  * Sets the function to call if a complete protocol frame has arrived
  */
 void IRrecv::registerReceiveCompleteCallback(void (*aReceiveCompleteCallbackFunction)(void)) {
     irparams.ReceiveCompleteCallbackFunction = aReceiveCompleteCallbackFunction;
+#  if defined(USE_EDGE_CAPTURE_FOR_RECEIVE)
+    if (aReceiveCompleteCallbackFunction != nullptr) {
+        timerConfigForReceive(); // The timer detects the end of the frame for the callback. Its interrupt is enabled at the edges of a frame.
+    }
+#  endif
 }
 #endif
 
@@ -381,6 +812,10 @@ void IRrecv::registerReceiveCompleteCallback(void (*aReceiveCompleteCallbackFunc
  */
 void IRrecv::start() {
 
+#if defined(USE_EDGE_CAPTURE_FOR_RECEIVE)
+    resume();
+    enableEdgeCaptureForReceive();
+#else
     // Setup for cyclic 50 us interrupt
     timerConfigForReceive(); // no interrupts enabled here!
 
@@ -388,7 +823,11 @@ void IRrecv::start() {
     resume();
 
     // Timer interrupt is enabled after state machine reset
+#  if defined(USE_LOW_POWER_IDLE_FOR_RECEIVE)
+    disableWakeupForReceive(); // the timer is enabled below
+#  endif
     timerEnableReceiveInterrupt(); // Enables the receive sample timer interrupt which consumes a small amount of CPU every 50 us.
+#endif
 #ifdef _IR_MEASURE_TIMING
     pinModeFast(_IR_TIMING_TEST_PIN, OUTPUT);
 #endif
@@ -398,6 +837,10 @@ void IRrecv::start() {
  * Restarts timer interrupts, adjusts TickCounterForISR for correct gap value after stopTimer(). Does not call resume()!
  */
 void IRrecv::restartTimer() {
+#if defined(USE_EDGE_CAPTURE_FOR_RECEIVE)
+    enableEdgeCaptureForReceive(); // gap is computed by micros(), so no adjustment required
+    return;
+#endif
     // Setup for cyclic 50 us interrupt
     timerConfigForReceive(); // no interrupts enabled here!
     // Timer interrupt is enabled after state machine reset
@@ -405,6 +848,9 @@ void IRrecv::restartTimer() {
         irparams.TickCounterForISR += (micros() - sMicrosAtLastStopTimer) / MICROS_PER_TICK; // adjust TickCounterForISR for correct gap value, which is used for repeat detection
         sMicrosAtLastStopTimer = 0;
     }
+#if defined(USE_LOW_POWER_IDLE_FOR_RECEIVE)
+    disableWakeupForReceive(); // the timer is enabled below
+#endif
     timerEnableReceiveInterrupt(); // Enables the receive sample timer interrupt which consumes a small amount of CPU every 50 us.
 #ifdef _IR_MEASURE_TIMING
     pinModeFast(_IR_TIMING_TEST_PIN, OUTPUT);
@@ -428,8 +874,16 @@ void IRrecv::enableIRIn() {
  * @param aMicrosecondsToAddToGapCounter To compensate for the amount of microseconds the timer was stopped / disabled.
  */
 void IRrecv::restartTimer(uint32_t aMicrosecondsToAddToGapCounter) {
+#if defined(USE_EDGE_CAPTURE_FOR_RECEIVE)
+    (void) aMicrosecondsToAddToGapCounter;
+    enableEdgeCaptureForReceive();
+    return;
+#endif
     irparams.TickCounterForISR += aMicrosecondsToAddToGapCounter / MICROS_PER_TICK;
     timerConfigForReceive(); // no interrupts enabled here!
+#if defined(USE_LOW_POWER_IDLE_FOR_RECEIVE)
+    disableWakeupForReceive(); // the timer is enabled below
+#endif
     timerEnableReceiveInterrupt(); // Enables the receive sample timer interrupt which consumes a small amount of CPU every 50 us.
 #ifdef _IR_MEASURE_TIMING
     pinModeFast(_IR_TIMING_TEST_PIN, OUTPUT);
@@ -440,8 +894,16 @@ void IRrecv::restartTimer(uint32_t aMicrosecondsToAddToGapCounter) {
  * @param aTicksToAddToGapCounter To compensate for the amount of ticks the timer was stopped / disabled.
  */
 void IRrecv::restartTimerWithTicksToAdd(uint16_t aTicksToAddToGapCounter) {
+#if defined(USE_EDGE_CAPTURE_FOR_RECEIVE)
+    (void) aTicksToAddToGapCounter;
+    enableEdgeCaptureForReceive();
+    return;
+#endif
     irparams.TickCounterForISR += aTicksToAddToGapCounter;
     timerConfigForReceive(); // no interrupts enabled here!
+#if defined(USE_LOW_POWER_IDLE_FOR_RECEIVE)
+    disableWakeupForReceive(); // the timer is enabled below
+#endif
     timerEnableReceiveInterrupt(); // Enables the receive sample timer interrupt which consumes a small amount of CPU every 50 us.
 #ifdef _IR_MEASURE_TIMING
     pinModeFast(_IR_TIMING_TEST_PIN, OUTPUT);
@@ -464,15 +926,29 @@ void IRrecv::restartAfterSend() {
  * Disables the timer for IR reception.
  */
 void IRrecv::stop() {
+#if defined(USE_EDGE_CAPTURE_FOR_RECEIVE)
+    disableEdgeCaptureForReceive();
+#else
+#  if defined(USE_LOW_POWER_IDLE_FOR_RECEIVE)
+    disableWakeupForReceive(); // before disabling the timer, to avoid a restart by the wake up interrupt
+#  endif
     timerDisableReceiveInterrupt();
+#endif
 }
 
 /*
  * Stores microseconds of stop, to adjust TickCounterForISR in restartTimer()
  */
 void IRrecv::stopTimer() {
+#if defined(USE_EDGE_CAPTURE_FOR_RECEIVE)
+    disableEdgeCaptureForReceive();
+#else
+#  if defined(USE_LOW_POWER_IDLE_FOR_RECEIVE)
+    disableWakeupForReceive();
+#  endif
     timerDisableReceiveInterrupt();
     sMicrosAtLastStopTimer = micros();
+#endif
 }
 /**
  * Alias for stop().
@@ -503,8 +979,15 @@ void IRrecv::resume() {
  * Must be used to setup data, if you call decoders manually.
  */
 void IRrecv::initDecodedIRData() {
+    initDecodedIRData(irparams.OverflowFlag);
+}
 
-    if (irparams.OverflowFlag) {
+/**
+ * @param aWasOverflow  If true, IRDATA_FLAGS_WAS_OVERFLOW is set and the last decoded data for repeat detection is kept.
+ */
+void IRrecv::initDecodedIRData(bool aWasOverflow) {
+
+    if (aWasOverflow) {
         decodedIRData.flags = IRDATA_FLAGS_WAS_OVERFLOW;
 
         DEBUG_PRINT(F("Overflow happened, try to increase the \"RAW_BUFFER_LENGTH\" value of "));
@@ -537,6 +1020,9 @@ bool IRrecv::isIdle() {
  * Returns true if IR receiver has received a complete IR frame (detected by timeout after last mark).
  */
 bool IRrecv::available() {
+#if defined(USE_EDGE_CAPTURE_FOR_RECEIVE)
+    checkForCapturedFrameTimeout();
+#endif
     return (irparams.StateForISR == IR_REC_STATE_STOP);
 }
 
@@ -544,6 +1030,9 @@ bool IRrecv::available() {
  * Returns pointer to IrReceiver.decodedIRData if IR receiver data is available, else nullptr.
  */
 IRData* IRrecv::read() {
+#if defined(USE_EDGE_CAPTURE_FOR_RECEIVE)
+    checkForCapturedFrameTimeout();
+#endif
     if (irparams.StateForISR != IR_REC_STATE_STOP) {
         return nullptr;
     }
@@ -561,9 +1050,13 @@ IRData* IRrecv::read() {
  * @return false if no IR receiver data available, true if data available.
  */
 bool IRrecv::decode() {
+#if defined(USE_EDGE_CAPTURE_FOR_RECEIVE)
+    checkForCapturedFrameTimeout();
+#endif
     if (irparams.StateForISR != IR_REC_STATE_STOP) {
         return false;
     }
+    rawbufForDecode = irparams.rawbuf;
 
     /*
      * Support for old examples, which do not use the default IrReceiver instance
@@ -582,31 +1075,98 @@ bool IRrecv::decode() {
         decodedIRData.protocol = UNKNOWN;
         return true;
     }
+    return callDecoders();
+}
+
+/**
+ * Decodes a frame, which is not stored in irparams.rawbuf, e.g. the buffer of another receiver,
+ * a stored capture or the content of a file on host. The frame is not copied and the same decoders as for decode() are used.
+ * irparams and the rawlen and initialGapTicks of decodedIRData, which belong to the frame recorded by the ISR, are not changed.
+ * The other values of decodedIRData and the data for repeat detection are updated like by decode(),
+ * to enable repeat detection for a sequence of frames decoded by this function.
+ * @param aFrameView    The frame to decode. Its MicrosPerTick must be MICROS_PER_TICK.
+ * @param aIRData       Receives the decoded data. Its rawlen and initialGapTicks are taken from aFrameView.
+ * @return false if the frame cannot be decoded, because its resolution is not MICROS_PER_TICK.
+ */
+bool IRrecv::decode(const IRFrameView &aFrameView, IRData &aIRData) {
+    if (aFrameView.MicrosPerTick != MICROS_PER_TICK) {
+        return false;
+    }
+    IRRawlenType tRawlenOfReceivedFrame = decodedIRData.rawlen;
+    uint16_t tInitialGapTicksOfReceivedFrame = decodedIRData.initialGapTicks;
+
+    rawbufForDecode = aFrameView.RawbufPtr;
+#if defined(LONG_INTERVALS_BUFFER_LENGTH)
+    longIntervalsForDecode = aFrameView.LongIntervalsPtr;
+    numberOfLongIntervalsForDecode = aFrameView.NumberOfLongIntervals;
+#endif
+    decodedIRData.rawlen = aFrameView.Rawlen;
+    decodedIRData.initialGapTicks = aFrameView.InitialGapTicks;
+    initDecodedIRData(false); // irparams.OverflowFlag belongs to the frame recorded by the ISR
+
+    callDecoders();
+
+    aIRData = decodedIRData;
+    rawbufForDecode = irparams.rawbuf;
+    decodedIRData.rawlen = tRawlenOfReceivedFrame;
+    decodedIRData.initialGapTicks = tInitialGapTicksOfReceivedFrame;
+    return true;
+}
+
+/**
+ * Calls all decoders enabled at compile time and at runtime, until one decoder returns true.
+ * The decoders read the frame from rawbufForDecode and decodedIRData.rawlen.
+ * @return Always true, to let the loop decide to call resume or to print raw data.
+ */
+bool IRrecv::callDecoders() {
+#if defined(SUPPORT_RUNTIME_PROTOCOL_SELECTION)
+#define DECODER_IS_ENABLED(aProtocolMask)   (enabledProtocolsMask & (aProtocolMask))
+    DecoderStateStruct tDecoderState;
+    saveDecoderState(&tDecoderState);
+#  if defined(SUPPORT_DECODER_PROFILING)
+#define DECODER_STATE_FOR_PROFILING         (&tDecoderState)
+#define DECODED_PROTOCOL_IS_ENABLED         true // Checked by callAndProfileDecoder(), to count a disabled result as miss
+#  else
+#define DECODED_PROTOCOL_IS_ENABLED         checkDecodedProtocolIsEnabled(&tDecoderState)
+#  endif
+#else
+#define DECODER_IS_ENABLED(aProtocolMask)   true
+#define DECODED_PROTOCOL_IS_ENABLED         true
+#define DECODER_STATE_FOR_PROFILING         nullptr
+#endif
+#if defined(SUPPORT_DECODER_PROFILING)
+#define CALL_DECODER(aProtocol, aDecoderFunction)   callAndProfileDecoder(DECODER_INDEX_##aProtocol, aProtocol, &IRrecv::aDecoderFunction, \
+        DECODER_STATE_FOR_PROFILING)
+#else
+#define CALL_DECODER(aProtocol, aDecoderFunction)   aDecoderFunction()
+#endif
 
 #if defined(DECODE_NEC) || defined(DECODE_ONKYO)
     TRACE_PRINTLN(F("Attempting NEC/Onkyo decode"));
-    if (decodeNEC()) {
+    if (DECODER_IS_ENABLED(PROTOCOL_MASK(NEC) | PROTOCOL_MASK(NEC2) | PROTOCOL_MASK(ONKYO) | PROTOCOL_MASK(APPLE))
+            && CALL_DECODER(NEC, decodeNEC) && DECODED_PROTOCOL_IS_ENABLED) {
         return true;
     }
 #endif
 
 #if defined(DECODE_KASEIKYO)
     TRACE_PRINTLN(F("Attempting Panasonic/Kaseikyo decode"));
-    if (decodeKaseikyo()) {
+    if (DECODER_IS_ENABLED(PROTOCOL_MASK(PANASONIC) | PROTOCOL_MASK(KASEIKYO) | PROTOCOL_MASK(KASEIKYO_DENON) | PROTOCOL_MASK(KASEIKYO_SHARP)
+            | PROTOCOL_MASK(KASEIKYO_JVC) | PROTOCOL_MASK(KASEIKYO_MITSUBISHI)) && CALL_DECODER(KASEIKYO, decodeKaseikyo) && DECODED_PROTOCOL_IS_ENABLED) {
         return true;
     }
 #endif
 
 #if defined(DECODE_DENON)
     TRACE_PRINTLN(F("Attempting Denon/Sharp decode"));
-    if (decodeDenon()) {
+    if (DECODER_IS_ENABLED(PROTOCOL_MASK(DENON) | PROTOCOL_MASK(SHARP)) && CALL_DECODER(DENON, decodeDenon) && DECODED_PROTOCOL_IS_ENABLED) {
         return true;
     }
 #endif
 
 #if defined(DECODE_SONY)
     TRACE_PRINTLN(F("Attempting Sony decode"));
-    if (decodeSony()) {
+    if (DECODER_IS_ENABLED(PROTOCOL_MASK(SONY)) && CALL_DECODER(SONY, decodeSony) && DECODED_PROTOCOL_IS_ENABLED) {
         return true;
     }
 #endif
@@ -619,120 +1179,567 @@ bool IRrecv::decode() {
 #  else
     TRACE_PRINTLN(F("Attempting RC5 and Marantz decode"));
 #  endif
-    if (decodeRC5()) {
+    if (DECODER_IS_ENABLED(PROTOCOL_MASK(RC5) | PROTOCOL_MASK(MARANTZ)) && CALL_DECODER(RC5, decodeRC5) && DECODED_PROTOCOL_IS_ENABLED) {
         return true;
     }
 #endif
 
 #if defined(DECODE_RC6)
     TRACE_PRINTLN(F("Attempting RC6 decode"));
-    if (decodeRC6()) {
+    if (DECODER_IS_ENABLED(PROTOCOL_MASK(RC6) | PROTOCOL_MASK(RC6A)) && CALL_DECODER(RC6, decodeRC6) && DECODED_PROTOCOL_IS_ENABLED) {
         return true;
     }
 #endif
 
 #if defined(DECODE_LG)
     TRACE_PRINTLN(F("Attempting LG decode"));
-    if (decodeLG()) {
+    if (DECODER_IS_ENABLED(PROTOCOL_MASK(LG)) && CALL_DECODER(LG, decodeLG) && DECODED_PROTOCOL_IS_ENABLED) {
+        return true;
+    }
+#endif
+
+#if defined(DECODE_JVC)
+    TRACE_PRINTLN(F("Attempting JVC decode"));
+    if (DECODER_IS_ENABLED(PROTOCOL_MASK(JVC)) && CALL_DECODER(JVC, decodeJVC) && DECODED_PROTOCOL_IS_ENABLED) {
+        return true;
+    }
+#endif
+
+#if defined(DECODE_SAMSUNG)
+    TRACE_PRINTLN(F("Attempting Samsung decode"));
+    if (DECODER_IS_ENABLED(PROTOCOL_MASK(SAMSUNG) | PROTOCOL_MASK(SAMSUNGLG) | PROTOCOL_MASK(SAMSUNG48))
+            && CALL_DECODER(SAMSUNG, decodeSamsung) && DECODED_PROTOCOL_IS_ENABLED) {
+        return true;
+    }
+#endif
+    /*
+     * Start of the exotic protocols
+     */
+
+#if defined(DECODE_BEO)
+    TRACE_PRINTLN(F("Attempting Bang & Olufsen decode"));
+    if (DECODER_IS_ENABLED(PROTOCOL_MASK(BANG_OLUFSEN)) && CALL_DECODER(BANG_OLUFSEN, decodeBangOlufsen) && DECODED_PROTOCOL_IS_ENABLED) {
+        return true;
+    }
+#endif
+
+#if defined(DECODE_FAST)
+    TRACE_PRINTLN(F("Attempting FAST decode"));
+    if (DECODER_IS_ENABLED(PROTOCOL_MASK(FAST)) && CALL_DECODER(FAST, decodeFAST) && DECODED_PROTOCOL_IS_ENABLED) {
+        return true;
+    }
+#endif
+
+#if defined(DECODE_WHYNTER)
+    TRACE_PRINTLN(F("Attempting Whynter decode"));
+    if (DECODER_IS_ENABLED(PROTOCOL_MASK(WHYNTER)) && CALL_DECODER(WHYNTER, decodeWhynter) && DECODED_PROTOCOL_IS_ENABLED) {
+        return true;
+    }
+#endif
+
+#if defined(DECODE_LEGO_PF)
+    TRACE_PRINTLN(F("Attempting Lego Power Functions"));
+    if (DECODER_IS_ENABLED(PROTOCOL_MASK(LEGO_PF)) && CALL_DECODER(LEGO_PF, decodeLegoPowerFunctions) && DECODED_PROTOCOL_IS_ENABLED) {
+        return true;
+    }
+#endif
+
+#if defined(DECODE_BOSEWAVE)
+    TRACE_PRINTLN(F("Attempting Bosewave decode"));
+    if (DECODER_IS_ENABLED(PROTOCOL_MASK(BOSEWAVE)) && CALL_DECODER(BOSEWAVE, decodeBoseWave) && DECODED_PROTOCOL_IS_ENABLED) {
+        return true;
+    }
+#endif
+
+#if defined(DECODE_MAGIQUEST)
+    TRACE_PRINTLN(F("Attempting MagiQuest decode"));
+    if (DECODER_IS_ENABLED(PROTOCOL_MASK(MAGIQUEST)) && CALL_DECODER(MAGIQUEST, decodeMagiQuest) && DECODED_PROTOCOL_IS_ENABLED) {
+        return true;
+    }
+#endif
+
+#if defined(DECODE_OPENLASIR)
+    TRACE_PRINTLN(F("Attempting OpenLASIR decode"));
+    if (DECODER_IS_ENABLED(PROTOCOL_MASK(OPENLASIR)) && CALL_DECODER(OPENLASIR, decodeOpenLASIR) && DECODED_PROTOCOL_IS_ENABLED) {
+        return true;
+    }
+#endif
+
+    /*
+     * Try the universal decoder for pulse distance protocols
+     */
+#if defined(DECODE_DISTANCE_WIDTH)
+    TRACE_PRINTLN(F("Attempting universal Distance Width decode"));
+    if (DECODER_IS_ENABLED(PROTOCOL_MASK(PULSE_WIDTH) | PROTOCOL_MASK(PULSE_DISTANCE))
+            && CALL_DECODER(PULSE_DISTANCE, decodeDistanceWidth) && DECODED_PROTOCOL_IS_ENABLED) {
         return true;
     }
 #endif
 
-#if defined(DECODE_JVC)
-    TRACE_PRINTLN(F("Attempting JVC decode"));
-    if (decodeJVC()) {
-        return true;
-    }
+    /*
+     * Last resort is the universal hash decode which always return true
+     */
+#if defined(DECODE_HASH)
+    TRACE_PRINTLN(F("Hash decode"));
+    // decodeHash returns a hash on any input.
+    // Thus, it needs to be last in the list.
+    // If you add any decodes, add them before this.
+    if (DECODER_IS_ENABLED(PROTOCOL_MASK(UNKNOWN)) && CALL_DECODER(UNKNOWN, decodeHash) && DECODED_PROTOCOL_IS_ENABLED) {
+        return true;
+    }
+#endif
+
+    /*
+     * Return true here, to let the loop decide to call resume or to print raw data.
+     */
+    return true;
+}
+#undef DECODER_IS_ENABLED
+#undef DECODED_PROTOCOL_IS_ENABLED
+#undef DECODER_STATE_FOR_PROFILING
+#undef CALL_DECODER
+
+#if defined(SUPPORT_RUNTIME_PROTOCOL_SELECTION)
+/**
+ * Selects the protocols, which can be returned by decode(). Decoders, which can only return disabled protocols, are not called,
+ * which reduces the decode time for each frame.
+ * Only protocols activated at compile time by DECODE_<Protocol> can be decoded.
+ * @param aProtocolMask Bit mask of PROTOCOL_MASK(<protocol>) values, e.g. PROTOCOL_MASK(NEC) | PROTOCOL_MASK(SONY).
+ *                      PROTOCOL_MASK(UNKNOWN) enables the hash decoder.
+ */
+void IRrecv::setEnabledProtocols(uint32_t aProtocolMask) {
+    enabledProtocolsMask = aProtocolMask;
+}
+void IRrecv::enableProtocol(decode_type_t aProtocol) {
+    enabledProtocolsMask |= PROTOCOL_MASK(aProtocol);
+}
+void IRrecv::disableProtocol(decode_type_t aProtocol) {
+    enabledProtocolsMask &= ~PROTOCOL_MASK(aProtocol);
+}
+bool IRrecv::isProtocolEnabled(decode_type_t aProtocol) {
+    return enabledProtocolsMask & PROTOCOL_MASK(aProtocol);
+}
+
+void IRrecv::saveDecoderState(DecoderStateStruct *aDecoderState) {
+    aDecoderState->Flags = decodedIRData.flags;
+    aDecoderState->RepeatCount = repeatCount;
+    aDecoderState->LastDecodedProtocol = lastDecodedProtocol;
+    aDecoderState->LastDecodedAddress = lastDecodedAddress;
+    aDecoderState->LastDecodedCommand = lastDecodedCommand;
+#  if defined(DECODE_DISTANCE_WIDTH)
+    aDecoderState->LastDecodedRawData = lastDecodedRawData;
+#  endif
+}
+
+/**
+ * A decoder, which can return multiple protocols, may have decoded a disabled one, e.g. ONKYO by decodeNEC().
+ * Then the result is cleared and the state used for repeat detection is restored, to continue with the next decoder
+ * as if the disabled protocol had not been decoded.
+ * @param aDecoderState The state saved by saveDecoderState() before the first decoder was called.
+ */
+bool IRrecv::checkDecodedProtocolIsEnabled(DecoderStateStruct const *aDecoderState) {
+    if (isProtocolEnabled(decodedIRData.protocol)) {
+        return true;
+    }
+    repeatCount = aDecoderState->RepeatCount; // e.g. the Denon autorepeat counter
+    lastDecodedProtocol = aDecoderState->LastDecodedProtocol;
+    lastDecodedAddress = aDecoderState->LastDecodedAddress;
+    lastDecodedCommand = aDecoderState->LastDecodedCommand;
+#  if defined(DECODE_DISTANCE_WIDTH)
+    lastDecodedRawData = aDecoderState->LastDecodedRawData;
+#  endif
+    decodedIRData.protocol = UNKNOWN;
+    decodedIRData.flags = aDecoderState->Flags;
+    decodedIRData.command = 0;
+    decodedIRData.address = 0;
+    decodedIRData.decodedRawData = 0;
+    decodedIRData.numberOfBits = 0;
+    return false;
+}
+#endif
+
+#if defined(SUPPORT_DECODER_PROFILING)
+/**
+ * Calls the decoder and adds its duration to the hit or miss statistics of the decoder.
+ * A result with a protocol disabled by setEnabledProtocols() is discarded and counted as miss.
+ * @param aDecoderIndex Index of the decoder in decoderProfile[].
+ * @param aProtocol     The main protocol of the decoder, which is printed by printDecoderProfile().
+ * @param aDecoderState The state saved by callDecoders() for SUPPORT_RUNTIME_PROTOCOL_SELECTION, else nullptr.
+ */
+bool IRrecv::callAndProfileDecoder(decoder_index_t aDecoderIndex, decode_type_t aProtocol, bool (IRrecv::*aDecoderFunction)(),
+        DecoderStateStruct const *aDecoderState) {
+    uint32_t tStartTimestamp = DECODER_PROFILE_TIMESTAMP();
+    bool tResult = (this->*aDecoderFunction)();
+#if defined(SUPPORT_RUNTIME_PROTOCOL_SELECTION)
+    tResult = tResult && checkDecodedProtocolIsEnabled(aDecoderState);
+#else
+    (void) aDecoderState;
+#endif
+    uint32_t tDuration = DECODER_PROFILE_TIMESTAMP() - tStartTimestamp;
+
+    DecoderProfileStruct *tProfilePtr = &decoderProfile[aDecoderIndex];
+    tProfilePtr->Protocol = aProtocol;
+    tProfilePtr->NumberOfCalls++;
+    if (tResult) {
+        tProfilePtr->NumberOfHits++;
+        tProfilePtr->SumOfHitDurations += tDuration;
+    } else {
+        tProfilePtr->SumOfMissDurations += tDuration;
+    }
+    if (tProfilePtr->MaximumDuration < tDuration) {
+        tProfilePtr->MaximumDuration = tDuration;
+    }
+    return tResult;
+}
+
+void IRrecv::resetDecoderProfile() {
+    memset(decoderProfile, 0, sizeof(decoderProfile));
+}
+
+/**
+ * Prints one line for each decoder called since boot or the last resetDecoderProfile(), in the order the decoders are called by decode().
+ * Decoders returning more than one protocol are listed with their main protocol, e.g. NEC for NEC, NEC2, Onkyo and Apple,
+ * PulseDistance for the universal distance width decoder and UNKNOWN for the hash decoder.
+ * Example: "NEC: calls=20 hits=12 hit sum=1640 miss sum=96 max=152 us"
+ */
+void IRrecv::printDecoderProfile(Print *aSerial) {
+    for (uint_fast8_t i = 0; i < NUMBER_OF_PROFILED_DECODERS; i++) {
+        DecoderProfileStruct *tProfilePtr = &decoderProfile[i];
+        if (tProfilePtr->NumberOfCalls == 0) {
+            continue;
+        }
+        aSerial->print(::getProtocolString(tProfilePtr->Protocol));
+        aSerial->print(F(": calls="));
+        aSerial->print(tProfilePtr->NumberOfCalls);
+        aSerial->print(F(" hits="));
+        aSerial->print(tProfilePtr->NumberOfHits);
+        aSerial->print(F(" hit sum="));
+        aSerial->print(tProfilePtr->SumOfHitDurations);
+        aSerial->print(F(" miss sum="));
+        aSerial->print(tProfilePtr->SumOfMissDurations);
+        aSerial->print(F(" max="));
+        aSerial->print(tProfilePtr->MaximumDuration);
+        aSerial->println(F(" " DECODER_PROFILE_UNIT_STRING));
+    }
+}
+#endif
+
+#if defined(SUPPORT_RECEIVER_CALIBRATION)
+/**********************************************************************************************************************
+ * Receiver calibration
+ * Production self test example: A reference transmitter sends 20 NEC frames, each of them is decoded and added to the statistics
+ * by IrReceiver.addToTimingStatistics(&tStatistics, &tExpectedIRData). Then computeReceiverCalibration() computes the values
+ * for this receiver module, which can be checked against limits, stored in EEPROM and applied by setReceiverCalibration().
+ **********************************************************************************************************************/
+/**
+ * Adds the deviations of the marks and spaces of the last decoded frame from the reference durations to aStatistics.
+ * The frame must have been decoded with the current MICROS_PER_TICK, the decoding result itself is not checked.
+ * @param aReferenceDurationsMicros     The sent marks and spaces starting with a mark, like the array for sendRaw().
+ *                                      A trailing space is ignored, since it is not received.
+ * @return false if the number of received marks and spaces differs from the reference, then nothing is added.
+ */
+bool IRrecv::addToTimingStatistics(IRTimingStatistics *aStatistics, const uint16_t *aReferenceDurationsMicros,
+        IRRawlenType aNumberOfReferenceDurations) {
+    if (!(aNumberOfReferenceDurations & 1)) {
+        aNumberOfReferenceDurations--;
+    }
+    if (decodedIRData.rawlen != aNumberOfReferenceDurations + 1) {
+        return false;
+    }
+    aStatistics->NumberOfFrames++;
+    for (IRRawlenType i = 0; i < aNumberOfReferenceDurations; i++) {
+        uint16_t tReferenceMicros = aReferenceDurationsMicros[i];
+        if (aStatistics->MinimumReferenceMicros == 0 || aStatistics->MinimumReferenceMicros > tReferenceMicros) {
+            aStatistics->MinimumReferenceMicros = tReferenceMicros;
+        }
+        int32_t tDeviation = (int32_t) (getRawbufTicksForDecode(i + 1) * MICROS_PER_TICK) - tReferenceMicros;
+        // Clip to the range of the histogram, otherwise a single overflow of the 8 bit buffer dominates the mean
+        const int16_t tHistogramLimit = (TIMING_STATISTICS_NUMBER_OF_BINS / 2) * TIMING_STATISTICS_BIN_MICROS;
+        if (tDeviation < -tHistogramLimit) {
+            tDeviation = -tHistogramLimit;
+        } else if (tDeviation >= tHistogramLimit) {
+            tDeviation = tHistogramLimit - 1;
+        }
+        uint_fast8_t tBin = (tDeviation + tHistogramLimit) / TIMING_STATISTICS_BIN_MICROS;
+        if (i & 1) {
+            aStatistics->NumberOfSpaces++;
+            aStatistics->SumOfSpaceDeviations += tDeviation;
+            aStatistics->SpaceHistogram[tBin]++;
+        } else {
+            aStatistics->NumberOfMarks++;
+            aStatistics->SumOfMarkDeviations += tDeviation;
+            aStatistics->MarkHistogram[tBin]++;
+        }
+    }
+    return true;
+}
+
+#  if defined(SUPPORT_ENCODE_TO_DURATION_SINK)
+/**
+ * Same as above, but the reference durations are generated by IrSender.encode() for the first frame of aReferenceIRData.
+ * Requires 2 * RAW_BUFFER_LENGTH bytes of stack.
+ * @param aReferenceIRData  The sent data, e.g. IRData with protocol NEC, address 0x12 and command 0x34 of the reference transmitter.
+ *                          Use &IrReceiver.decodedIRData, if the decoded values of the frame are known to be correct.
+ */
+bool IRrecv::addToTimingStatistics(IRTimingStatistics *aStatistics, IRData *aReferenceIRData) {
+    uint16_t tReferenceDurations[RAW_BUFFER_LENGTH];
+    IRDurationBuffer tReferenceBuffer(tReferenceDurations, RAW_BUFFER_LENGTH);
+    IrSender.encode(aReferenceIRData, &tReferenceBuffer, NO_REPEATS);
+    if (tReferenceBuffer.hasOverflow) {
+        return false;
+    }
+    return addToTimingStatistics(aStatistics, tReferenceDurations, tReferenceBuffer.NumberOfDurations);
+}
+#  endif
+
+/**
+ * @return The smallest absolute value, which is greater or equal than aPercent percent of the deviations in aHistogram,
+ *         after aOffsetMicros is subtracted from each deviation. The center of a bin is taken as its deviation.
+ */
+uint16_t getPercentileOfAbsoluteDeviation(const uint16_t *aHistogram, uint16_t aNumberOfValues, int16_t aOffsetMicros,
+        uint8_t aPercent) {
+    uint32_t tRequiredNumberOfValues = ((uint32_t) aNumberOfValues * aPercent + 99) / 100;
+    uint16_t tPercentile = UINT16_MAX;
+    for (uint_fast8_t i = 0; i < TIMING_STATISTICS_NUMBER_OF_BINS; i++) {
+        if (aHistogram[i] == 0) {
+            continue;
+        }
+        // Check if the deviation of bin i is a smaller candidate than the current one
+        int16_t tCandidate = (((int16_t) i - (TIMING_STATISTICS_NUMBER_OF_BINS / 2)) * TIMING_STATISTICS_BIN_MICROS)
+                + (TIMING_STATISTICS_BIN_MICROS / 2) - aOffsetMicros;
+        tCandidate = abs(tCandidate);
+        if (tCandidate >= tPercentile) {
+            continue;
+        }
+        uint32_t tNumberOfValues = 0;
+        for (uint_fast8_t j = 0; j < TIMING_STATISTICS_NUMBER_OF_BINS; j++) {
+            int16_t tDeviation = (((int16_t) j - (TIMING_STATISTICS_NUMBER_OF_BINS / 2)) * TIMING_STATISTICS_BIN_MICROS)
+                    + (TIMING_STATISTICS_BIN_MICROS / 2) - aOffsetMicros;
+            if (abs(tDeviation) <= tCandidate) {
+                tNumberOfValues += aHistogram[j];
+            }
+        }
+        if (tNumberOfValues >= tRequiredNumberOfValues) {
+            tPercentile = tCandidate;
+        }
+    }
+    return (tPercentile == UINT16_MAX) ? 0 : tPercentile;
+}
+
+/**
+ * Computes the MARK_EXCESS_MICROS value and the tolerance for the receiver module, which received the frames in aStatistics.
+ * The mark excess is half of the difference of the mean mark and the mean space deviation, like in the ReceiverTimingAnalysis example.
+ * The tolerance is the 99th percentile of the deviations compensated by the mark excess,
+ * relative to the shortest reference duration, plus RECEIVER_CALIBRATION_TOLERANCE_MARGIN_PERCENT.
+ * If aStatistics contains no mark or no space, the current values are returned.
+ */
+void IRrecv::computeReceiverCalibration(const IRTimingStatistics *aStatistics, IRReceiverCalibration *aCalibration) {
+    getReceiverCalibration(aCalibration);
+    if (aStatistics->NumberOfMarks == 0 || aStatistics->NumberOfSpaces == 0) {
+        return;
+    }
+    int16_t tMeanMarkDeviation = aStatistics->SumOfMarkDeviations / aStatistics->NumberOfMarks;
+    int16_t tMeanSpaceDeviation = aStatistics->SumOfSpaceDeviations / aStatistics->NumberOfSpaces;
+    aCalibration->MarkExcessMicros = (tMeanMarkDeviation - tMeanSpaceDeviation) / 2;
+
+    uint16_t tMarkPercentile = getPercentileOfAbsoluteDeviation(aStatistics->MarkHistogram, aStatistics->NumberOfMarks,
+            aCalibration->MarkExcessMicros, 99);
+    uint16_t tSpacePercentile = getPercentileOfAbsoluteDeviation(aStatistics->SpaceHistogram, aStatistics->NumberOfSpaces,
+            -aCalibration->MarkExcessMicros, 99);
+    uint16_t tPercentile = (tMarkPercentile > tSpacePercentile) ? tMarkPercentile : tSpacePercentile;
+    uint32_t tTolerancePercent = (((uint32_t) tPercentile * 100) + aStatistics->MinimumReferenceMicros - 1)
+            / aStatistics->MinimumReferenceMicros + RECEIVER_CALIBRATION_TOLERANCE_MARGIN_PERCENT;
+    if (tTolerancePercent > RECEIVER_CALIBRATION_MAXIMUM_TOLERANCE_PERCENT) {
+        tTolerancePercent = RECEIVER_CALIBRATION_MAXIMUM_TOLERANCE_PERCENT;
+    }
+    aCalibration->TolerancePercent = tTolerancePercent;
+}
+
+/**
+ * Prints the mean and the 99th percentile of the absolute mark and space deviations, and the computed calibration.
+ * The percentiles are computed with the computed mark excess, i.e. they are the remaining deviations after compensation.
+ * Example: "Frames=20 marks=680 spaces=660 shortest reference=560 us
+ *           Mark deviation mean=38 p99=45 us, space deviation mean=-42 p99=45 us
+ *           MARK_EXCESS_MICROS=40 us tolerance=19 %"
+ */
+void IRrecv::printTimingStatistics(const IRTimingStatistics *aStatistics, Print *aSerial) {
+    aSerial->print(F("Frames="));
+    aSerial->print(aStatistics->NumberOfFrames);
+    aSerial->print(F(" marks="));
+    aSerial->print(aStatistics->NumberOfMarks);
+    aSerial->print(F(" spaces="));
+    aSerial->print(aStatistics->NumberOfSpaces);
+    aSerial->print(F(" shortest reference="));
+    aSerial->print(aStatistics->MinimumReferenceMicros);
+    aSerial->println(F(" us"));
+    if (aStatistics->NumberOfMarks == 0 || aStatistics->NumberOfSpaces == 0) {
+        return;
+    }
+    IRReceiverCalibration tCalibration;
+    computeReceiverCalibration(aStatistics, &tCalibration);
+
+    aSerial->print(F("Mark deviation mean="));
+    aSerial->print(aStatistics->SumOfMarkDeviations / aStatistics->NumberOfMarks);
+    aSerial->print(F(" p99="));
+    aSerial->print(
+            getPercentileOfAbsoluteDeviation(aStatistics->MarkHistogram, aStatistics->NumberOfMarks, tCalibration.MarkExcessMicros, 99));
+    aSerial->print(F(" us, space deviation mean="));
+    aSerial->print(aStatistics->SumOfSpaceDeviations / aStatistics->NumberOfSpaces);
+    aSerial->print(F(" p99="));
+    aSerial->print(
+            getPercentileOfAbsoluteDeviation(aStatistics->SpaceHistogram, aStatistics->NumberOfSpaces, -tCalibration.MarkExcessMicros,
+                    99));
+    aSerial->println(F(" us"));
+    aSerial->print(F("MARK_EXCESS_MICROS="));
+    aSerial->print(tCalibration.MarkExcessMicros);
+    aSerial->print(F(" us tolerance="));
+    aSerial->print(tCalibration.TolerancePercent);
+    aSerial->println(F(" %"));
+}
+
+/**
+ * Sets the values used by the match functions and decoders of this instance instead of MARK_EXCESS_MICROS
+ * and TOLERANCE_FOR_DECODERS_MARK_OR_SPACE_MATCHING_PERCENT.
+ * The global match functions, e.g. matchMark() called by the application, use the values of IrReceiver.
+ */
+void IRrecv::setReceiverCalibration(const IRReceiverCalibration *aCalibration) {
+    markExcessMicros = aCalibration->MarkExcessMicros;
+    tolerancePercent = aCalibration->TolerancePercent;
+}
+
+void IRrecv::getReceiverCalibration(IRReceiverCalibration *aCalibration) {
+    aCalibration->MarkExcessMicros = markExcessMicros;
+    aCalibration->TolerancePercent = tolerancePercent;
+}
 #endif
 
-#if defined(DECODE_SAMSUNG)
-    TRACE_PRINTLN(F("Attempting Samsung decode"));
-    if (decodeSamsung()) {
-        return true;
+/**********************************************************************************************************************
+ * Compact decoded events
+ **********************************************************************************************************************/
+/**
+ * @return The handle of a free payload or IR_LOST_PAYLOAD_HANDLE if all payloads are in use.
+ */
+uint8_t IRPayloadPool::allocatePayload() {
+    for (uint_fast8_t i = 0; i < IR_PAYLOAD_POOL_SIZE; i++) {
+        if (!(usedPayloadsMask & (1 << i))) {
+            usedPayloadsMask |= (1 << i);
+            return i;
+        }
     }
-#endif
-    /*
-     * Start of the exotic protocols
-     */
+    return IR_LOST_PAYLOAD_HANDLE;
+}
 
-#if defined(DECODE_BEO)
-    TRACE_PRINTLN(F("Attempting Bang & Olufsen decode"));
-    if (decodeBangOlufsen()) {
-        return true;
+/**
+ * Handles, which do not reference a payload, like IR_NO_PAYLOAD_HANDLE, are ignored.
+ */
+void IRPayloadPool::releasePayload(uint8_t aPayloadHandle) {
+    if (aPayloadHandle < IR_PAYLOAD_POOL_SIZE) {
+        usedPayloadsMask &= ~(1 << aPayloadHandle);
     }
-#endif
+}
 
-#if defined(DECODE_FAST)
-    TRACE_PRINTLN(F("Attempting FAST decode"));
-    if (decodeFAST()) {
-        return true;
+/**
+ * @return Pointer to the payload or nullptr if aPayloadHandle references no allocated payload.
+ */
+IRPayload* IRPayloadPool::getPayload(uint8_t aPayloadHandle) {
+    if (aPayloadHandle < IR_PAYLOAD_POOL_SIZE && (usedPayloadsMask & (1 << aPayloadHandle))) {
+        return &payloads[aPayloadHandle];
     }
-#endif
+    return nullptr;
+}
 
-#if defined(DECODE_WHYNTER)
-    TRACE_PRINTLN(F("Attempting Whynter decode"));
-    if (decodeWhynter()) {
-        return true;
+uint_fast8_t IRPayloadPool::getNumberOfFreePayloads() {
+    uint_fast8_t tNumberOfFreePayloads = 0;
+    for (uint_fast8_t i = 0; i < IR_PAYLOAD_POOL_SIZE; i++) {
+        if (!(usedPayloadsMask & (1 << i))) {
+            tNumberOfFreePayloads++;
+        }
     }
-#endif
+    return tNumberOfFreePayloads;
+}
 
-#if defined(DECODE_LEGO_PF)
-    TRACE_PRINTLN(F("Attempting Lego Power Functions"));
-    if (decodeLegoPowerFunctions()) {
-        return true;
+/**
+ * Copies decodedIRData into the compact aDecodedEvent, e.g. to store it in a queue before calling resume().
+ * Data, which does not fit into the event, i.e. decodedRawData with more than 32 bits and the timing and data of
+ * the distance width protocols, is copied into a payload allocated in aPayloadPool.
+ * The application must call aPayloadPool->releasePayload(aDecodedEvent->payloadHandle), if it no longer requires the event.
+ * @param aPayloadPool  Can be nullptr, if only protocols with up to 32 bits are expected.
+ * @return false if the required payload could not be stored, because aPayloadPool is nullptr or full.
+ *         Then payloadHandle is IR_LOST_PAYLOAD_HANDLE and only the lower 32 bits of decodedRawData are stored.
+ */
+bool IRrecv::getDecodedEvent(IRDecodedEvent *aDecodedEvent, IRPayloadPool *aPayloadPool) {
+    aDecodedEvent->decodedRawData = decodedIRData.decodedRawData; // Lower 32 bits
+    aDecodedEvent->address = decodedIRData.address;
+    aDecodedEvent->command = decodedIRData.command;
+    aDecodedEvent->extra = decodedIRData.extra;
+    aDecodedEvent->numberOfBits = decodedIRData.numberOfBits;
+    aDecodedEvent->protocol = decodedIRData.protocol;
+    aDecodedEvent->flags = decodedIRData.flags;
+    aDecodedEvent->payloadHandle = IR_NO_PAYLOAD_HANDLE;
+
+    bool tPayloadIsRequired = decodedIRData.decodedRawData != aDecodedEvent->decodedRawData;
+#if defined(DECODE_DISTANCE_WIDTH)
+    if (decodedIRData.protocol == PULSE_DISTANCE || decodedIRData.protocol == PULSE_WIDTH) {
+        tPayloadIsRequired = true;
     }
 #endif
-
-#if defined(DECODE_BOSEWAVE)
-    TRACE_PRINTLN(F("Attempting Bosewave decode"));
-    if (decodeBoseWave()) {
+    if (!tPayloadIsRequired) {
         return true;
     }
-#endif
 
-#if defined(DECODE_MAGIQUEST)
-    TRACE_PRINTLN(F("Attempting MagiQuest decode"));
-    if (decodeMagiQuest()) {
-        return true;
+    aDecodedEvent->payloadHandle = IR_LOST_PAYLOAD_HANDLE;
+    if (aPayloadPool == nullptr) {
+        return false;
     }
-#endif
-
-#if defined(DECODE_OPENLASIR)
-    TRACE_PRINTLN(F("Attempting OpenLASIR decode"));
-    if (decodeOpenLASIR()) {
-        return true;
+    uint8_t tPayloadHandle = aPayloadPool->allocatePayload();
+    IRPayload *tPayloadPtr = aPayloadPool->getPayload(tPayloadHandle);
+    if (tPayloadPtr == nullptr) {
+        return false;
     }
-#endif
-
-    /*
-     * Try the universal decoder for pulse distance protocols
-     */
+    tPayloadPtr->decodedRawData = decodedIRData.decodedRawData;
 #if defined(DECODE_DISTANCE_WIDTH)
-    TRACE_PRINTLN(F("Attempting universal Distance Width decode"));
-    if (decodeDistanceWidth()) {
-        return true;
-    }
+    tPayloadPtr->DistanceWidthTimingInfo = decodedIRData.DistanceWidthTimingInfo;
+    memcpy(tPayloadPtr->decodedRawDataArray, decodedIRData.decodedRawDataArray, sizeof(tPayloadPtr->decodedRawDataArray));
 #endif
+    aDecodedEvent->payloadHandle = tPayloadHandle;
+    return true;
+}
 
-    /*
-     * Last resort is the universal hash decode which always return true
-     */
-#if defined(DECODE_HASH)
-    TRACE_PRINTLN(F("Hash decode"));
-    // decodeHash returns a hash on any input.
-    // Thus, it needs to be last in the list.
-    // If you add any decodes, add them before this.
-    if (decodeHash()) {
+/**
+ * Restores the IRData of an event stored by getDecodedEvent(), e.g. to print it with printIRDataShort() or to send it with IrSender.write().
+ * rawlen and initialGapTicks are set to 0. The payload is not released.
+ * @param aPayloadPool  The pool used for getDecodedEvent(). Can be nullptr, if the event has no payload.
+ * @return false if the payload of the event was lost or is not found in aPayloadPool.
+ */
+bool getIRDataFromDecodedEvent(IRData *aIRDataPtr, const IRDecodedEvent *aDecodedEvent, IRPayloadPool *aPayloadPool) {
+    memset(aIRDataPtr, 0, sizeof(*aIRDataPtr));
+    aIRDataPtr->protocol = (decode_type_t) aDecodedEvent->protocol;
+    aIRDataPtr->address = aDecodedEvent->address;
+    aIRDataPtr->command = aDecodedEvent->command;
+    aIRDataPtr->extra = aDecodedEvent->extra;
+    aIRDataPtr->decodedRawData = aDecodedEvent->decodedRawData;
+    aIRDataPtr->numberOfBits = aDecodedEvent->numberOfBits;
+    aIRDataPtr->flags = aDecodedEvent->flags;
+
+    if (aDecodedEvent->payloadHandle == IR_NO_PAYLOAD_HANDLE) {
         return true;
     }
+    IRPayload *tPayloadPtr = nullptr;
+    if (aPayloadPool != nullptr) {
+        tPayloadPtr = aPayloadPool->getPayload(aDecodedEvent->payloadHandle);
+    }
+    if (tPayloadPtr == nullptr) {
+        return false;
+    }
+    aIRDataPtr->decodedRawData = tPayloadPtr->decodedRawData;
+#if defined(DECODE_DISTANCE_WIDTH)
+    aIRDataPtr->DistanceWidthTimingInfo = tPayloadPtr->DistanceWidthTimingInfo;
+    memcpy(aIRDataPtr->decodedRawDataArray, tPayloadPtr->decodedRawDataArray, sizeof(aIRDataPtr->decodedRawDataArray));
 #endif
-
-    /*
-     * Return true here, to let the loop decide to call resume or to print raw data.
-     */
     return true;
 }
 
+
 /**********************************************************************************************************************
  * Common decode functions
  **********************************************************************************************************************/
@@ -768,7 +1775,7 @@ void IRrecv::decodePulseDistanceWidthData(uint_fast8_t aNumberOfBits, IRRawlenTy
 
     IRDecodedRawDataType tDecodedData = 0; // For MSB first tDecodedData is shifted left each loop
     IRDecodedRawDataType tMask = 1UL; // Mask is only used for LSB first
-    auto *tRawBufPointer = &irparams.rawbuf[aStartOffset];
+    auto *tRawBufPointer = &rawbufForDecode[aStartOffset];
 
     for (uint_fast8_t i = aNumberOfBits; i > 0; i--) {
 
@@ -844,7 +1851,7 @@ void IRrecv::decodeWithThresholdPulseDistanceWidthData(uint_fast8_t aNumberOfBit
 
     IRDecodedRawDataType tDecodedData = 0; // For MSB first tDecodedData is shifted left each loop
     IRDecodedRawDataType tMask = 1UL; // Mask is only used for LSB first
-    auto *tRawBufPointer = &irparams.rawbuf[aStartOffset];
+    auto *tRawBufPointer = &rawbufForDecode[aStartOffset];
 
     for (uint_fast8_t i = aNumberOfBits; i > 0; i--) {
 
@@ -888,7 +1895,7 @@ void IRrecv::decodeWithThresholdPulseDistanceWidthData(uint_fast8_t aNumberOfBit
 void IRrecv::decodePulseDistanceWidthData(uint_fast8_t aNumberOfBits, IRRawlenType aStartOffset, uint16_t aOneMarkMicros,
         uint16_t aOneSpaceMicros, uint16_t aZeroMarkMicros, bool aMSBfirst) {
 
-    auto *tRawBufPointer = &irparams.rawbuf[aStartOffset];
+    auto *tRawBufPointer = &rawbufForDecode[aStartOffset];
 
     bool isPulseDistanceProtocol = (aOneMarkMicros == aZeroMarkMicros); // If true, we check aOneSpaceMicros -> pulse distance protocol
 
@@ -964,7 +1971,7 @@ void IRrecv::decodePulseDistanceWidthData(uint_fast8_t aNumberOfBits, IRRawlenTy
 bool IRrecv::decodeStrictPulseDistanceWidthData(uint_fast8_t aNumberOfBits, IRRawlenType aStartOffset, uint16_t aOneMarkMicros,
         uint16_t aOneSpaceMicros, uint16_t aZeroMarkMicros, uint16_t aZeroSpaceMicros, bool aMSBfirst) {
 
-    auto *tRawBufPointer = &irparams.rawbuf[aStartOffset];
+    auto *tRawBufPointer = &rawbufForDecode[aStartOffset];
 
     bool isPulseDistanceProtocol = (aOneMarkMicros == aZeroMarkMicros); // If true, we have a constant mark -> pulse distance protocol
 
@@ -1092,11 +2099,11 @@ IRrecv::decodePulseDistanceWidthData(PulseDistanceWidthProtocolConstants *aProto
         if (tIsPulseWidthProtocol) {
             // we check the length of marks here
             tThresholdMicros = ((aProtocolConstants->DistanceWidthTimingInfo.OneMarkMicros
-                            + aProtocolConstants->DistanceWidthTimingInfo.ZeroMarkMicros) / 2) - MARK_EXCESS_MICROS;// MARK_EXCESS_MICROS is 0 here if not explicitly specified by user
+                            + aProtocolConstants->DistanceWidthTimingInfo.ZeroMarkMicros) / 2) - MARK_EXCESS_MICROS_FOR_DECODE;// MARK_EXCESS_MICROS is 0 here if not explicitly specified by user
         } else {
             // we check the length of spaces here
             tThresholdMicros = ((aProtocolConstants->DistanceWidthTimingInfo.OneSpaceMicros
-                            + aProtocolConstants->DistanceWidthTimingInfo.ZeroSpaceMicros) / 2) + MARK_EXCESS_MICROS;// MARK_EXCESS_MICROS is 0 here if not explicitly specified by user
+                            + aProtocolConstants->DistanceWidthTimingInfo.ZeroSpaceMicros) / 2) + MARK_EXCESS_MICROS_FOR_DECODE;// MARK_EXCESS_MICROS is 0 here if not explicitly specified by user
         }
         return decodeWithThresholdPulseDistanceWidthData(aNumberOfBits, aStartOffset, tThresholdMicros,
                 aProtocolConstants->Flags & PROTOCOL_IS_PULSE_WIDTH_MASK, (aProtocolConstants->Flags & PROTOCOL_IS_MSB_MASK));
@@ -1172,7 +2179,7 @@ bool IRrecv::decodeHash() {
     }
     for (IRRawlenType i = 1; (i + 2) < decodedIRData.rawlen; i++) {
         // Compare mark with mark and space with space
-        uint_fast8_t value = compare(irparams.rawbuf[i], irparams.rawbuf[i + 2]);
+        uint_fast8_t value = compare(rawbufForDecode[i], rawbufForDecode[i + 2]);
         // Add value into the hash - (0 if rawbuf[i + 2] is more than 20 % shorter, 1 if rawbuf[i + 2] is equal, and 2 if rawbuf[i + 2] is longer than rawbuf[i])
         hash = (hash * FNV_PRIME_32) ^ value;
     }
@@ -1214,13 +2221,16 @@ bool IRrecv::decodeHashOld(decode_results *aResults) {
  * returns true if values do match
  */
 bool IRrecv::checkHeader(PulseDistanceWidthProtocolConstants *aProtocolConstants) {
+    if (decodedIRData.rawlen < 3) {
+        return false; // Frame is too short to contain a header, called by decoders, which check the header before the length
+    }
 // Check header "mark" and "space"
-    if (!matchMark(irparams.rawbuf[1], aProtocolConstants->DistanceWidthTimingInfo.HeaderMarkMicros)) {
+    if (!matchMark(rawbufForDecode[1], aProtocolConstants->DistanceWidthTimingInfo.HeaderMarkMicros)) {
         TRACE_PRINT(::getProtocolString(aProtocolConstants->ProtocolIndex));
         TRACE_PRINTLN(F(": Header mark length is wrong"));
         return false;
     }
-    if (!matchSpace(irparams.rawbuf[2], aProtocolConstants->DistanceWidthTimingInfo.HeaderSpaceMicros)) {
+    if (!matchSpace(rawbufForDecode[2], aProtocolConstants->DistanceWidthTimingInfo.HeaderSpaceMicros)) {
         TRACE_PRINT(::getProtocolString(aProtocolConstants->ProtocolIndex));
         TRACE_PRINTLN(F(": Header space length is wrong"));
         return false;
@@ -1229,13 +2239,16 @@ bool IRrecv::checkHeader(PulseDistanceWidthProtocolConstants *aProtocolConstants
 }
 
 bool IRrecv::checkHeader_P(PulseDistanceWidthProtocolConstants const *aProtocolConstantsPGM) {
+    if (decodedIRData.rawlen < 3) {
+        return false; // Frame is too short to contain a header, called by decoders, which check the header before the length
+    }
 // Check header "mark" and "space"
-    if (!matchMark(irparams.rawbuf[1], pgm_read_word(&aProtocolConstantsPGM->DistanceWidthTimingInfo.HeaderMarkMicros))) {
+    if (!matchMark(rawbufForDecode[1], pgm_read_word(&aProtocolConstantsPGM->DistanceWidthTimingInfo.HeaderMarkMicros))) {
         TRACE_PRINT(::getProtocolString((decode_type_t ) pgm_read_byte(&aProtocolConstantsPGM->ProtocolIndex)));
         TRACE_PRINTLN(F(": Header mark length is wrong"));
         return false;
     }
-    if (!matchSpace(irparams.rawbuf[2], pgm_read_word(&aProtocolConstantsPGM->DistanceWidthTimingInfo.HeaderSpaceMicros))) {
+    if (!matchSpace(rawbufForDecode[2], pgm_read_word(&aProtocolConstantsPGM->DistanceWidthTimingInfo.HeaderSpaceMicros))) {
         TRACE_PRINT(::getProtocolString((decode_type_t ) pgm_read_byte(&aProtocolConstantsPGM->ProtocolIndex)));
         TRACE_PRINTLN(F(": Header space length is wrong"));
         return false;
@@ -1259,12 +2272,32 @@ void IRrecv::checkForRepeatSpaceTicksAndSetFlag(uint16_t aMaximumRepeatSpaceTick
     }
 }
 
+#if defined(SUPPORT_RECEIVER_CALIBRATION)
+/**
+ * Match function for the tolerance set by setReceiverCalibration()
+ * @return true, if aMeasuredMicros is within aMatchValueMicros +/- aTolerancePercent
+ */
+bool matchMicrosWithTolerance(uint16_t aMeasuredMicros, uint16_t aMatchValueMicros, uint8_t aTolerancePercent) {
+    uint16_t tToleranceMicros = ((uint32_t) aMatchValueMicros * aTolerancePercent) / 100;
+    TRACE_PRINT(F("Testing (actual vs desired): "));
+    TRACE_PRINT(aMeasuredMicros);
+    TRACE_PRINT(F("us vs "));
+    TRACE_PRINT(aMatchValueMicros);
+    TRACE_PRINT(F("us +/- "));
+    TRACE_PRINTLN(tToleranceMicros);
+    return (aMeasuredMicros + tToleranceMicros >= aMatchValueMicros && aMeasuredMicros <= aMatchValueMicros + tToleranceMicros);
+}
+#endif
+
 /**
  * Match function WITHOUT compensating for marks exceeded or spaces shortened by demodulator hardware
  * Match is true, if signal value is bigger/equal 75% and less/equal 125% of aMatchValueMicros.
  * @return true, if values match
  */
 bool matchTicks(uint16_t aMeasuredTicks, uint16_t aMatchValueMicros) {
+#if defined(SUPPORT_RECEIVER_CALIBRATION)
+    return IrReceiver.matchTicks(aMeasuredTicks, aMatchValueMicros);
+#else
     uint16_t tMeasuredMicros = (aMeasuredTicks * MICROS_PER_TICK);
     uint16_t tMatchValueMicrosQuarter = aMatchValueMicros / 4;
 
@@ -1288,9 +2321,13 @@ bool matchTicks(uint16_t aMeasuredTicks, uint16_t aMatchValueMicros) {
     }
 #endif
     return passed;
+#endif
 }
 
 bool matchTicksWithGreaterRange(uint16_t aMeasuredTicks, uint16_t aMatchValueMicros) {
+#if defined(SUPPORT_RECEIVER_CALIBRATION)
+    return IrReceiver.matchTicksWithGreaterRange(aMeasuredTicks, aMatchValueMicros);
+#else
     uint16_t tMeasuredMicros = (aMeasuredTicks * MICROS_PER_TICK);
     uint16_t tMatchValueMicrosQuarter = aMatchValueMicros / 4;
 
@@ -1314,6 +2351,7 @@ bool matchTicksWithGreaterRange(uint16_t aMeasuredTicks, uint16_t aMatchValueMic
     }
 #endif
     return passed;
+#endif
 }
 /**
  * Match function WITH compensating for marks exceeded or spaces shortened by demodulator hardware
@@ -1321,6 +2359,9 @@ bool matchTicksWithGreaterRange(uint16_t aMeasuredTicks, uint16_t aMatchValueMic
  * @return true, if values match
  */
 bool matchTicks(uint16_t aMeasuredTicks, uint16_t aMatchValueMicros, int16_t aCompensationMicrosForTicks) {
+#if defined(SUPPORT_RECEIVER_CALIBRATION)
+    return IrReceiver.matchTicks(aMeasuredTicks, aMatchValueMicros, aCompensationMicrosForTicks);
+#else
     uint16_t tMeasuredMicros = (aMeasuredTicks * MICROS_PER_TICK) + aCompensationMicrosForTicks;
     uint16_t tMatchValueMicrosQuarter = aMatchValueMicros / 4;
 
@@ -1344,9 +2385,13 @@ bool matchTicks(uint16_t aMeasuredTicks, uint16_t aMatchValueMicros, int16_t aCo
     }
 #endif
     return passed;
+#endif
 }
 
 bool matchTicksWithGreaterRange(uint16_t aMeasuredTicks, uint16_t aMatchValueMicros, int16_t aCompensationMicrosForTicks) {
+#if defined(SUPPORT_RECEIVER_CALIBRATION)
+    return IrReceiver.matchTicksWithGreaterRange(aMeasuredTicks, aMatchValueMicros, aCompensationMicrosForTicks);
+#else
     uint16_t tMeasuredMicros = (aMeasuredTicks * MICROS_PER_TICK) + aCompensationMicrosForTicks;
     uint16_t tMatchValueMicrosQuarter = aMatchValueMicros / 4;
 
@@ -1370,6 +2415,7 @@ bool matchTicksWithGreaterRange(uint16_t aMeasuredTicks, uint16_t aMatchValueMic
     }
 #endif
     return passed;
+#endif
 }
 
 bool MATCH(uint16_t measured_ticks, uint16_t desired_us) {
@@ -1381,47 +2427,47 @@ bool MATCH(uint16_t measured_ticks, uint16_t desired_us) {
  * @return true, if values match
  */
 bool matchMark(uint16_t aMeasuredTicks, uint16_t aMatchValueMicros) {
-#if (MARK_EXCESS_MICROS == 0)
+#if defined(SUPPORT_RECEIVER_CALIBRATION)
+    return IrReceiver.matchMark(aMeasuredTicks, aMatchValueMicros);
+#elif (MARK_EXCESS_MICROS == 0)
     return matchTicks(aMeasuredTicks, aMatchValueMicros);
+#elif !defined(USE_OLD_MATCH_FUNCTIONS)
+    return matchTicks(aMeasuredTicks, aMatchValueMicros, -MARK_EXCESS_MICROS); // New handling of MARK_EXCESS_MICROS without strange rounding errors
 #else
+    // old version here
+    aMatchValueMicros += MARK_EXCESS_MICROS;
 
-#  if !defined(USE_OLD_MATCH_FUNCTIONS)
-        return matchTicks(aMeasuredTicks, aMatchValueMicros, -MARK_EXCESS_MICROS); // New handling of MARK_EXCESS_MICROS without strange rounding errors
-#  endif
-
-        // old version here
-        aMatchValueMicros += MARK_EXCESS_MICROS;
-
-        TRACE_PRINT(F("Testing mark (actual vs desired): "));
-        TRACE_PRINT(aMeasuredTicks * MICROS_PER_TICK);
-        TRACE_PRINT(F("us vs "));
-        TRACE_PRINT(aMatchValueMicros);
-        TRACE_PRINT(F("us: "));
+    TRACE_PRINT(F("Testing mark (actual vs desired): "));
+    TRACE_PRINT(aMeasuredTicks * MICROS_PER_TICK);
+    TRACE_PRINT(F("us vs "));
+    TRACE_PRINT(aMatchValueMicros);
+    TRACE_PRINT(F("us: "));
 //    TRACE_PRINT(F("TICKS_LOW="));
 //    TRACE_PRINT(TICKS_LOW(aMatchValueMicros));
 //    TRACE_PRINT(F(" "));
-        TRACE_PRINT(TICKS_LOW(aMatchValueMicros) * MICROS_PER_TICK);
-        TRACE_PRINT(F(" <= "));
-        TRACE_PRINT(aMeasuredTicks * MICROS_PER_TICK);
-        TRACE_PRINT(F(" <= "));
-        TRACE_PRINT(TICKS_HIGH(aMatchValueMicros) * MICROS_PER_TICK);
-
-        // compensate for marks exceeded by demodulator hardware
-        bool passed = ((aMeasuredTicks >= TICKS_LOW(aMatchValueMicros))
-                && (aMeasuredTicks <= TICKS_HIGH(aMatchValueMicros)));
+    TRACE_PRINT(TICKS_LOW(aMatchValueMicros) * MICROS_PER_TICK);
+    TRACE_PRINT(F(" <= "));
+    TRACE_PRINT(aMeasuredTicks * MICROS_PER_TICK);
+    TRACE_PRINT(F(" <= "));
+    TRACE_PRINT(TICKS_HIGH(aMatchValueMicros) * MICROS_PER_TICK);
+
+    // compensate for marks exceeded by demodulator hardware
+    bool passed = ((aMeasuredTicks >= TICKS_LOW(aMatchValueMicros)) && (aMeasuredTicks <= TICKS_HIGH(aMatchValueMicros)));
 #  if defined(LOCAL_TRACE)
-        if (passed) {
-            Serial.println(F(" => passed"));
-        } else {
-            Serial.println(F(" => FAILED"));
-        }
+    if (passed) {
+        Serial.println(F(" => passed"));
+    } else {
+        Serial.println(F(" => FAILED"));
+    }
 #  endif
-        return passed;
+    return passed;
 #endif
 }
 
 bool matchMarkWithGreaterRange(uint16_t aMeasuredTicks, uint16_t aMatchValueMicros) {
-#if (MARK_EXCESS_MICROS == 0)
+#if defined(SUPPORT_RECEIVER_CALIBRATION)
+    return IrReceiver.matchMarkWithGreaterRange(aMeasuredTicks, aMatchValueMicros);
+#elif (MARK_EXCESS_MICROS == 0)
     return matchTicksWithGreaterRange(aMeasuredTicks, aMatchValueMicros);
 #else
     return matchTicksWithGreaterRange(aMeasuredTicks, aMatchValueMicros, -MARK_EXCESS_MICROS); // New handling of MARK_EXCESS_MICROS without strange rounding errors
@@ -1437,45 +2483,47 @@ bool MATCH_MARK(uint16_t measured_ticks, uint16_t desired_us) {
  * @return true, if values match
  */
 bool matchSpace(uint16_t aMeasuredTicks, uint16_t aMatchValueMicros) {
-#if (MARK_EXCESS_MICROS == 0)
+#if defined(SUPPORT_RECEIVER_CALIBRATION)
+    return IrReceiver.matchSpace(aMeasuredTicks, aMatchValueMicros);
+#elif (MARK_EXCESS_MICROS == 0)
     return matchTicks(aMeasuredTicks, aMatchValueMicros);
+#elif !defined(USE_OLD_MATCH_FUNCTIONS)
+    return matchTicks(aMeasuredTicks, aMatchValueMicros, MARK_EXCESS_MICROS); // New handling of MARK_EXCESS_MICROS without strange rounding errors
 #else
-#  if !defined(USE_OLD_MATCH_FUNCTIONS)
-        return matchTicks(aMeasuredTicks, aMatchValueMicros, MARK_EXCESS_MICROS); // New handling of MARK_EXCESS_MICROS without strange rounding errors
-#  endif
-        // old version here
-        aMatchValueMicros -= MARK_EXCESS_MICROS;
-
-        TRACE_PRINT(F("Testing space (actual vs desired): "));
-        TRACE_PRINT(aMeasuredTicks * MICROS_PER_TICK);
-        TRACE_PRINT(F("us vs "));
-        TRACE_PRINT(aMatchValueMicros);
-        TRACE_PRINT(F("us: "));
-        TRACE_PRINT(F("LOW="));
-        TRACE_PRINT(TICKS_LOW(aMatchValueMicros));
-        TRACE_PRINT(F(" "));
-        TRACE_PRINT(TICKS_LOW(aMatchValueMicros) * MICROS_PER_TICK);
-        TRACE_PRINT(F(" <= "));
-        TRACE_PRINT(aMeasuredTicks * MICROS_PER_TICK);
-        TRACE_PRINT(F(" <= "));
-        TRACE_PRINT(TICKS_HIGH(aMatchValueMicros) * MICROS_PER_TICK);
-
-        // compensate for spaces shortened by demodulator hardware
-        bool passed = ((aMeasuredTicks >= TICKS_LOW(aMatchValueMicros))
-                && (aMeasuredTicks <= TICKS_HIGH(aMatchValueMicros)));
+    // old version here
+    aMatchValueMicros -= MARK_EXCESS_MICROS;
+
+    TRACE_PRINT(F("Testing space (actual vs desired): "));
+    TRACE_PRINT(aMeasuredTicks * MICROS_PER_TICK);
+    TRACE_PRINT(F("us vs "));
+    TRACE_PRINT(aMatchValueMicros);
+    TRACE_PRINT(F("us: "));
+    TRACE_PRINT(F("LOW="));
+    TRACE_PRINT(TICKS_LOW(aMatchValueMicros));
+    TRACE_PRINT(F(" "));
+    TRACE_PRINT(TICKS_LOW(aMatchValueMicros) * MICROS_PER_TICK);
+    TRACE_PRINT(F(" <= "));
+    TRACE_PRINT(aMeasuredTicks * MICROS_PER_TICK);
+    TRACE_PRINT(F(" <= "));
+    TRACE_PRINT(TICKS_HIGH(aMatchValueMicros) * MICROS_PER_TICK);
+
+    // compensate for spaces shortened by demodulator hardware
+    bool passed = ((aMeasuredTicks >= TICKS_LOW(aMatchValueMicros)) && (aMeasuredTicks <= TICKS_HIGH(aMatchValueMicros)));
 #  if defined(LOCAL_TRACE)
-        if (passed) {
-            Serial.println(F(" => passed"));
-        } else {
-            Serial.println(F(" => FAILED"));
-        }
+    if (passed) {
+        Serial.println(F(" => passed"));
+    } else {
+        Serial.println(F(" => FAILED"));
+    }
 #  endif
-        return passed;
+    return passed;
 #endif
 }
 
 bool matchSpaceWithGreaterRange(uint16_t aMeasuredTicks, uint16_t aMatchValueMicros) {
-#if (MARK_EXCESS_MICROS == 0)
+#if defined(SUPPORT_RECEIVER_CALIBRATION)
+    return IrReceiver.matchSpaceWithGreaterRange(aMeasuredTicks, aMatchValueMicros);
+#elif (MARK_EXCESS_MICROS == 0)
     return matchTicksWithGreaterRange(aMeasuredTicks, aMatchValueMicros);
 #else
     return matchTicksWithGreaterRange(aMeasuredTicks, aMatchValueMicros, MARK_EXCESS_MICROS); // New handling of MARK_EXCESS_MICROS without strange rounding errors
@@ -1486,11 +2534,55 @@ bool MATCH_SPACE(uint16_t measured_ticks, uint16_t desired_us) {
     return matchSpace(measured_ticks, desired_us);
 }
 
+#if defined(SUPPORT_RECEIVER_CALIBRATION)
+/*
+ * The match functions of the decoders, which use markExcessMicros and tolerancePercent of this instance.
+ * The greater range functions use twice the tolerance. USE_OLD_MATCH_FUNCTIONS is not supported here.
+ */
+bool IRrecv::matchTicks(uint16_t aMeasuredTicks, uint16_t aMatchValueMicros) {
+    return matchMicrosWithTolerance(aMeasuredTicks * MICROS_PER_TICK, aMatchValueMicros, tolerancePercent);
+}
+
+bool IRrecv::matchTicks(uint16_t aMeasuredTicks, uint16_t aMatchValueMicros, int16_t aCompensationMicrosForTicks) {
+    return matchMicrosWithTolerance((aMeasuredTicks * MICROS_PER_TICK) + aCompensationMicrosForTicks, aMatchValueMicros,
+            tolerancePercent);
+}
+
+bool IRrecv::matchTicksWithGreaterRange(uint16_t aMeasuredTicks, uint16_t aMatchValueMicros) {
+    return matchMicrosWithTolerance(aMeasuredTicks * MICROS_PER_TICK, aMatchValueMicros, 2 * tolerancePercent);
+}
+
+bool IRrecv::matchTicksWithGreaterRange(uint16_t aMeasuredTicks, uint16_t aMatchValueMicros, int16_t aCompensationMicrosForTicks) {
+    return matchMicrosWithTolerance((aMeasuredTicks * MICROS_PER_TICK) + aCompensationMicrosForTicks, aMatchValueMicros,
+            2 * tolerancePercent);
+}
+
+bool IRrecv::matchMark(uint16_t aMeasuredTicks, uint16_t aMatchValueMicros) {
+    return matchTicks(aMeasuredTicks, aMatchValueMicros, -markExcessMicros);
+}
+
+bool IRrecv::matchMarkWithGreaterRange(uint16_t aMeasuredTicks, uint16_t aMatchValueMicros) {
+    return matchTicksWithGreaterRange(aMeasuredTicks, aMatchValueMicros, -markExcessMicros);
+}
+
+bool IRrecv::matchSpace(uint16_t aMeasuredTicks, uint16_t aMatchValueMicros) {
+    return matchTicks(aMeasuredTicks, aMatchValueMicros, markExcessMicros);
+}
+
+bool IRrecv::matchSpaceWithGreaterRange(uint16_t aMeasuredTicks, uint16_t aMatchValueMicros) {
+    return matchTicksWithGreaterRange(aMeasuredTicks, aMatchValueMicros, markExcessMicros);
+}
+#endif
+
 /**
- * Getter function for MARK_EXCESS_MICROS
+ * Getter function for MARK_EXCESS_MICROS or the value of IrReceiver set by setReceiverCalibration()
  */
 int getMarkExcessMicros() {
+#if defined(SUPPORT_RECEIVER_CALIBRATION)
+    return IrReceiver.markExcessMicros;
+#else
     return MARK_EXCESS_MICROS;
+#endif
 }
 
 /**
@@ -1710,12 +2802,12 @@ bool IRrecv::printIRResultShort(Print *aSerial, bool aCheckForRecordGapsMicros)
             /*
              * Print complete duration of IR frame
              */
-            uint16_t tSumOfDurationTicks = 0;
+            uint32_t tSumOfDurationTicks = 0;
             for (IRRawlenType i = 1; i < decodedIRData.rawlen; i++) {
-                tSumOfDurationTicks += irparams.rawbuf[i];
+                tSumOfDurationTicks += getRawbufTicks(i);
             }
             aSerial->print(F(", Duration="));
-            aSerial->print((uint32_t) tSumOfDurationTicks * MICROS_PER_TICK);
+            aSerial->print(tSumOfDurationTicks * MICROS_PER_TICK);
             aSerial->println(F("us"));
 #else
                 aSerial->println();
@@ -1912,7 +3004,7 @@ void IRrecv::printDistanceWidthTimingInfo(Print *aSerial, DistanceWidthTimingInf
 uint8_t IRrecv::getMaximumMarkTicksFromRawData() {
     uint8_t tMaximumTick = 0;
     for (IRRawlenType i = 3; i < decodedIRData.rawlen - 2; i += 2) { // Skip leading start and trailing stop bit.
-        auto tTick = irparams.rawbuf[i];
+        auto tTick = rawbufForDecode[i];
         if (tMaximumTick < tTick) {
             tMaximumTick = tTick;
         }
@@ -1922,7 +3014,7 @@ uint8_t IRrecv::getMaximumMarkTicksFromRawData() {
 uint8_t IRrecv::getMaximumSpaceTicksFromRawData() {
     uint8_t tMaximumTick = 0;
     for (IRRawlenType i = 4; i < decodedIRData.rawlen - 2; i += 2) { // Skip leading start and trailing stop bit.
-        auto tTick = irparams.rawbuf[i];
+        auto tTick = rawbufForDecode[i];
         if (tMaximumTick < tTick) {
             tMaximumTick = tTick;
         }
@@ -1942,7 +3034,7 @@ uint8_t IRrecv::getMaximumTicksFromRawData(bool aSearchSpaceInsteadOfMark) {
         i = 3;
     }
     for (; i < decodedIRData.rawlen - 2; i += 2) { // Skip leading start and trailing stop bit.
-        auto tTick = irparams.rawbuf[i];
+        auto tTick = rawbufForDecode[i];
         if (tMaximumTick < tTick) {
             tMaximumTick = tTick;
         }
@@ -1951,13 +3043,74 @@ uint8_t IRrecv::getMaximumTicksFromRawData(bool aSearchSpaceInsteadOfMark) {
 }
 
 uint32_t IRrecv::getTotalDurationOfRawData() {
-    uint16_t tSumOfDurationTicks = 0;
+    uint32_t tSumOfDurationTicks = 0; // 32 bit, since each long interval can contribute up to 65535 ticks
 
     for (IRRawlenType i = 1; i < decodedIRData.rawlen; i++) {
-        tSumOfDurationTicks += irparams.rawbuf[i];
+        tSumOfDurationTicks += getRawbufTicks(i);
+    }
+    return tSumOfDurationTicks * MICROS_PER_TICK;
+}
+
+/**
+ * Returns the exact ticks of a rawbuf entry.
+ * With LONG_INTERVALS_BUFFER_LENGTH defined, an 8 bit entry of UINT8_MAX is looked up in the table of long intervals.
+ * Otherwise it is the same as irparams.rawbuf[aIndex].
+ */
+#if defined(ESP8266) || defined(ESP32)
+IRAM_ATTR
+#endif
+uint_fast16_t IRrecv::getRawbufTicks(IRRawlenType aIndex) {
+#if defined(LONG_INTERVALS_BUFFER_LENGTH)
+    if (irparams.rawbuf[aIndex] == UINT8_MAX) {
+        for (uint_fast8_t i = 0; i < irparams.NumberOfLongIntervals; i++) {
+            if (irparams.LongIntervals[i].Index == aIndex) {
+                return irparams.LongIntervals[i].Ticks;
+            }
+        }
+    }
+#endif
+    return irparams.rawbuf[aIndex];
+}
+
+/**
+ * Same as getRawbufTicks(), but for the frame read by the decoders, which can also be referenced by an IRFrameView.
+ */
+uint_fast16_t IRrecv::getRawbufTicksForDecode(IRRawlenType aIndex) {
+#if defined(LONG_INTERVALS_BUFFER_LENGTH)
+    if (rawbufForDecode == irparams.rawbuf) {
+        return getRawbufTicks(aIndex);
+    }
+    if (rawbufForDecode[aIndex] == UINT8_MAX) {
+        for (uint_fast8_t i = 0; i < numberOfLongIntervalsForDecode; i++) {
+            if (longIntervalsForDecode[i].Index == aIndex) {
+                return longIntervalsForDecode[i].Ticks;
+            }
+        }
+    }
+#endif
+    return rawbufForDecode[aIndex];
+}
+
+#if defined(LONG_INTERVALS_BUFFER_LENGTH)
+/**
+ * Stores the exact ticks of an interval, for which the escape value UINT8_MAX is written to rawbuf[aIndex].
+ * If the table is full, the interval stays clipped to UINT8_MAX.
+ */
+#  if defined(ESP8266) || defined(ESP32)
+IRAM_ATTR
+#  endif
+void IRrecv::storeLongInterval(IRRawlenType aIndex, uint16_t aTicks) {
+    uint_fast8_t tNumberOfLongIntervals = irparams.NumberOfLongIntervals;
+    if (tNumberOfLongIntervals > 0 && irparams.LongIntervals[tNumberOfLongIntervals - 1].Index >= aIndex) {
+        tNumberOfLongIntervals--; // The entry was removed from rawbuf by the glitch filter, reuse it
+    }
+    if (tNumberOfLongIntervals < LONG_INTERVALS_BUFFER_LENGTH) {
+        irparams.LongIntervals[tNumberOfLongIntervals].Index = aIndex;
+        irparams.LongIntervals[tNumberOfLongIntervals].Ticks = aTicks;
+        irparams.NumberOfLongIntervals = tNumberOfLongIntervals + 1;
     }
-    return (uint32_t) tSumOfDurationTicks * MICROS_PER_TICK;
 }
+#endif
 
 // @formatter:off
 
@@ -2186,13 +3339,13 @@ void IRrecv::printIRResultMinimal(Print *aSerial) {
  * Not used yet
  */
 void IRrecv::printIRDuration(Print *aSerial, bool aOutputMicrosecondsInsteadOfTicks) {
-    uint16_t tSumOfDurationTicks = 0;
+    uint32_t tSumOfDurationTicks = 0;
     for (IRRawlenType i = 1; i < decodedIRData.rawlen; i++) {
-        tSumOfDurationTicks += irparams.rawbuf[i];
+        tSumOfDurationTicks += getRawbufTicks(i);
     }
     aSerial->print(F("Duration="));
     if (aOutputMicrosecondsInsteadOfTicks) {
-        aSerial->print((uint32_t) tSumOfDurationTicks * MICROS_PER_TICK);
+        aSerial->print(tSumOfDurationTicks * MICROS_PER_TICK);
         aSerial->println(F("us"));
 
     } else {
@@ -2242,11 +3395,11 @@ void IRrecv::printIRResultRawFormatted(Print *aSerial, bool aOutputMicrosecondsI
 #endif
 
     uint32_t tDuration;
-    uint16_t tSumOfDurationTicks = 0;
+    uint32_t tSumOfDurationTicks = 0;
     for (IRRawlenType i = 1; i < decodedIRData.rawlen; i++) {
-        auto tCurrentTicks = irparams.rawbuf[i];
+        uint_fast16_t tCurrentTicks = getRawbufTicks(i);
         if (aOutputMicrosecondsInsteadOfTicks) {
-            tDuration = tCurrentTicks * MICROS_PER_TICK;
+            tDuration = (uint32_t) tCurrentTicks * MICROS_PER_TICK;
         } else {
             tDuration = tCurrentTicks;
         }
@@ -2283,7 +3436,7 @@ void IRrecv::printIRResultRawFormatted(Print *aSerial, bool aOutputMicrosecondsI
     aSerial->println();
     aSerial->print(F("Duration="));
     if (aOutputMicrosecondsInsteadOfTicks) {
-        aSerial->print((uint32_t) tSumOfDurationTicks * MICROS_PER_TICK);
+        aSerial->print(tSumOfDurationTicks * MICROS_PER_TICK);
         aSerial->println(F("us"));
 
     } else {
@@ -2321,14 +3474,14 @@ void IRrecv::printIRResultAsCArray(Print *aSerial, bool aOutputMicrosecondsInste
 
 // Dump data
     for (IRRawlenType i = 1; i < decodedIRData.rawlen; i++) {
-        uint32_t tDuration = irparams.rawbuf[i] * MICROS_PER_TICK; // no problem to use 50 instead of 50L here!
+        uint32_t tDuration = (uint32_t) getRawbufTicks(i) * MICROS_PER_TICK; // no problem to use 50 instead of 50L here!
 
         if (aDoCompensate) {
             if (i & 1) {
                 // Mark
-                tDuration -= MARK_EXCESS_MICROS;
+                tDuration -= MARK_EXCESS_MICROS_FOR_DECODE;
             } else {
-                tDuration += MARK_EXCESS_MICROS;
+                tDuration += MARK_EXCESS_MICROS_FOR_DECODE;
             }
         }
 
@@ -2367,12 +3520,12 @@ void IRrecv::compensateAndStoreIRResultInArray(uint8_t *aArrayPtr) {
 // Store data, skip leading space#
     IRRawlenType i;
     for (i = 1; i < decodedIRData.rawlen; i++) {
-        uint32_t tDuration = irparams.rawbuf[i] * MICROS_PER_TICK; // no problem to use 50 instead of 50L here!
+        uint32_t tDuration = (uint32_t) getRawbufTicks(i) * MICROS_PER_TICK; // no problem to use 50 instead of 50L here!
         if (i & 1) {
             // Mark
-            tDuration -= MARK_EXCESS_MICROS;
+            tDuration -= MARK_EXCESS_MICROS_FOR_DECODE;
         } else {
-            tDuration += MARK_EXCESS_MICROS;
+            tDuration += MARK_EXCESS_MICROS_FOR_DECODE;
         }
 
         unsigned int tTicks = (tDuration + (MICROS_PER_TICK / 2)) / MICROS_PER_TICK;
@@ -2381,6 +3534,202 @@ void IRrecv::compensateAndStoreIRResultInArray(uint8_t *aArrayPtr) {
     }
 }
 
+/**********************************************************************************************************************
+ * Binary capture record
+ * Compact format for logging or storing received frames, around 5 to 10 times smaller than printIRResultAsCArray() output.
+ * All numbers are coded as varint, i.e. 7 bits per byte, LSB first, bit 7 is set if more bytes follow.
+ *   IR_BINARY_RECORD_START
+ *   MICROS_PER_TICK of the timing entries
+ *   initialGapTicks, rawlen
+ *   protocol (1 byte), address, command, extra, numberOfBits, flags (1 byte), decodedRawData
+ *   rawlen - 1 timing entries, each as zigzag coded difference to the previous entry of the same type (mark or space),
+ *      i.e. the identical marks of pulse distance protocols require only one byte
+ *   XOR checksum over all preceding bytes of the record
+ **********************************************************************************************************************/
+static void writeBinaryRecordByte(Print *aSerial, uint8_t aByte, uint8_t *aChecksum) {
+    aSerial->write(aByte);
+    *aChecksum ^= aByte;
+}
+
+static uint_fast8_t writeBinaryRecordVarint(Print *aSerial, IRDecodedRawDataType aValue, uint8_t *aChecksum) {
+    uint_fast8_t tNumberOfBytes = 1;
+    while (aValue >= 0x80) {
+        writeBinaryRecordByte(aSerial, (aValue & 0x7F) | 0x80, aChecksum);
+        aValue >>= 7;
+        tNumberOfBytes++;
+    }
+    writeBinaryRecordByte(aSerial, aValue, aChecksum);
+    return tNumberOfBytes;
+}
+
+/**
+ * Writes the last received frame and its decoded data as binary record.
+ * The bytes are written directly to aSerial, no buffer is required.
+ * @param aSerial   The Print object on which to write, for Arduino you can use &Serial.
+ * @return Number of bytes written.
+ */
+size_t IRrecv::writeIRResultAsBinaryRecord(Print *aSerial) {
+    uint8_t tChecksum = 0;
+    writeBinaryRecordByte(aSerial, IR_BINARY_RECORD_START, &tChecksum);
+    size_t tNumberOfBytes = 1 + writeBinaryRecordVarint(aSerial, MICROS_PER_TICK, &tChecksum);
+    tNumberOfBytes += writeBinaryRecordVarint(aSerial, decodedIRData.initialGapTicks, &tChecksum);
+    tNumberOfBytes += writeBinaryRecordVarint(aSerial, decodedIRData.rawlen, &tChecksum);
+    writeBinaryRecordByte(aSerial, decodedIRData.protocol, &tChecksum);
+    tNumberOfBytes += 1 + writeBinaryRecordVarint(aSerial, decodedIRData.address, &tChecksum);
+    tNumberOfBytes += writeBinaryRecordVarint(aSerial, decodedIRData.command, &tChecksum);
+    tNumberOfBytes += writeBinaryRecordVarint(aSerial, decodedIRData.extra, &tChecksum);
+    tNumberOfBytes += writeBinaryRecordVarint(aSerial, decodedIRData.numberOfBits, &tChecksum);
+    writeBinaryRecordByte(aSerial, decodedIRData.flags, &tChecksum);
+    tNumberOfBytes += 1 + writeBinaryRecordVarint(aSerial, decodedIRData.decodedRawData, &tChecksum);
+
+    int32_t tLastTicks[2] = { 0, 0 }; // [0] for spaces, [1] for marks. 32 bit, since the difference of 16 bit values needs 17 bits.
+    for (IRRawlenType i = 1; i < decodedIRData.rawlen; i++) {
+        int32_t tDelta = (int32_t) getRawbufTicks(i) - tLastTicks[i & 1];
+        tLastTicks[i & 1] = getRawbufTicks(i);
+        // zigzag coding, 0 -> 0, -1 -> 1, 1 -> 2, -2 -> 3 ...
+        uint32_t tZigzag = (tDelta >= 0) ? ((uint32_t) tDelta << 1) : ((((uint32_t) -tDelta) << 1) - 1);
+        tNumberOfBytes += writeBinaryRecordVarint(aSerial, tZigzag, &tChecksum);
+    }
+    aSerial->write(tChecksum);
+    return tNumberOfBytes + 1;
+}
+
+static bool readBinaryRecordVarint(const uint8_t **aRecordPtr, const uint8_t *aRecordEnd, IRDecodedRawDataType *aValue) {
+    IRDecodedRawDataType tValue = 0;
+    uint_fast8_t tShift = 0;
+    while (*aRecordPtr < aRecordEnd && tShift < BITS_IN_DECODED_RAW_DATA_TYPE) {
+        uint8_t tByte = *(*aRecordPtr)++;
+        tValue |= (IRDecodedRawDataType) (tByte & 0x7F) << tShift;
+        if (!(tByte & 0x80)) {
+            *aValue = tValue;
+            return true;
+        }
+        tShift += 7;
+    }
+    return false;
+}
+
+/*
+ * Converts ticks of the record to ticks of the current resolution
+ */
+static uint16_t convertBinaryRecordTicks(int32_t aTicks, uint_fast8_t aRecordMicrosPerTick) {
+    if (aTicks <= 0) {
+        return 0;
+    }
+    uint32_t tTicks = aTicks;
+    if (aRecordMicrosPerTick != MICROS_PER_TICK) {
+        tTicks = ((tTicks * aRecordMicrosPerTick) + (MICROS_PER_TICK / 2)) / MICROS_PER_TICK;
+    }
+    return (tTicks > UINT16_MAX) ? UINT16_MAX : tTicks;
+}
+
+/**
+ * Loads a binary record written by writeIRResultAsBinaryRecord() into irparams, like it was just received.
+ * After successful return, available() is true and decode() can be called.
+ * Call stop() before, to avoid interference with the receive interrupt.
+ * The record is checked completely, including the checksum, before irparams is modified.
+ * Timings recorded with another MICROS_PER_TICK are converted to the current resolution.
+ * @param aRecord           Pointer to the start byte of the record. Must be in RAM.
+ * @param aMaximumLength    Number of valid bytes at aRecord.
+ * @param aRecordedIRData   If not nullptr, the decoded data contained in the record is stored here e.g. for comparison with the result of decode().
+ * @return Length of the record, 0 if record is not valid or incomplete.
+ */
+size_t IRrecv::readBinaryRecord(const uint8_t *aRecord, size_t aMaximumLength, IRData *aRecordedIRData) {
+    const uint8_t *tRecordPtr = aRecord;
+    const uint8_t *tRecordEnd = aRecord + aMaximumLength;
+    IRDecodedRawDataType tValue;
+    IRData tRecordedIRData;
+    memset(&tRecordedIRData, 0, sizeof(tRecordedIRData));
+
+    if (aMaximumLength < 2 || *tRecordPtr++ != IR_BINARY_RECORD_START) {
+        return 0;
+    }
+    if (!readBinaryRecordVarint(&tRecordPtr, tRecordEnd, &tValue) || tValue == 0 || tValue > UINT8_MAX) {
+        return 0;
+    }
+    uint_fast8_t tRecordMicrosPerTick = tValue;
+    if (!readBinaryRecordVarint(&tRecordPtr, tRecordEnd, &tValue)) {
+        return 0;
+    }
+    tRecordedIRData.initialGapTicks = convertBinaryRecordTicks(tValue > UINT16_MAX ? UINT16_MAX : tValue, tRecordMicrosPerTick);
+    if (!readBinaryRecordVarint(&tRecordPtr, tRecordEnd, &tValue) || tValue > RAW_BUFFER_LENGTH || tRecordPtr >= tRecordEnd) {
+        return 0;
+    }
+    tRecordedIRData.rawlen = tValue;
+    tRecordedIRData.protocol = (decode_type_t) *tRecordPtr++;
+    if (!readBinaryRecordVarint(&tRecordPtr, tRecordEnd, &tValue)) {
+        return 0;
+    }
+    tRecordedIRData.address = tValue;
+    if (!readBinaryRecordVarint(&tRecordPtr, tRecordEnd, &tValue)) {
+        return 0;
+    }
+    tRecordedIRData.command = tValue;
+    if (!readBinaryRecordVarint(&tRecordPtr, tRecordEnd, &tValue)) {
+        return 0;
+    }
+    tRecordedIRData.extra = tValue;
+    if (!readBinaryRecordVarint(&tRecordPtr, tRecordEnd, &tValue) || tRecordPtr >= tRecordEnd) {
+        return 0;
+    }
+    tRecordedIRData.numberOfBits = tValue;
+    tRecordedIRData.flags = *tRecordPtr++;
+    if (!readBinaryRecordVarint(&tRecordPtr, tRecordEnd, &tValue)) {
+        return 0;
+    }
+    tRecordedIRData.decodedRawData = tValue;
+
+    /*
+     * Check the timing entries and the checksum, before irparams is modified
+     */
+    const uint8_t *tTimingStart = tRecordPtr;
+    for (IRRawlenType i = 1; i < tRecordedIRData.rawlen; i++) {
+        if (!readBinaryRecordVarint(&tRecordPtr, tRecordEnd, &tValue)) {
+            return 0;
+        }
+    }
+    uint8_t tChecksum = 0;
+    for (const uint8_t *tPtr = aRecord; tPtr < tRecordPtr; tPtr++) {
+        tChecksum ^= *tPtr;
+    }
+    if (tRecordPtr >= tRecordEnd || *tRecordPtr++ != tChecksum) {
+        return 0;
+    }
+
+    /*
+     * Timings are written directly to rawbuf
+     */
+#if defined(LONG_INTERVALS_BUFFER_LENGTH)
+    irparams.NumberOfLongIntervals = 0;
+#endif
+    const uint8_t *tTimingPtr = tTimingStart;
+    int32_t tLastTicks[2] = { 0, 0 };
+    for (IRRawlenType i = 1; i < tRecordedIRData.rawlen; i++) {
+        readBinaryRecordVarint(&tTimingPtr, tRecordPtr, &tValue); // was checked above
+        int32_t tDelta = (tValue & 1) ? -(int32_t) ((tValue + 1) >> 1) : (int32_t) (tValue >> 1);
+        tLastTicks[i & 1] += tDelta;
+        uint16_t tTicks = convertBinaryRecordTicks(tLastTicks[i & 1], tRecordMicrosPerTick);
+#if !defined(USE_16_BIT_TIMING_BUFFER)
+        if (tTicks > UINT8_MAX) {
+#  if defined(LONG_INTERVALS_BUFFER_LENGTH)
+            storeLongInterval(i, tTicks);
+#  endif
+            tTicks = UINT8_MAX; // the record may be written with a 16 bit timing buffer
+        }
+#endif
+        irparams.rawbuf[i] = tTicks;
+    }
+
+    irparams.initialGapTicks = tRecordedIRData.initialGapTicks;
+    irparams.rawlen = tRecordedIRData.rawlen;
+    irparams.OverflowFlag = false;
+    handleCapturedFrameEnd();
+    if (aRecordedIRData != nullptr) {
+        *aRecordedIRData = tRecordedIRData;
+    }
+    return tRecordPtr - aRecord;
+}
+
 /**
  * Print results as C variables to be used for sendXXX()
  * uint16_t address = 0x44;
@@ -2448,7 +3797,7 @@ bool IRrecv::decode_old(decode_results *aResults) {
 // copy for usage by legacy programs
     aResults->rawbuf[0] = irparams.initialGapTicks;
     for (int i = 1; i < RAW_BUFFER_LENGTH; ++i) {
-        aResults->rawbuf[i] = irparams.rawbuf[i]; // copy 8 bit array into a 16 bit array
+        aResults->rawbuf[i] = getRawbufTicks(i); // copy 8 bit array into a 16 bit array
     }
     aResults->rawlen = irparams.rawlen;
     if (irparams.OverflowFlag) {
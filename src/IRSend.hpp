@@ -65,6 +65,9 @@ IRsend::IRsend() { // @suppress("Class members should be properly initialized")
 #if !defined(IR_SEND_PIN)
     sendPin = 0;
 #endif
+#if defined(USE_MULTIPLE_SEND_PINS)
+    numberOfSendPins = 0;
+#endif
 }
 
 /******************************************************************************************************************
@@ -91,6 +94,9 @@ void IRsend::begin(uint_fast8_t aFeedbackLEDPin) {
 #else // defined(IR_SEND_PIN)
 IRsend::IRsend(uint_fast8_t aSendPin) { // @suppress("Class members should be properly initialized")
     sendPin = aSendPin;
+#if defined(USE_MULTIPLE_SEND_PINS)
+    numberOfSendPins = 0;
+#endif
 }
 
 /**
@@ -103,8 +109,75 @@ void IRsend::begin(uint_fast8_t aSendPin) {
 
 void IRsend::setSendPin(uint_fast8_t aSendPin) {
     sendPin = aSendPin;
+#if defined(USE_MULTIPLE_SEND_PINS)
+    numberOfSendPins = 0; // back to single pin
+#endif
 }
 
+#if defined(USE_MULTIPLE_SEND_PINS)
+/**
+ * Specifies the pins, at which the signal is sent simultaneously.
+ * The pins are grouped by their port, and the output register and mask of each port are stored here,
+ * so that the pins of each port are switched by one masked port register write.
+ * A subsequent call of setSendPin() switches back to single pin sending.
+ * @param aSendPins         Array of Arduino pin numbers. aSendPins[0] is also taken as sendPin.
+ * @param aNumberOfSendPins Number of pins in aSendPins. Values greater than MAXIMUM_NUMBER_OF_SEND_PINS are clipped.
+ */
+void IRsend::setSendPins(const uint8_t aSendPins[], uint_fast8_t aNumberOfSendPins) {
+    if (aNumberOfSendPins > MAXIMUM_NUMBER_OF_SEND_PINS) {
+        aNumberOfSendPins = MAXIMUM_NUMBER_OF_SEND_PINS;
+    }
+    numberOfSendPins = aNumberOfSendPins;
+    if (aNumberOfSendPins == 0) {
+        return;
+    }
+    sendPin = aSendPins[0];
+#  if defined(portOutputRegister)
+    numberOfSendPorts = 0;
+#  endif
+    for (uint_fast8_t i = 0; i < aNumberOfSendPins; i++) {
+        sendPins[i] = aSendPins[i];
+#  if defined(portOutputRegister)
+        volatile IRSendPortMaskType *tPortRegister = portOutputRegister(digitalPinToPort(aSendPins[i]));
+        uint_fast8_t tPortIndex = 0;
+        while (tPortIndex < numberOfSendPorts && sendPortRegisters[tPortIndex] != tPortRegister) {
+            tPortIndex++;
+        }
+        if (tPortIndex == numberOfSendPorts) {
+            // First pin at this port
+            sendPortRegisters[tPortIndex] = tPortRegister;
+            sendPortMasks[tPortIndex] = 0;
+            numberOfSendPorts++;
+        }
+        sendPortMasks[tPortIndex] |= digitalPinToBitMask(aSendPins[i]);
+#  endif
+    }
+}
+
+/**
+ * Sets all send pins to active or inactive level. Only called if numberOfSendPins > 0.
+ * Interrupts must be disabled by caller, since the port register writes are read modify write.
+ */
+void IRsend::writeSendPins(bool aActive) {
+#  if defined(USE_ACTIVE_LOW_OUTPUT_FOR_SEND_PIN)
+    aActive = !aActive;
+#  endif
+#  if defined(portOutputRegister)
+    for (uint_fast8_t i = 0; i < numberOfSendPorts; i++) {
+        if (aActive) {
+            *sendPortRegisters[i] |= sendPortMasks[i];
+        } else {
+            *sendPortRegisters[i] &= ~sendPortMasks[i];
+        }
+    }
+#  else
+    for (uint_fast8_t i = 0; i < numberOfSendPins; i++) {
+        digitalWrite(sendPins[i], aActive);
+    }
+#  endif
+}
+#endif // defined(USE_MULTIPLE_SEND_PINS)
+
 /**
  * Initializes the send and feedback pin
  * @param aSendPin The Arduino pin number, where a IR sender diode is connected.
@@ -143,7 +216,7 @@ void IRsend::begin(uint_fast8_t aSendPin, bool aEnableLEDFeedback, uint_fast8_t
  * @param aNumberOfRepeats Number of repeats to send after the initial data if data is no repeat.
  * @return 1 if data sent, 0 if no data sent (i.e. for BANG_OLUFSEN, which is currently not supported here)
  */
-size_t IRsend::write(IRData *aIRSendData, int_fast8_t aNumberOfRepeats) {
+size_t IRsend::write(const IRData *aIRSendData, int_fast8_t aNumberOfRepeats) {
 
     auto tProtocol = aIRSendData->protocol;
     auto tAddress = aIRSendData->address;
@@ -252,6 +325,10 @@ size_t IRsend::write(IRData *aIRSendData, int_fast8_t aNumberOfRepeats) {
         // we have a 32 bit ID/address
         sendMagiQuest(aIRSendData->decodedRawData, tCommand);
 
+    } else if (tProtocol == WHYNTER) {
+        // we have 32 bit raw data and no address and command
+        sendWhynter(aIRSendData->decodedRawData, aNumberOfRepeats);
+
     } else if (tProtocol == FAST) {
         // We have only 8 bit command
         sendFAST(tCommand, aNumberOfRepeats);
@@ -261,6 +338,12 @@ size_t IRsend::write(IRData *aIRSendData, int_fast8_t aNumberOfRepeats) {
 
     } else if (tProtocol == OPENLASIR) {
         sendOpenLASIR(tAddress, tCommand, aNumberOfRepeats);
+
+    } else if (tProtocol == RC6A) {
+        sendRC6A(tAddress, tCommand, aNumberOfRepeats, aIRSendData->extra, !tIsRepeat); // extra is the customer code, as set by decode()
+
+    } else if (tProtocol == MARANTZ) {
+        sendRC5Marantz(tAddress, tCommand, aNumberOfRepeats, aIRSendData->extra, !tIsRepeat); // extra is the command extension
 #endif
 
     } else {
@@ -269,6 +352,118 @@ size_t IRsend::write(IRData *aIRSendData, int_fast8_t aNumberOfRepeats) {
     return 1;
 }
 
+#if defined(SUPPORT_ENCODE_TO_DURATION_SINK)
+/**
+ * Generates the marks and spaces which write() would send, and passes them to aDurationSink instead of sending them.
+ * The gaps between the repeats are generated as spaces. There is no gap after the last frame.
+ * No output pin, timer or delay is used, so it can be called e.g. on a host or while another frame is sent by a timer.
+ * Toggle bits, e.g. of RC5, are changed like for sending.
+ * @param aDurationSink     Receives the frequency and all durations.
+ * @param aNumberOfRepeats  Like for write(). For Bang & Olufsen, repeats are sent back to back.
+ * @return 1 if data was encoded, 0 if protocol is not supported.
+ */
+size_t IRsend::encode(IRData *aIRSendData, IRDurationSink *aDurationSink, int_fast8_t aNumberOfRepeats) {
+    durationSinkForEncode = aDurationSink;
+    encodedSignalMicros = 0;
+    size_t tReturnValue = 1;
+#  if defined(DECODE_BEO)
+    if (aIRSendData->protocol == BANG_OLUFSEN) {
+        sendBangOlufsen(aIRSendData->address, aIRSendData->command, aNumberOfRepeats);
+    } else
+#  endif
+    {
+        tReturnValue = write(aIRSendData, aNumberOfRepeats);
+    }
+    durationSinkForEncode = nullptr;
+    return tReturnValue;
+}
+
+IRDurationBuffer::IRDurationBuffer(uint16_t *aDurationsMicros, uint16_t aMaximumNumberOfDurations) {
+    DurationsMicros = aDurationsMicros;
+    MaximumNumberOfDurations = aMaximumNumberOfDurations;
+    reset();
+}
+
+/**
+ * Clears the buffer. Must be called before encoding the next frame(s) to the same buffer.
+ */
+void IRDurationBuffer::reset() {
+    NumberOfDurations = 0;
+    FrequencyKHz = 0;
+    hasOverflow = false;
+    hasClippedDuration = false;
+}
+
+void IRDurationBuffer::setFrequency(uint_fast16_t aFrequencyKHz) {
+    FrequencyKHz = aFrequencyKHz;
+}
+
+void IRDurationBuffer::mark(uint16_t aMarkMicros) {
+    append(aMarkMicros, true);
+}
+
+void IRDurationBuffer::space(uint32_t aSpaceMicros) {
+    append(aSpaceMicros, false);
+}
+
+/*
+ * Marks are at even, spaces at odd indexes, like for sendRaw()
+ */
+void IRDurationBuffer::append(uint32_t aDurationMicros, bool aIsMark) {
+    if (NumberOfDurations == 0 && !aIsMark) {
+        return; // Leading space is not stored
+    }
+    if (NumberOfDurations > 0 && ((NumberOfDurations - 1) & 1) == !aIsMark) {
+        // Same type as last entry -> merge
+        aDurationMicros += DurationsMicros[NumberOfDurations - 1];
+        NumberOfDurations--;
+    } else if (NumberOfDurations >= MaximumNumberOfDurations) {
+        hasOverflow = true;
+        return;
+    }
+    if (aDurationMicros > UINT16_MAX) {
+        aDurationMicros = UINT16_MAX;
+        hasClippedDuration = true;
+    }
+    DurationsMicros[NumberOfDurations++] = aDurationMicros;
+}
+#endif
+
+/**
+ * @return millis() or the time of the durations generated so far by encode() or recorded by the recording backend.
+ * Used by the send functions to compute the gap between repeats from the repeat period.
+ */
+unsigned long IRsend::getMillisForFrameTiming() {
+#if defined(SUPPORT_ENCODE_TO_DURATION_SINK)
+    if (durationSinkForEncode != nullptr) {
+        return encodedSignalMicros / MICROS_IN_ONE_MILLI;
+    }
+#endif
+#if defined(USE_SEND_RECORDING_BACKEND)
+    return IRSendRecordingBackend::SignalMicros / MICROS_IN_ONE_MILLI;
+#else
+    return millis();
+#endif
+}
+
+/**
+ * Waits for the gap between two frames, or passes the gap as space to the sink of encode() or to the recording backend.
+ */
+void IRsend::delayBetweenFrames(unsigned long aMillis) {
+#if defined(SUPPORT_ENCODE_TO_DURATION_SINK)
+    if (durationSinkForEncode != nullptr) {
+        durationSinkForEncode->space(aMillis * MICROS_IN_ONE_MILLI);
+        encodedSignalMicros += aMillis * MICROS_IN_ONE_MILLI;
+        return;
+    }
+#endif
+#if defined(USE_SEND_RECORDING_BACKEND)
+    IRSendRecordingBackend::recordGap(aMillis * MICROS_IN_ONE_MILLI);
+#else
+    delay(aMillis);
+#endif
+}
+
 /**
  * Simple version of write without support for MAGIQUEST and numberOfBits for SONY protocol
  * @param aNumberOfRepeats  If aNumberOfRepeats < 0 then only a special repeat frame without leading and trailing space
@@ -428,19 +623,19 @@ void IRsend::sendRaw(const uint16_t aBufferWithMicroseconds[], uint_fast16_t aLe
 
     uint_fast8_t tNumberOfCommands = aNumberOfRepeats + 1;
     while (tNumberOfCommands > 0) {
-        unsigned long tStartOfFrameMillis = millis();
+        unsigned long tStartOfFrameMillis = getMillisForFrameTiming();
         sendRaw(aBufferWithMicroseconds, aLengthOfBuffer, aIRFrequencyKilohertz);
 
         tNumberOfCommands--;
 
         // skip last delay!
         if (tNumberOfCommands > 0) {
-            auto tCurrentFrameDurationMillis = millis() - tStartOfFrameMillis;
+            auto tCurrentFrameDurationMillis = getMillisForFrameTiming() - tStartOfFrameMillis;
             /*
              * Check and fallback for wrong RepeatPeriodMillis parameter. I.e the repeat period must be greater than each frame duration.
              */
             if (aRepeatPeriodMillis > tCurrentFrameDurationMillis) {
-                delay(aRepeatPeriodMillis - tCurrentFrameDurationMillis);
+                delayBetweenFrames(aRepeatPeriodMillis - tCurrentFrameDurationMillis);
             }
         }
     }
@@ -468,19 +663,19 @@ void IRsend::sendRaw(const uint8_t aBufferWithTicks[], uint_fast16_t aLengthOfBu
 
     uint_fast8_t tNumberOfCommands = aNumberOfRepeats + 1;
     while (tNumberOfCommands > 0) {
-        unsigned long tStartOfFrameMillis = millis();
+        unsigned long tStartOfFrameMillis = getMillisForFrameTiming();
         sendRaw(aBufferWithTicks, aLengthOfBuffer, aIRFrequencyKilohertz);
 
         tNumberOfCommands--;
 
         // skip last delay!
         if (tNumberOfCommands > 0) {
-            auto tCurrentFrameDurationMillis = millis() - tStartOfFrameMillis;
+            auto tCurrentFrameDurationMillis = getMillisForFrameTiming() - tStartOfFrameMillis;
             /*
              * Check and fallback for wrong RepeatPeriodMillis parameter. I.e the repeat period must be greater than each frame duration.
              */
             if (aRepeatPeriodMillis > tCurrentFrameDurationMillis) {
-                delay(aRepeatPeriodMillis - tCurrentFrameDurationMillis);
+                delayBetweenFrames(aRepeatPeriodMillis - tCurrentFrameDurationMillis);
             }
         }
     }
@@ -531,19 +726,19 @@ void IRsend::sendRaw_P(const uint16_t aPGMBufferWithMicroseconds[], uint_fast16_
 
     uint_fast8_t tNumberOfCommands = aNumberOfRepeats + 1;
     while (tNumberOfCommands > 0) {
-        unsigned long tStartOfFrameMillis = millis();
+        unsigned long tStartOfFrameMillis = getMillisForFrameTiming();
         sendRaw_P(aPGMBufferWithMicroseconds, aLengthOfBuffer, aIRFrequencyKilohertz);
 
         tNumberOfCommands--;
 
         // skip last delay!
         if (tNumberOfCommands > 0) {
-            auto tCurrentFrameDurationMillis = millis() - tStartOfFrameMillis;
+            auto tCurrentFrameDurationMillis = getMillisForFrameTiming() - tStartOfFrameMillis;
             /*
              * Check and fallback for wrong RepeatPeriodMillis parameter. I.e the repeat period must be greater than each frame duration.
              */
             if (aRepeatPeriodMillis > tCurrentFrameDurationMillis) {
-                delay(aRepeatPeriodMillis - tCurrentFrameDurationMillis);
+                delayBetweenFrames(aRepeatPeriodMillis - tCurrentFrameDurationMillis);
             }
         }
     }
@@ -579,19 +774,19 @@ void IRsend::sendRaw_P(const uint8_t aPGMBufferWithTicks[], uint_fast16_t aLengt
 
     uint_fast8_t tNumberOfCommands = aNumberOfRepeats + 1;
     while (tNumberOfCommands > 0) {
-        unsigned long tStartOfFrameMillis = millis();
+        unsigned long tStartOfFrameMillis = getMillisForFrameTiming();
         sendRaw_P(aPGMBufferWithTicks, aLengthOfBuffer, aIRFrequencyKilohertz);
 
         tNumberOfCommands--;
 
         // skip last delay!
         if (tNumberOfCommands > 0) {
-            auto tCurrentFrameDurationMillis = millis() - tStartOfFrameMillis;
+            auto tCurrentFrameDurationMillis = getMillisForFrameTiming() - tStartOfFrameMillis;
             /*
              * Check and fallback for wrong RepeatPeriodMillis parameter. I.e the repeat period must be greater than each frame duration.
              */
             if (aRepeatPeriodMillis > tCurrentFrameDurationMillis) {
-                delay(aRepeatPeriodMillis - tCurrentFrameDurationMillis);
+                delayBetweenFrames(aRepeatPeriodMillis - tCurrentFrameDurationMillis);
             }
         }
     }
@@ -709,7 +904,7 @@ void IRsend::sendPulseDistanceWidth(uint_fast8_t aFrequencyKHz, uint16_t aHeader
 
     uint_fast8_t tNumberOfCommands = aNumberOfRepeats + 1;
     while (tNumberOfCommands > 0) {
-        unsigned long tStartOfFrameMillis = millis();
+        unsigned long tStartOfFrameMillis = getMillisForFrameTiming();
 
         if (tNumberOfCommands < ((uint_fast8_t) aNumberOfRepeats + 1) && aSpecialSendRepeatFunction != nullptr) {
             // send special repeat
@@ -728,9 +923,9 @@ void IRsend::sendPulseDistanceWidth(uint_fast8_t aFrequencyKHz, uint16_t aHeader
             /*
              * Check and fallback for wrong RepeatPeriodMillis parameter. I.e the repeat period must be greater than each frame duration.
              */
-            auto tFrameDurationMillis = millis() - tStartOfFrameMillis;
+            auto tFrameDurationMillis = getMillisForFrameTiming() - tStartOfFrameMillis;
             if (aRepeatPeriodMillis > tFrameDurationMillis) {
-                delay(aRepeatPeriodMillis - tFrameDurationMillis);
+                delayBetweenFrames(aRepeatPeriodMillis - tFrameDurationMillis);
             }
         }
     }
@@ -761,7 +956,7 @@ void IRsend::sendPulseDistanceWidthFromArray(uint_fast8_t aFrequencyKHz, uint16_
 #endif
 
     while (tNumberOfCommands > 0) {
-        unsigned long tStartOfFrameMillis = millis();
+        unsigned long tStartOfFrameMillis = getMillisForFrameTiming();
 
         // Header
         mark(aHeaderMarkMicros);
@@ -793,9 +988,9 @@ void IRsend::sendPulseDistanceWidthFromArray(uint_fast8_t aFrequencyKHz, uint16_
             /*
              * Check and fallback for wrong RepeatPeriodMillis parameter. I.e the repeat period must be greater than each frame duration.
              */
-            auto tFrameDurationMillis = millis() - tStartOfFrameMillis;
+            auto tFrameDurationMillis = getMillisForFrameTiming() - tStartOfFrameMillis;
             if (aRepeatPeriodMillis > tFrameDurationMillis) {
-                delay(aRepeatPeriodMillis - tFrameDurationMillis);
+                delayBetweenFrames(aRepeatPeriodMillis - tFrameDurationMillis);
             }
         }
     }
@@ -826,7 +1021,7 @@ void IRsend::sendPulseDistanceWidthFromPGMArray(uint_fast8_t aFrequencyKHz, uint
 #endif
 
     while (tNumberOfCommands > 0) {
-        unsigned long tStartOfFrameMillis = millis();
+        unsigned long tStartOfFrameMillis = getMillisForFrameTiming();
 
         // Header
         mark(aHeaderMarkMicros);
@@ -864,9 +1059,9 @@ void IRsend::sendPulseDistanceWidthFromPGMArray(uint_fast8_t aFrequencyKHz, uint
             /*
              * Check and fallback for wrong RepeatPeriodMillis parameter. I.e the repeat period must be greater than each frame duration.
              */
-            auto tFrameDurationMillis = millis() - tStartOfFrameMillis;
+            auto tFrameDurationMillis = getMillisForFrameTiming() - tStartOfFrameMillis;
             if (aRepeatPeriodMillis > tFrameDurationMillis) {
-                delay(aRepeatPeriodMillis - tFrameDurationMillis);
+                delayBetweenFrames(aRepeatPeriodMillis - tFrameDurationMillis);
             }
         }
     }
@@ -928,7 +1123,11 @@ void IRsend::sendPulseDistanceWidth(PulseDistanceWidthProtocolConstants *aProtoc
             /*
              * Send only a special repeat and return
              */
+#if defined(SUPPORT_ENCODE_TO_DURATION_SINK)
+            (this->*aProtocolConstants->SpecialSendRepeatFunction)();
+#else
             aProtocolConstants->SpecialSendRepeatFunction();
+#endif
             return;
         } else {
             // Send only one plain frame (as repeat)
@@ -941,11 +1140,15 @@ void IRsend::sendPulseDistanceWidth(PulseDistanceWidthProtocolConstants *aProtoc
 
     uint_fast8_t tNumberOfCommands = aNumberOfRepeats + 1;
     while (tNumberOfCommands > 0) {
-        unsigned long tStartOfFrameMillis = millis();
+        unsigned long tStartOfFrameMillis = getMillisForFrameTiming();
 
         if (tNumberOfCommands < ((uint_fast8_t) aNumberOfRepeats + 1) && aProtocolConstants->SpecialSendRepeatFunction != nullptr) {
             // send special repeat, if specified and we are not in the first loop
+#if defined(SUPPORT_ENCODE_TO_DURATION_SINK)
+            (this->*aProtocolConstants->SpecialSendRepeatFunction)();
+#else
             aProtocolConstants->SpecialSendRepeatFunction();
+#endif
         } else {
             /*
              * Send Header and regular frame
@@ -959,12 +1162,12 @@ void IRsend::sendPulseDistanceWidth(PulseDistanceWidthProtocolConstants *aProtoc
 
         // skip last delay!
         if (tNumberOfCommands > 0) {
-            auto tCurrentFrameDurationMillis = millis() - tStartOfFrameMillis;
+            auto tCurrentFrameDurationMillis = getMillisForFrameTiming() - tStartOfFrameMillis;
             /*
              * Check and fallback for wrong RepeatPeriodMillis parameter. I.e the repeat period must be greater than each frame duration.
              */
             if (aProtocolConstants->RepeatPeriodMillis > tCurrentFrameDurationMillis) {
-                delay(aProtocolConstants->RepeatPeriodMillis - tCurrentFrameDurationMillis);
+                delayBetweenFrames(aProtocolConstants->RepeatPeriodMillis - tCurrentFrameDurationMillis);
             }
         }
     }
@@ -1009,7 +1212,7 @@ void IRsend::sendPulseDistanceWidthFromArray(PulseDistanceWidthProtocolConstants
 
     uint_fast8_t tNumberOfCommands = aNumberOfRepeats + 1;
     while (tNumberOfCommands > 0) {
-        auto tStartOfFrameMillis = millis();
+        auto tStartOfFrameMillis = getMillisForFrameTiming();
         auto tNumberOfBits = aNumberOfBits; // refresh value for repeats
 
         // Header
@@ -1045,9 +1248,9 @@ void IRsend::sendPulseDistanceWidthFromArray(PulseDistanceWidthProtocolConstants
             /*
              * Check and fallback for wrong RepeatPeriodMillis parameter. I.e the repeat period must be greater than each frame duration.
              */
-            auto tFrameDurationMillis = millis() - tStartOfFrameMillis;
+            auto tFrameDurationMillis = getMillisForFrameTiming() - tStartOfFrameMillis;
             if (aProtocolConstants->RepeatPeriodMillis > tFrameDurationMillis) {
-                delay(aProtocolConstants->RepeatPeriodMillis - tFrameDurationMillis);
+                delayBetweenFrames(aProtocolConstants->RepeatPeriodMillis - tFrameDurationMillis);
             }
         }
     }
@@ -1083,7 +1286,7 @@ void IRsend::sendPulseDistanceWidthFromPGMArray(PulseDistanceWidthProtocolConsta
 
     uint_fast8_t tNumberOfCommands = aNumberOfRepeats + 1;
     while (tNumberOfCommands > 0) {
-        auto tStartOfFrameMillis = millis();
+        auto tStartOfFrameMillis = getMillisForFrameTiming();
         auto tNumberOfBits = aNumberOfBits; // refresh value for repeats
 
         // Header
@@ -1124,9 +1327,9 @@ void IRsend::sendPulseDistanceWidthFromPGMArray(PulseDistanceWidthProtocolConsta
             /*
              * Check and fallback for wrong RepeatPeriodMillis parameter. I.e the repeat period must be greater than each frame duration.
              */
-            auto tFrameDurationMillis = millis() - tStartOfFrameMillis;
+            auto tFrameDurationMillis = getMillisForFrameTiming() - tStartOfFrameMillis;
             if (aProtocolConstants->RepeatPeriodMillis > tFrameDurationMillis) {
-                delay(aProtocolConstants->RepeatPeriodMillis - tFrameDurationMillis);
+                delayBetweenFrames(aProtocolConstants->RepeatPeriodMillis - tFrameDurationMillis);
             }
         }
     }
@@ -1163,6 +1366,100 @@ void IRsend::sendPulseDistanceWidth_P(PulseDistanceWidthProtocolConstants const
     sendPulseDistanceWidth(&tTemporaryPulseDistanceWidthProtocolConstants, aData, aNumberOfBits, aNumberOfRepeats);
 }
 
+/**********************************************************************************************************************
+ * Send functions with compile time PulseDistanceWidthProtocolDescriptor template parameter
+ * Each used descriptor generates its own send loop with constant timing and bit order.
+ * This saves the flag evaluation for each bit and program memory if only one or two protocols are sent.
+ **********************************************************************************************************************/
+/**
+ * Sends PulseDistance data with timing and flags from the template parameter.
+ * Generates the same output as sendPulseDistanceWidthData(aOneMarkMicros, ..., aFlags)
+ * The output always ends with a space
+ * @tparam ProtocolDescriptor   A PulseDistanceWidthProtocolDescriptor<> type like NECProtocolDescriptor.
+ * @param aData                 uint32 or uint64 holding the bits to be sent.
+ * @param aNumberOfBits         Number of bits from aData to be actually sent.
+ */
+template<typename ProtocolDescriptor>
+void IRsend::sendPulseDistanceWidthData(IRDecodedRawDataType aData, uint_fast8_t aNumberOfBits) {
+
+    DEBUG_PRINT(aData, HEX);
+    DEBUG_PRINT('|');
+    DEBUG_PRINTLN(aNumberOfBits);
+    DEBUG_FLUSH();
+
+    IRDecodedRawDataType tMask = 1ULL << (aNumberOfBits - 1);
+    for (uint_fast8_t i = aNumberOfBits; i > 0; i--) {
+        bool tBitIsOne;
+        if (ProtocolDescriptor::isMSBFirst) {
+            tBitIsOne = aData & tMask;
+            tMask >>= 1;
+        } else {
+            tBitIsOne = aData & 1;
+            aData >>= 1;
+        }
+        if (tBitIsOne) {
+            TRACE_PRINT('1');
+            mark(ProtocolDescriptor::OneMarkMicros);
+            space(ProtocolDescriptor::OneSpaceMicros);
+        } else {
+            TRACE_PRINT('0');
+            mark(ProtocolDescriptor::ZeroMarkMicros);
+            space(ProtocolDescriptor::ZeroSpaceMicros);
+        }
+    }
+    if (ProtocolDescriptor::hasStopBit) {
+        TRACE_PRINT('S');
+        mark(ProtocolDescriptor::OneMarkMicros);
+    }
+    TRACE_PRINTLN();
+}
+
+/**
+ * Sends PulseDistance frames and repeats with timing and flags from the template parameter.
+ * Generates the same output as sendPulseDistanceWidth_P(&<Protocol>ProtocolConstants, ...)
+ * Usage: IrSender.sendPulseDistanceWidth<NECProtocolDescriptor>(computeNECRawDataAndChecksum(0x12, 0x34), NEC_BITS, 0);
+ * @tparam ProtocolDescriptor   A PulseDistanceWidthProtocolDescriptor<> type like NECProtocolDescriptor.
+ * @param aNumberOfRepeats      If < 0 and a special repeat function is specified in the descriptor
+ *                              then it is called without leading and trailing space.
+ */
+template<typename ProtocolDescriptor>
+void IRsend::sendPulseDistanceWidth(IRDecodedRawDataType aData, uint_fast8_t aNumberOfBits, int_fast8_t aNumberOfRepeats) {
+
+    if (aNumberOfRepeats < 0) {
+        if (ProtocolDescriptor::hasSpecialRepeat()) {
+            ProtocolDescriptor::sendSpecialRepeat(this);
+            return;
+        } else {
+            aNumberOfRepeats = 0;
+        }
+    }
+
+    // Set IR carrier frequency
+    enableIROut(ProtocolDescriptor::FrequencyKHz);
+
+    uint_fast8_t tNumberOfCommands = aNumberOfRepeats + 1;
+    while (tNumberOfCommands > 0) {
+        unsigned long tStartOfFrameMillis = getMillisForFrameTiming();
+
+        if (ProtocolDescriptor::hasSpecialRepeat() && tNumberOfCommands < ((uint_fast8_t) aNumberOfRepeats + 1)) {
+            ProtocolDescriptor::sendSpecialRepeat(this);
+        } else {
+            mark(ProtocolDescriptor::HeaderMarkMicros);
+            space(ProtocolDescriptor::HeaderSpaceMicros);
+            sendPulseDistanceWidthData<ProtocolDescriptor>(aData, aNumberOfBits);
+        }
+
+        tNumberOfCommands--;
+        // skip last delay!
+        if (tNumberOfCommands > 0) {
+            auto tCurrentFrameDurationMillis = getMillisForFrameTiming() - tStartOfFrameMillis;
+            if (ProtocolDescriptor::RepeatPeriodMillis > tCurrentFrameDurationMillis) {
+                delayBetweenFrames(ProtocolDescriptor::RepeatPeriodMillis - tCurrentFrameDurationMillis);
+            }
+        }
+    }
+}
+
 /**
  * Sends Biphase (Manchester) coded data MSB first
  * This function concatenates two marks to one longer mark,
@@ -1229,6 +1526,65 @@ void IRsend::sendBiphaseData(uint16_t aBiphaseTimeUnit, uint32_t aData, uint_fas
     TRACE_PRINTLN();
 }
 
+/**
+ * Appends a mark or space to a list of durations for sendRaw(), which starts with a mark.
+ * If the last duration in the list has the same level, the duration is added to it.
+ * A leading space is skipped, since the output is inactive before the first mark anyway.
+ * @param aDurationsMicros      Buffer of BIPHASE_DURATIONS_BUFFER_LENGTH entries.
+ * @param aNumberOfDurations    The current number of durations or BIPHASE_DURATIONS_OVERFLOW, which is returned unchanged.
+ * @param aLevel                MARK or SPACE
+ * @return The new number of durations in aDurationsMicros or BIPHASE_DURATIONS_OVERFLOW if the duration does not fit into the buffer.
+ */
+uint_fast8_t IRsend::appendMarkOrSpace(uint16_t aDurationsMicros[], uint_fast8_t aNumberOfDurations, uint_fast8_t aLevel,
+        uint16_t aDurationMicros) {
+    if (aNumberOfDurations == BIPHASE_DURATIONS_OVERFLOW) {
+        return BIPHASE_DURATIONS_OVERFLOW; // keep the error of a previous call
+    }
+    /*
+     * Even indexes are marks, so the level of the last entry is MARK if aNumberOfDurations is odd.
+     * For an empty list, this gives SPACE, so a leading space is added to nothing.
+     */
+    if ((aNumberOfDurations & 1) == aLevel) {
+        if (aNumberOfDurations > 0) {
+            aDurationsMicros[aNumberOfDurations - 1] += aDurationMicros;
+        }
+    } else if (aNumberOfDurations < BIPHASE_DURATIONS_BUFFER_LENGTH) {
+        aDurationsMicros[aNumberOfDurations++] = aDurationMicros;
+    } else {
+        return BIPHASE_DURATIONS_OVERFLOW;
+    }
+    return aNumberOfDurations;
+}
+
+/**
+ * Appends the mark and space durations of Biphase (Manchester) coded data MSB first to a list of durations for sendRaw().
+ * Adjacent half bits of the same level are merged to one duration, so the list can be sent without any computing between the bits.
+ * In contrast to sendBiphaseData(), no start bit is added and the last half bit is always appended, even if it is a space.
+ * @param aData                 uint64 holding the bits to be sent.
+ * @param aNumberOfBits         Number of bits from aData to be actually sent. 0 to 64, 0 appends nothing.
+ * @param aOneIsMarkSpace       true if 1 is sent as mark+space (RC6), false if 1 is sent as space+mark (RC5).
+ * @param aDoubleWidthBitIndex  Index of the bit with double timing, counted from 0 for the first bit sent, like the RC6 toggle bit.
+ * @return The new number of durations in aDurationsMicros or BIPHASE_DURATIONS_OVERFLOW if they do not fit into the buffer
+ *         or aNumberOfBits is greater than 64.
+ */
+uint_fast8_t IRsend::appendBiphaseData(uint16_t aDurationsMicros[], uint_fast8_t aNumberOfDurations, uint16_t aBiphaseTimeUnit,
+        uint64_t aData, uint_fast8_t aNumberOfBits, bool aOneIsMarkSpace, uint_fast8_t aDoubleWidthBitIndex) {
+    if (aNumberOfBits == 0) {
+        return aNumberOfDurations; // 1ULL << -1 is undefined
+    }
+    if (aNumberOfBits > 64) {
+        return BIPHASE_DURATIONS_OVERFLOW;
+    }
+    uint64_t tMask = 1ULL << (aNumberOfBits - 1);
+    for (uint_fast8_t i = 0; i < aNumberOfBits; i++, tMask >>= 1) {
+        uint_fast8_t tFirstHalfBitLevel = (((aData & tMask) != 0) == aOneIsMarkSpace) ? MARK : SPACE;
+        uint16_t tHalfBitDuration = (i == aDoubleWidthBitIndex) ? (2 * aBiphaseTimeUnit) : aBiphaseTimeUnit;
+        aNumberOfDurations = appendMarkOrSpace(aDurationsMicros, aNumberOfDurations, tFirstHalfBitLevel, tHalfBitDuration);
+        aNumberOfDurations = appendMarkOrSpace(aDurationsMicros, aNumberOfDurations, tFirstHalfBitLevel ^ 1, tHalfBitDuration);
+    }
+    return aNumberOfDurations;
+}
+
 /**
  * Sends an IR mark for the specified number of microseconds.
  * The mark output is modulated at the PWM frequency if USE_NO_SEND_PWM is not defined.
@@ -1246,6 +1602,19 @@ void IRsend::sendBiphaseData(uint16_t aBiphaseTimeUnit, uint32_t aData, uint_fas
  */
 void IRsend::mark(uint16_t aMarkMicros) {
 
+#if defined(SUPPORT_ENCODE_TO_DURATION_SINK)
+    if (durationSinkForEncode != nullptr) {
+        durationSinkForEncode->mark(aMarkMicros);
+        encodedSignalMicros += aMarkMicros;
+        return;
+    }
+#endif
+
+#if defined(IR_SEND_BACKEND)
+    IR_SEND_BACKEND::mark(aMarkMicros);
+
+#else // defined(IR_SEND_BACKEND)
+
 #if defined(SEND_PWM_BY_TIMER) || defined(USE_NO_SEND_PWM)
 #  if defined(LED_SEND_FEEDBACK_CODE)
     setFeedbackLED(true);
@@ -1301,6 +1670,11 @@ void IRsend::mark(uint16_t aMarkMicros) {
          * Output the PWM pulse - IR LED is active
          ****************************************/
         noInterrupts(); // do not let interrupts extend the short on period
+#  if defined(USE_MULTIPLE_SEND_PINS)
+        if (numberOfSendPins > 0) {
+            writeSendPins(true);
+        } else // single pin is handled by the code below
+#  endif
 #  if defined(USE_OPEN_DRAIN_OUTPUT_FOR_SEND_PIN) || defined(USE_ACTIVE_LOW_OUTPUT_FOR_SEND_PIN)
 #    if defined(USE_ACTIVE_LOW_OUTPUT_FOR_SEND_PIN) || defined(OUTPUT_OPEN_DRAIN)
         if (__builtin_constant_p(sendPin)) {
@@ -1330,6 +1704,11 @@ void IRsend::mark(uint16_t aMarkMicros) {
         /*******************************************
          * Output the PWM pause - IR LED is inactive
          ******************************************/
+#  if defined(USE_MULTIPLE_SEND_PINS)
+        if (numberOfSendPins > 0) {
+            writeSendPins(false);
+        } else // single pin is handled by the code below
+#  endif
 #  if defined(USE_OPEN_DRAIN_OUTPUT_FOR_SEND_PIN) || defined(USE_ACTIVE_LOW_OUTPUT_FOR_SEND_PIN)
 #    if defined(USE_ACTIVE_LOW_OUTPUT_FOR_SEND_PIN) || defined(OUTPUT_OPEN_DRAIN)
         if (__builtin_constant_p(sendPin)) {
@@ -1406,6 +1785,7 @@ void IRsend::mark(uint16_t aMarkMicros) {
         } while (tMicros < tMicrosOfEndOfNextPWMPause); // = End of one PWM period
     } while (true);
 #  endif
+#endif // defined(IR_SEND_BACKEND)
 }
 
 /**
@@ -1414,7 +1794,14 @@ void IRsend::mark(uint16_t aMarkMicros) {
  * This function may affect the state of feedback LED.
  */
 void IRsend::IRLedOff() {
-#if defined(SEND_PWM_BY_TIMER)
+#if defined(SUPPORT_ENCODE_TO_DURATION_SINK)
+    if (durationSinkForEncode != nullptr) {
+        return;
+    }
+#endif
+#if defined(IR_SEND_BACKEND)
+    IR_SEND_BACKEND::IRLedOff();
+#elif defined(SEND_PWM_BY_TIMER)
     disableSendPWMByTimer(); // Disable PWM output
 #elif defined(USE_NO_SEND_PWM)
 #  if defined(USE_OPEN_DRAIN_OUTPUT_FOR_SEND_PIN) && !defined(OUTPUT_OPEN_DRAIN)
@@ -1426,6 +1813,13 @@ void IRsend::IRLedOff() {
     digitalWriteFast(sendPin, HIGH); // Set output to inactive high.
 #  endif
 #else
+#  if defined(USE_MULTIPLE_SEND_PINS)
+    if (numberOfSendPins > 0) {
+        noInterrupts(); // for port register read modify write
+        writeSendPins(false);
+        interrupts();
+    } else // single pin is handled by the code below
+#  endif
 #  if defined(USE_OPEN_DRAIN_OUTPUT_FOR_SEND_PIN) || defined(USE_ACTIVE_LOW_OUTPUT_FOR_SEND_PIN)
 #    if defined(USE_ACTIVE_LOW_OUTPUT_FOR_SEND_PIN) || defined(OUTPUT_OPEN_DRAIN)
     if (__builtin_constant_p(sendPin)) {
@@ -1445,7 +1839,7 @@ void IRsend::IRLedOff() {
 #  endif
 #endif
 
-#if defined(LED_SEND_FEEDBACK_CODE)
+#if defined(LED_SEND_FEEDBACK_CODE) && !defined(IR_SEND_BACKEND)
     setFeedbackLED(false);
 #endif
 }
@@ -1456,7 +1850,18 @@ void IRsend::IRLedOff() {
  * Executing program between end of mark and start of next mark uses around 15 to 20 us @ 16 MHz. This time is added to the space delay here.
  */
 void IRsend::space(uint16_t aSpaceMicros) {
+#if defined(SUPPORT_ENCODE_TO_DURATION_SINK)
+    if (durationSinkForEncode != nullptr) {
+        durationSinkForEncode->space(aSpaceMicros);
+        encodedSignalMicros += aSpaceMicros;
+        return;
+    }
+#endif
+#if defined(IR_SEND_BACKEND)
+    IR_SEND_BACKEND::space(aSpaceMicros);
+#else
     customDelayMicroseconds(aSpaceMicros);
+#endif
 }
 
 /**
@@ -1496,8 +1901,22 @@ void IRsend::customDelayMicroseconds(unsigned long aMicroseconds) {
  * If IR_SEND_PIN is defined, maximum PWM frequency for an AVR @16 MHz is 170 kHz (180 kHz if NO_LED_SEND_FEEDBACK_CODE is defined)
  */
 void IRsend::enableIROut(uint_fast8_t aFrequencyKHz) {
+#if defined(SUPPORT_ENCODE_TO_DURATION_SINK)
+    if (durationSinkForEncode != nullptr) {
+        durationSinkForEncode->setFrequency(aFrequencyKHz);
+        return;
+    }
+#endif
+#if defined(IR_SEND_BACKEND)
+    IR_SEND_BACKEND::enableIROut(aFrequencyKHz);
+
+#else // defined(IR_SEND_BACKEND)
+
 #if defined(SEND_PWM_BY_TIMER)
     timerConfigForSend(aFrequencyKHz); // must set output pin mode and disable receive interrupt if required, e.g. uses the same resource
+#  if defined(USE_LOW_POWER_IDLE_FOR_RECEIVE) && !defined(DISABLE_CODE_FOR_RECEIVER) && !defined(SEND_PWM_DOES_NOT_USE_RECEIVE_TIMER)
+    sReceiveTimerIsParked = false; // The wake up interrupt must not enable the receive interrupt of the timer used for sending
+#  endif
 
 #elif defined(USE_NO_SEND_PWM)
     (void) aFrequencyKHz;
@@ -1531,23 +1950,44 @@ void IRsend::enableIROut(uint_fast8_t aFrequencyKHz) {
     } else {
         pinMode(sendPin, OUTPUT);
     }
+#      if defined(USE_MULTIPLE_SEND_PINS)
+    for (uint_fast8_t i = 1; i < numberOfSendPins; i++) {
+        pinMode(sendPins[i], OUTPUT);
+    }
+#      endif
 #    endif
 #  endif
 #endif // defined(USE_OPEN_DRAIN_OUTPUT_FOR_SEND_PIN)
+#endif // defined(IR_SEND_BACKEND)
 }
 
-#if defined(SEND_PWM_BY_TIMER)
+#if defined(SEND_PWM_BY_TIMER) || defined(IR_SEND_BACKEND) || defined(SUPPORT_ENCODE_TO_DURATION_SINK)
 // Used for Bang&Olufsen
 void IRsend::enableHighFrequencyIROut(uint_fast16_t aFrequencyKHz) {
+#  if defined(SUPPORT_ENCODE_TO_DURATION_SINK)
+    if (durationSinkForEncode != nullptr) {
+        durationSinkForEncode->setFrequency(aFrequencyKHz);
+        return;
+    }
+#  endif
+#  if defined(IR_SEND_BACKEND)
+    IR_SEND_BACKEND::enableIROut(aFrequencyKHz);
+#  elif defined(SEND_PWM_BY_TIMER)
     timerConfigForSend(aFrequencyKHz); // must set output pin mode and disable receive interrupt if required, e.g. uses the same resource
+#    if defined(USE_LOW_POWER_IDLE_FOR_RECEIVE) && !defined(DISABLE_CODE_FOR_RECEIVER) && !defined(SEND_PWM_DOES_NOT_USE_RECEIVE_TIMER)
+    sReceiveTimerIsParked = false; // The wake up interrupt must not enable the receive interrupt of the timer used for sending
+#    endif
     // For Non AVR platforms pin mode for SEND_PWM_BY_TIMER must be handled by the timerConfigForSend() function
     // because ESP 2.0.2 ledcWrite does not work if pin mode is set, and RP2040 requires gpio_set_function(IR_SEND_PIN, GPIO_FUNC_PWM);
-#  if defined(__AVR__)
-#    if defined(IR_SEND_PIN)
+#    if defined(__AVR__)
+#      if defined(IR_SEND_PIN)
     pinModeFast(IR_SEND_PIN, OUTPUT);
-#    else
+#      else
     pinModeFast(sendPin, OUTPUT);
+#      endif
 #    endif
+#  else
+    (void) aFrequencyKHz; // Software PWM does not support high frequencies, only encode() is possible
 #  endif
 }
 #endif
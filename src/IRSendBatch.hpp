@@ -0,0 +1,109 @@
+/**
+ * @file IRSendBatch.hpp
+ *
+ * @brief Sending of a sequence of frames with the minimal gap of each protocol.
+ * It is included after the protocol files, because it uses their timing constants.
+ *
+ *  This file is part of Arduino-IRremote https://github.com/Arduino-IRremote/Arduino-IRremote.
+ *
+ *************************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2026 Armin Joachimsmeyer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ ************************************************************************************
+ */
+#ifndef _IR_SEND_BATCH_HPP
+#define _IR_SEND_BATCH_HPP
+
+/** \addtogroup Sending Sending IR data for multiple protocols
+ * @{
+ */
+
+/**
+ * Returns the gap between the end of a frame and the start of the next frame, which is used by the remotes of the protocol
+ * for repeats. It is taken from the repeat distance or the repeat period minus the (average) frame duration of the protocol.
+ * A shorter gap may be rejected by the receiving device, or the next frame may be interpreted as a repeat.
+ * @return The gap for aProtocol or IR_BATCH_GAP_MICROS for protocols without repeat timing constants.
+ */
+uint32_t IRsend::getMinimumFrameGapMicros(decode_type_t aProtocol) {
+    if (aProtocol == NEC || aProtocol == NEC2 || aProtocol == APPLE || aProtocol == ONKYO || aProtocol == OPENLASIR) {
+        return NEC_REPEAT_DISTANCE;
+    } else if (aProtocol == SAMSUNG || aProtocol == SAMSUNGLG || aProtocol == SAMSUNG48) {
+        return SAMSUNG_REPEAT_PERIOD - SAMSUNG_AVERAGE_DURATION;
+    } else if (aProtocol == LG) {
+        return LG_REPEAT_DISTANCE;
+    } else if (aProtocol == SONY) {
+        return SONY_REPEAT_PERIOD - SONY_DURATION_MIN;
+    } else if (aProtocol == PANASONIC || (aProtocol >= KASEIKYO && aProtocol <= KASEIKYO_MITSUBISHI)) {
+        return KASEIKYO_REPEAT_DISTANCE;
+    } else if (aProtocol == DENON || aProtocol == SHARP) {
+        return DENON_AUTO_REPEAT_DISTANCE;
+    } else if (aProtocol == JVC) {
+        return JVC_REPEAT_DISTANCE;
+    } else if (aProtocol == RC5) {
+        return RC5_REPEAT_DISTANCE;
+    } else if (aProtocol == MARANTZ) {
+        return MARANTZ_REPEAT_DISTANCE;
+    } else if (aProtocol == RC6 || aProtocol == RC6A) {
+        return RC6_REPEAT_DISTANCE;
+    } else if (aProtocol == BOSEWAVE) {
+        return BOSEWAVE_REPEAT_DISTANCE;
+    } else if (aProtocol == FAST) {
+        return FAST_REPEAT_DISTANCE;
+    } else if (aProtocol == LEGO_PF) {
+        return LEGO_AUTO_REPEAT_PERIOD_MIN - LEGO_AVERAGE_DURATION;
+    }
+    return IR_BATCH_GAP_MICROS;
+}
+
+/**
+ * Sends a sequence of frames e.g. for a scene like TV on, AVR input and projector power, as fast as possible.
+ * Instead of a fixed delay between the frames, the next frame is started getMinimumFrameGapMicros() of the protocol
+ * of the previous frame after the end of the previous frame (including its repeats).
+ * The end of each frame is taken by micros(), so the time for computing the next frame is part of the gap.
+ * There is NO delay after the last frame!
+ * @param aIRSendDataArray  Array of frames to be sent, each frame is sent by write().
+ * @param aNumberOfFrames   Number of entries in aIRSendDataArray.
+ * @param aNumberOfRepeats  Number of repeats for each frame. Repeats are sent with the repeat period of the protocol.
+ * @return Number of frames sent. Frames with protocols not supported by write() are skipped.
+ */
+size_t IRsend::writeBatch(IRData const aIRSendDataArray[], uint_fast8_t aNumberOfFrames, int_fast8_t aNumberOfRepeats) {
+    size_t tNumberOfFramesSent = 0;
+    unsigned long tMicrosAtEndOfLastFrame = 0;
+    uint32_t tGapMicros = 0;
+    for (uint_fast8_t i = 0; i < aNumberOfFrames; i++) {
+        if (tNumberOfFramesSent > 0) {
+            // overflow invariant comparison
+            while (micros() - tMicrosAtEndOfLastFrame < tGapMicros) {
+            }
+        }
+        if (write(&aIRSendDataArray[i], aNumberOfRepeats) > 0) {
+            tMicrosAtEndOfLastFrame = micros();
+            tGapMicros = getMinimumFrameGapMicros(aIRSendDataArray[i].protocol);
+            tNumberOfFramesSent++;
+        }
+    }
+    return tNumberOfFramesSent;
+}
+
+/** @}*/
+
+#endif // _IR_SEND_BATCH_HPP
@@ -0,0 +1,209 @@
+/**
+ * @file IRSendRecordingBackend.hpp
+ *
+ * @brief Send backend, which does not generate any output but records the mark and space durations with timestamps.
+ * It is activated by #define USE_SEND_RECORDING_BACKEND and can be used to check the timing of the encoders
+ * and to measure their throughput, even on a host without IR hardware.
+ *
+ *  This file is part of Arduino-IRremote https://github.com/Arduino-IRremote/Arduino-IRremote.
+ *
+ *************************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2026 Armin Joachimsmeyer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ ************************************************************************************
+ */
+#ifndef _IR_SEND_RECORDING_BACKEND_HPP
+#define _IR_SEND_RECORDING_BACKEND_HPP
+
+/** \addtogroup Sending Sending IR data for multiple protocols
+ * @{
+ */
+
+#if !defined(SEND_RECORDING_BUFFER_LENGTH)
+#define SEND_RECORDING_BUFFER_LENGTH    RAW_BUFFER_LENGTH
+#endif
+
+/**
+ * One recorded mark or space
+ */
+struct IRSendRecordEntry {
+    uint32_t SignalMicros;  ///< Start of this mark or space, relative to the start of the recording. It is the sum of all durations before.
+    uint32_t DurationMicros; ///< 32 bit, since merged durations and gaps between repeats can exceed 65535 us
+    bool isMark;
+};
+
+/**
+ * Implements the send backend interface by recording all durations instead of generating output.
+ * No time is spent in mark() and space(), so sending runs at full CPU speed.
+ * Consecutive marks or consecutive spaces are merged to one entry.
+ * The gaps between repeats are recorded as spaces by recordGap(), which is called instead of delay() between the frames.
+ * The frame timing of the send functions is then based on SignalMicros instead of millis().
+ */
+class IRSendRecordingBackend {
+public:
+    static void enableIROut(uint_fast16_t aFrequencyKHz);
+    static void mark(uint16_t aMarkMicros);
+    static void IRLedOff();
+    static void space(uint16_t aSpaceMicros);
+    static void recordGap(uint32_t aGapMicros);
+
+    static void reset();
+    static uint32_t getRecordingDurationMicros();
+    static uint32_t getComputationDurationMicros();
+    static void printRecording(Print *aSerial);
+
+    static IRSendRecordEntry Entries[SEND_RECORDING_BUFFER_LENGTH];
+    static uint16_t NumberOfEntries;
+    static uint16_t FrequencyKHz;           ///< The value of the last enableIROut() call
+    static uint32_t SignalMicros;           ///< The sum of all recorded durations
+    static uint32_t MicrosAtFirstRecord;    ///< Value of micros() at the first mark() or space() after reset()
+    static uint32_t MicrosAtLastRecord;     ///< Value of micros() at the last mark() or space()
+    static bool hasOverflow;                ///< Set if more than SEND_RECORDING_BUFFER_LENGTH entries were sent
+private:
+    static void record(uint32_t aDurationMicros, bool aIsMark);
+};
+
+IRSendRecordEntry IRSendRecordingBackend::Entries[SEND_RECORDING_BUFFER_LENGTH];
+uint16_t IRSendRecordingBackend::NumberOfEntries = 0;
+uint16_t IRSendRecordingBackend::FrequencyKHz = 0;
+uint32_t IRSendRecordingBackend::SignalMicros = 0;
+uint32_t IRSendRecordingBackend::MicrosAtFirstRecord = 0;
+uint32_t IRSendRecordingBackend::MicrosAtLastRecord = 0;
+bool IRSendRecordingBackend::hasOverflow = false;
+
+void IRSendRecordingBackend::enableIROut(uint_fast16_t aFrequencyKHz) {
+    FrequencyKHz = aFrequencyKHz;
+}
+
+void IRSendRecordingBackend::mark(uint16_t aMarkMicros) {
+    record(aMarkMicros, true);
+}
+
+/*
+ * A space is "no output", so nothing to record here
+ */
+void IRSendRecordingBackend::IRLedOff() {
+}
+
+void IRSendRecordingBackend::space(uint16_t aSpaceMicros) {
+    record(aSpaceMicros, false);
+}
+
+/**
+ * Records the gap between two repeats, which is generated by delay() for the other backends
+ */
+void IRSendRecordingBackend::recordGap(uint32_t aGapMicros) {
+    record(aGapMicros, false);
+}
+
+void IRSendRecordingBackend::record(uint32_t aDurationMicros, bool aIsMark) {
+    uint32_t tMicros = micros();
+    if (NumberOfEntries == 0 && !hasOverflow) {
+        MicrosAtFirstRecord = tMicros;
+    }
+    MicrosAtLastRecord = tMicros;
+
+    if (NumberOfEntries > 0 && Entries[NumberOfEntries - 1].isMark == aIsMark) {
+        // merge with previous entry
+        Entries[NumberOfEntries - 1].DurationMicros += aDurationMicros;
+    } else if (NumberOfEntries < SEND_RECORDING_BUFFER_LENGTH) {
+        IRSendRecordEntry *tEntry = &Entries[NumberOfEntries++];
+        tEntry->SignalMicros = SignalMicros;
+        tEntry->DurationMicros = aDurationMicros;
+        tEntry->isMark = aIsMark;
+    } else {
+        hasOverflow = true;
+    }
+    SignalMicros += aDurationMicros;
+}
+
+/**
+ * Clears the recording. Must be called before sending the next frame(s) to be recorded.
+ */
+void IRSendRecordingBackend::reset() {
+    NumberOfEntries = 0;
+    SignalMicros = 0;
+    hasOverflow = false;
+}
+
+/**
+ * @return The duration of the recorded signal, i.e. the sum of all marks and spaces
+ */
+uint32_t IRSendRecordingBackend::getRecordingDurationMicros() {
+    return SignalMicros;
+}
+
+/**
+ * @return The (real) time between first and last record call, i.e. the time the encoder required to generate the signal.
+ */
+uint32_t IRSendRecordingBackend::getComputationDurationMicros() {
+    return MicrosAtLastRecord - MicrosAtFirstRecord;
+}
+
+/**
+ * Prints the recorded durations in the same format as printIRResultRawFormatted(), followed by the signal and computation duration.
+ */
+void IRSendRecordingBackend::printRecording(Print *aSerial) {
+    aSerial->print(F("Recorded "));
+    aSerial->print(NumberOfEntries);
+    aSerial->print(F(" durations with "));
+    aSerial->print(FrequencyKHz);
+    aSerial->println(F(" kHz:"));
+    for (uint16_t i = 0; i < NumberOfEntries; i++) {
+        uint32_t tDuration = Entries[i].DurationMicros;
+        if (Entries[i].isMark) {
+            aSerial->print(F(" +"));
+        } else {
+            aSerial->print('-');
+        }
+        // padding only for big values
+        if (tDuration < 1000) {
+            aSerial->print(' ');
+        }
+        if (tDuration < 100) {
+            aSerial->print(' ');
+        }
+        if (tDuration < 10) {
+            aSerial->print(' ');
+        }
+        aSerial->print(tDuration);
+        if (Entries[i].isMark && (i + 1) < NumberOfEntries) {
+            aSerial->print(','); //',' not required for last one
+        }
+        if (!Entries[i].isMark && (i % 8) == 7) {
+            aSerial->println();
+        }
+    }
+    aSerial->println();
+    if (hasOverflow) {
+        aSerial->println(F("Overflow happened, try to increase SEND_RECORDING_BUFFER_LENGTH"));
+    }
+    aSerial->print(F("Signal duration="));
+    aSerial->print(getRecordingDurationMicros());
+    aSerial->print(F(" us, computed in "));
+    aSerial->print(getComputationDurationMicros());
+    aSerial->println(F(" us"));
+}
+
+/** @}*/
+
+#endif // _IR_SEND_RECORDING_BACKEND_HPP
@@ -45,18 +45,23 @@
  * For more details see: https://github.com/Arduino-IRremote/Arduino-IRremote#compile-options--macros-for-this-library
  *
  * - RAW_BUFFER_LENGTH                  Buffer size of raw input buffer. Must be even! 100 is sufficient for *regular* protocols of up to 48 bits.
+ * - IR_PAYLOAD_POOL_SIZE               Number of payloads in an IRPayloadPool for IRDecodedEvent data wider than 32 bits.
  * - IR_SEND_PIN                        If specified (as constant), reduces program size and improves send timing for AVR.
  * - USE_ACTIVE_LOW_OUTPUT_FOR_SEND_PIN Reverts the polarity at the send pin.
  * - USE_OPEN_DRAIN_OUTPUT_FOR_SEND_PIN Use or simulate open drain output mode at send pin. Attention, active state of open drain is LOW, so connect the send LED between positive supply and send pin!
  * - SEND_PWM_BY_TIMER                  Disable carrier PWM generation in software and use (restricted) hardware PWM.
  * - USE_NO_SEND_PWM                    Use no carrier PWM, just simulate an **active low** receiver signal. Overrides SEND_PWM_BY_TIMER definition.
  * - USE_ACTIVE_HIGH_OUTPUT_FOR_NO_SEND_PWM  Simulate an **active high** receiver signal instead of an active low signal.
+ * - USE_BIPHASE_DURATION_LIST_FOR_SEND Compute the merged mark and space durations of RC5, Marantz and RC6 before sending them.
+ * - SUPPORT_ENCODE_TO_DURATION_SINK    Enables IrSender.encode(), which generates the marks and spaces of a frame for an IRDurationSink instead of sending them.
  * - EXCLUDE_EXOTIC_PROTOCOLS           If activated, BANG_OLUFSEN, BOSEWAVE, WHYNTER, FAST and LEGO_PF are excluded in decode() and in sending with IrSender.write().
  * - EXCLUDE_UNIVERSAL_PROTOCOLS        If activated, the universal decoder for pulse distance protocols and decodeHash (special decoder for all protocols) are excluded in decode().
  * - DECODE_*                           Selection of individual protocols to be decoded. See below.
  * - USE_THRESHOLD_DECODER              May give slightly better results especially for jittering signals and protocols with short 1 pulses / pauses.
  * - MARK_EXCESS_MICROS                 Value is subtracted from all marks and added to all spaces before decoding, to compensate for the signal forming of different IR receiver modules.
  * - RECORD_GAP_MICROS                  Minimum gap between IR transmissions, to detect the end of a protocol.
+ * - MINIMUM_PULSE_MICROS               Activates the glitch filter. Shorter marks and spaces are merged with the surrounding interval.
+ * - USE_LOW_POWER_IDLE_FOR_RECEIVE     Stops the receive timer after the gap and restarts it by a pin change interrupt at the next frame.
  * - FEEDBACK_LED_IS_ACTIVE_LOW         Required on some boards (like my BluePill and my ESP8266 board), where the feedback LED is active low.
  * - NO_LED_FEEDBACK_CODE               This completely disables the LED feedback code for send and receive.
  * - NO_LED_RECEIVE_FEEDBACK_CODE       This disables the LED feedback code for receive.
@@ -64,6 +69,12 @@
  * - IR_INPUT_IS_ACTIVE_HIGH            Enable it if you use a RF receiver, which has an active HIGH output signal.
  * - IR_SEND_DUTY_CYCLE_PERCENT         Duty cycle of IR send signal.
  * - MICROS_PER_TICK                    Resolution of the raw input buffer data. Corresponds to 2 pulses of each 26.3 us at 38 kHz.
+ * - USE_RUNTIME_MICROS_PER_TICK        Resolution of the raw input buffer data is set by setMicrosPerTick() at runtime.
+ * - LONG_INTERVALS_BUFFER_LENGTH       Number of marks or spaces longer than 12750 us, which keep their exact value with the 8 bit timing buffer.
+ * - USE_PROTOCOL_SPECIFIC_FRAME_GAP    Ends Bang & Olufsen frames by a longer gap than RECORD_GAP_MICROS, so B&O can be decoded together with Sony.
+ * - SUPPORT_RUNTIME_PROTOCOL_SELECTION Enables and disables protocols for decode() at runtime.
+ * - SUPPORT_DECODER_PROFILING          Collects call count, hit count and durations of each decoder called by decode().
+ * - SUPPORT_RECEIVER_CALIBRATION       Collects the timing deviations of the receiver module and sets MARK_EXCESS_MICROS and the tolerance at runtime.
  * - IR_USE_AVR_TIMER*                  Selection of timer to be used for generating IR receiving sample interval.
  */
 
@@ -124,15 +135,118 @@
 // Maximum value for RECORD_GAP_MICROS, which fit into 8 bit buffer, using 50 us as tick, is 12750
 #define RECORD_GAP_MICROS   8000 // RECS80 (https://www.mikrocontroller.net/articles/IRMP#RECS80) 1 bit space is 7500µs , NEC header space is 4500
 #endif
+
+/**
+ * Define to select the resolution of the receive timer at runtime by IrReceiver.setMicrosPerTick() before begin().
+ * E.g. 10 to 25 us for precise raw data and short unit protocols, or 100 us for minimal ISR load. The default is 50 us.
+ * Then MICROS_PER_TICK and all values derived from it are variables and the 16 bit timing buffer is used.
+ */
+//#define USE_RUNTIME_MICROS_PER_TICK
+#if defined(USE_RUNTIME_MICROS_PER_TICK) && defined(DISABLE_CODE_FOR_RECEIVER)
+#undef USE_RUNTIME_MICROS_PER_TICK
+#endif
+
+#if defined(USE_RUNTIME_MICROS_PER_TICK)
+// The variables are computed by setMicrosPerTick(), to avoid divisions in the ISR
+#define RECORD_GAP_TICKS    sRecordGapTicks
+#else
 #define RECORD_GAP_TICKS    (RECORD_GAP_MICROS / MICROS_PER_TICK) // 160 for RECORD_GAP_MICROS == 8000
+#endif
 
 /**
  * microseconds per clock interrupt tick
  */
-#if !defined(MICROS_PER_TICK)
+#if defined(USE_RUNTIME_MICROS_PER_TICK)
+#  if defined(MICROS_PER_TICK)
+#undef MICROS_PER_TICK
+#  endif
+#define MICROS_PER_TICK    sMicrosPerTick
+#define MINIMUM_MICROS_PER_TICK     10  // Range of setMicrosPerTick(). The timer reload values of all platforms fit for this range.
+#define MAXIMUM_MICROS_PER_TICK     100
+#  if !defined(USE_16_BIT_TIMING_BUFFER)
+#define USE_16_BIT_TIMING_BUFFER // 8 bit hold only 2550 us at 10 us per tick
+#  endif
+#elif !defined(MICROS_PER_TICK)
 #define MICROS_PER_TICK    50 // We do not need it to be 50L!!! It saves 90 bytes for UnitTest compared with 50L :-)
 #endif
 
+/**
+ * Define to store the exact value of marks and spaces longer than 255 ticks / 12750 us with the 8 bit timing buffer.
+ * Such an interval is stored as the escape value 255 in rawbuf, which is sufficient for the decoders,
+ * and its exact value is stored in an extension table of LONG_INTERVALS_BUFFER_LENGTH entries.
+ * getRawbufTicks(), the print functions, getTotalDurationOfRawData() and the binary records use the exact value.
+ * Each entry requires 3 or 4 bytes of RAM, compared to additional RAW_BUFFER_LENGTH bytes for the 16 bit timing buffer.
+ */
+//#define LONG_INTERVALS_BUFFER_LENGTH    4
+#if defined(LONG_INTERVALS_BUFFER_LENGTH) && defined(USE_16_BIT_TIMING_BUFFER)
+#undef LONG_INTERVALS_BUFFER_LENGTH // Not required, all values fit into the buffer
+#endif
+
+/**
+ * Define to end a frame by a gap, which depends on the protocol recognized at the start of the frame.
+ * Frames of all protocols still end after RECORD_GAP_MICROS, except Bang & Olufsen frames,
+ * whose long 3. start space of 15.6 ms is then accepted as part of the frame.
+ * So B&O can be decoded without ENABLE_BEO_WITHOUT_FRAME_GAP and without increasing RECORD_GAP_MICROS to 16000,
+ * which delays the end of frame detection for all other protocols and merges Sony repeats.
+ * With the 8 bit timing buffer, it defines LONG_INTERVALS_BUFFER_LENGTH to keep the exact value of the B&O start space.
+ */
+//#define USE_PROTOCOL_SPECIFIC_FRAME_GAP
+#if defined(USE_PROTOCOL_SPECIFIC_FRAME_GAP) && (!defined(DECODE_BEO) || defined(DISABLE_CODE_FOR_RECEIVER))
+#undef USE_PROTOCOL_SPECIFIC_FRAME_GAP // B&O is currently the only protocol requiring it
+#endif
+#if defined(USE_PROTOCOL_SPECIFIC_FRAME_GAP)
+#define FRAME_GAP_TICKS     irparams.FrameGapTicks // Set to RECORD_GAP_TICKS at the start of each frame
+#define FRAME_GAP_MICROS    ((uint32_t) irparams.FrameGapTicks * MICROS_PER_TICK)
+#  if !defined(USE_16_BIT_TIMING_BUFFER) && !defined(LONG_INTERVALS_BUFFER_LENGTH)
+#define LONG_INTERVALS_BUFFER_LENGTH    1
+#  endif
+#else
+#define FRAME_GAP_TICKS     RECORD_GAP_TICKS
+#define FRAME_GAP_MICROS    RECORD_GAP_MICROS
+#endif
+
+/**
+ * Define to enable and disable protocols for decode() at runtime with IrReceiver.setEnabledProtocols(), enableProtocol() and disableProtocol().
+ * Decoders, which can only return disabled protocols, are skipped. All protocols selected by DECODE_<Protocol> are enabled initially.
+ */
+//#define SUPPORT_RUNTIME_PROTOCOL_SELECTION
+
+/**
+ * Define to measure the duration of each decoder called by decode(). The results are printed by IrReceiver.printDecoderProfile(&Serial).
+ * Durations are measured in CPU cycles on ESP32 and ESP8266 and with micros() on all other platforms.
+ * On AVR the resolution of micros() is 4 us, so only the sums over many frames are meaningful.
+ * Define DECODER_PROFILE_TIMESTAMP() and DECODER_PROFILE_UNIT_STRING before including IRremote.hpp to use another time source.
+ * Requires 22 bytes of RAM on AVR for each of the 18 decoders.
+ */
+//#define SUPPORT_DECODER_PROFILING
+#if defined(SUPPORT_DECODER_PROFILING) && !defined(DECODER_PROFILE_TIMESTAMP) // Can be overridden, e.g. by a host program
+#  if defined(ESP32) || defined(ESP8266)
+#define DECODER_PROFILE_TIMESTAMP()   ESP.getCycleCount()
+#define DECODER_PROFILE_UNIT_STRING   "cycles"
+#  else
+#define DECODER_PROFILE_TIMESTAMP()   micros()
+#define DECODER_PROFILE_UNIT_STRING   "us"
+#  endif
+#endif
+
+/**
+ * Define to characterize the receiver module with reference frames and to set MARK_EXCESS_MICROS
+ * and the tolerance of the match functions at runtime with IrReceiver.setReceiverCalibration().
+ * The deviations of the received marks and spaces are collected by IrReceiver.addToTimingStatistics() in an IRTimingStatistics structure,
+ * which requires 272 bytes of RAM. The initial values are MARK_EXCESS_MICROS and TOLERANCE_FOR_DECODERS_MARK_OR_SPACE_MATCHING_PERCENT.
+ * The values are stored in each IRrecv instance and used by its decoders. The global match functions use the values of IrReceiver.
+ */
+//#define SUPPORT_RECEIVER_CALIBRATION
+#if defined(SUPPORT_RECEIVER_CALIBRATION) && defined(DISABLE_CODE_FOR_RECEIVER)
+#undef SUPPORT_RECEIVER_CALIBRATION
+#endif
+#if defined(SUPPORT_RECEIVER_CALIBRATION)
+// The member is set by setReceiverCalibration(). Only valid in member functions of IRrecv.
+#define MARK_EXCESS_MICROS_FOR_DECODE   markExcessMicros
+#else
+#define MARK_EXCESS_MICROS_FOR_DECODE   MARK_EXCESS_MICROS
+#endif
+
 /**
  * Threshold for warnings at printIRResult*() to report about changing the RECORD_GAP_MICROS value to a higher value.
  */
@@ -141,6 +255,49 @@
 #define RECORD_GAP_MICROS_WARNING_THRESHOLD   15000
 #endif
 
+/**
+ * Define to capture the IR signal by a pin change interrupt and micros() instead of polling the input by the 50 us timer interrupt.
+ * No CPU is used between the frames, but the receive pin must support attachInterrupt().
+ * The gap after the last mark of a frame has no edge. Without a receive complete callback, no timer is required
+ * and the gap is detected by available(), decode() or read(), i.e. the main loop must poll.
+ * With a callback registered by registerReceiveCompleteCallback(), the receive timer runs during each frame
+ * to detect the gap and call the callback.
+ * Only one receiver instance is supported.
+ */
+//#define USE_EDGE_CAPTURE_FOR_RECEIVE
+
+/**
+ * Define to activate the glitch filter of the receiver.
+ * Marks and spaces shorter than MINIMUM_PULSE_MICROS are merged with the surrounding interval
+ * and a short mark after the gap does not start a new frame.
+ * It must be smaller than the shortest mark or space of the protocols to be received, e.g. 158 us of the Lego header mark.
+ * 100 removes all glitches, which were detected by only one 50 us sample.
+ */
+//#define MINIMUM_PULSE_MICROS    100
+#if defined(MINIMUM_PULSE_MICROS)
+#  if defined(USE_RUNTIME_MICROS_PER_TICK)
+#define MINIMUM_PULSE_TICKS     sMinimumPulseTicks
+#  else
+#define MINIMUM_PULSE_TICKS     (MINIMUM_PULSE_MICROS / MICROS_PER_TICK)
+#  endif
+#endif
+
+/**
+ * Define to stop the 50 us receive timer in idle state after the gap of RECORD_GAP_MICROS has elapsed.
+ * The first mark of the next frame restarts the timer by a wake up interrupt and the micros() the timer was stopped are added to the gap.
+ * This allows to use a sleep mode, which is woken up by this interrupt, e.g. for battery powered receivers.
+ * If micros() stops during sleep, the gap of the next frame is only the time until the timer was stopped.
+ * The wake up interrupt is attached by the timer ISR when stopping and detaches itself at the first mark,
+ * so the receive pin must support attachInterrupt() and the core must allow to call it from an ISR. Not supported for ESP32 core < 2.0.2.
+ * On AVR, the interrupt is triggered by LOW level, because INT0 and INT1 of the ATmega328 wake up from power down, power save
+ * and standby only by level, an edge only wakes up from idle. If IR_INPUT_IS_ACTIVE_HIGH is defined, CHANGE is used and only idle sleep is possible.
+ * Has no effect for USE_EDGE_CAPTURE_FOR_RECEIVE, which does not sample the input with the timer.
+ */
+//#define USE_LOW_POWER_IDLE_FOR_RECEIVE
+#if defined(USE_LOW_POWER_IDLE_FOR_RECEIVE) && defined(USE_EDGE_CAPTURE_FOR_RECEIVE)
+#undef USE_LOW_POWER_IDLE_FOR_RECEIVE
+#endif
+
 /*
  * Activate this line if your receiver has an external output driver transistor / "inverted" output
  */
@@ -152,6 +309,14 @@
 // IR detector output is active low
 #define INPUT_MARK   0 ///< Sensor output for a mark ("flash")
 #endif
+#if defined(USE_LOW_POWER_IDLE_FOR_RECEIVE)
+#  if defined(__AVR__) && !defined(IR_INPUT_IS_ACTIVE_HIGH)
+#define IR_WAKEUP_INTERRUPT_MODE    LOW     // Level interrupts wake up from all sleep modes
+#  else
+#define IR_WAKEUP_INTERRUPT_MODE    CHANGE
+#define IR_WAKEUP_BY_EDGE                   // An edge before attaching the interrupt must be checked by reading the pin
+#  endif
+#endif
 /****************************************************
  *                     SENDING
  ****************************************************/
@@ -184,6 +349,63 @@
 #undef SEND_PWM_BY_TIMER // USE_NO_SEND_PWM overrides SEND_PWM_BY_TIMER
 #endif
 
+/**
+ * Define to replace the built-in output strategies (software PWM, SEND_PWM_BY_TIMER, USE_NO_SEND_PWM, open drain) by your own send backend.
+ * The value is the name of a class, which must be declared before the #include <IRremote.hpp> and must provide the static functions:
+ *   static void enableIROut(uint_fast16_t aFrequencyKHz); // Called once before each frame
+ *   static void mark(uint16_t aMarkMicros);               // Output must be inactive after return
+ *   static void IRLedOff();
+ *   static void space(uint16_t aSpaceMicros);
+ * Since the functions are static, the calls are resolved at compile time and have no overhead.
+ */
+//#define IR_SEND_BACKEND MySendBackend
+/**
+ * Define to use the send backend, which records all sent durations with timestamps instead of generating output.
+ */
+//#define USE_SEND_RECORDING_BACKEND
+#if defined(USE_SEND_RECORDING_BACKEND)
+#  if defined(IR_SEND_BACKEND)
+#warning "USE_SEND_RECORDING_BACKEND overrides IR_SEND_BACKEND"
+#undef IR_SEND_BACKEND
+#  endif
+#define IR_SEND_BACKEND IRSendRecordingBackend
+class IRSendRecordingBackend;
+#endif
+
+/**
+ * Define to send NEC, NEC2, Apple, Onkyo, Samsung, SamsungLG, LG and Sony with the template send functions
+ * using the compile time PulseDistanceWidthProtocolDescriptor of each protocol instead of the PROGMEM PulseDistanceWidthProtocolConstants.
+ * This generates a specialized send loop with constant timing for each of these protocols, i.e. program memory increases
+ * with the number of these protocols sent. The sent signal is identical.
+ */
+//#define USE_TEMPLATE_SEND_FUNCTIONS
+
+/**
+ * Define to send RC5, Marantz, RC6 and RC6A by computing the list of mark and space durations of the whole frame
+ * with appendBiphaseData() and sending it with sendRaw(). Adjacent half bits of the same level are merged to one duration.
+ * This moves the bit handling out of the loop which generates the carrier and gives a more precise timing at the bit boundaries.
+ * Requires BIPHASE_DURATIONS_BUFFER_LENGTH * 2 bytes of stack while sending.
+ * sendRC6Raw() data, whose durations do not fit into the buffer, e.g. 64 bit, is sent bit by bit as without this macro.
+ */
+//#define USE_BIPHASE_DURATION_LIST_FOR_SEND
+
+/**
+ * Define to enable IrSender.encode(), which generates the marks and spaces of a frame including its repeats
+ * for an IRDurationSink instead of sending them. All protocols supported by write() and Bang & Olufsen can be encoded.
+ * The result can be stored e.g. in an IRDurationBuffer for later sending with sendRaw() or for verification on a host.
+ * Adds a check for an active sink to mark(), space(), IRLedOff() and enableIROut().
+ */
+//#define SUPPORT_ENCODE_TO_DURATION_SINK
+
+/**
+ * Gap between the end of a frame and the start of the next frame sent by writeBatch(), for protocols without repeat timing constants.
+ * Must be greater than the gap which the receiving devices require to detect the end of a frame.
+ * The default is 2 ms greater than the gap used by this library for the same purpose.
+ */
+#if !defined(IR_BATCH_GAP_MICROS)
+#define IR_BATCH_GAP_MICROS     (RECORD_GAP_MICROS + 2000)
+#endif
+
 /**
  * Define to use or simulate open drain output mode at send pin.
  * Attention, active state of open drain is LOW, so connect the send LED between positive supply and send pin!
@@ -192,6 +414,22 @@
 #if defined(USE_OPEN_DRAIN_OUTPUT_FOR_SEND_PIN) && !defined(OUTPUT_OPEN_DRAIN)
 #warning Pin mode OUTPUT_OPEN_DRAIN is not supported on this platform -> mimick open drain mode by switching between INPUT and OUTPUT mode.
 #endif
+
+/**
+ * Define to send the same signal simultaneously at multiple pins, which are specified by IrSender.setSendPins().
+ * The pins of each port are switched by one masked port register write. Single pin sending after setSendPin() is unchanged.
+ * Only supported for software generated PWM with variable send pin.
+ */
+//#define USE_MULTIPLE_SEND_PINS
+#if defined(USE_MULTIPLE_SEND_PINS) && (defined(IR_SEND_PIN) || defined(SEND_PWM_BY_TIMER) || defined(USE_NO_SEND_PWM) \
+    || defined(USE_OPEN_DRAIN_OUTPUT_FOR_SEND_PIN) || defined(IR_SEND_BACKEND))
+#warning "USE_MULTIPLE_SEND_PINS is only supported for software generated PWM without IR_SEND_PIN -> undefine USE_MULTIPLE_SEND_PINS now!"
+#undef USE_MULTIPLE_SEND_PINS
+#endif
+#if !defined(MAXIMUM_NUMBER_OF_SEND_PINS)
+#define MAXIMUM_NUMBER_OF_SEND_PINS 16
+#endif
+
 /**
  * This amount is subtracted from the on-time of the pulses generated for software PWM generation.
  * It should be the time used for digitalWrite(sendPin, LOW) and the call to delayMicros()
@@ -269,6 +507,9 @@ void disableLEDFeedback() {}; // dummy function for examples
 #if !defined(uintDifferenceAbs)
 #define uintDifferenceAbs(a, b) ((a >= b) ? a - b : b - a)
 #endif
+#if defined(USE_SEND_RECORDING_BACKEND)
+#include "IRSendRecordingBackend.hpp"
+#endif
 #include "IRSend.hpp"
 
 /*
@@ -290,6 +531,7 @@ void disableLEDFeedback() {}; // dummy function for examples
 #include "ir_FAST.hpp"
 #include "ir_Others.hpp"
 #include "ir_Pronto.hpp" // pronto is an universal decoder and encoder
+#include "IRSendBatch.hpp" // uses the timing constants of the protocols
 #  if defined(DECODE_DISTANCE_WIDTH)     // universal decoder for pulse distance width protocols - requires up to 750 bytes additional program memory
 #include "ir_DistanceWidthProtocol.hpp"
 #  endif
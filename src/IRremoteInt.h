@@ -38,6 +38,10 @@
 #define SPACE  0
 #define MARK   1
 #define NO_MARK_OR_SPACE  2 // Used as return value for getBiphaselevel()
+#define BIPHASE_DURATIONS_BUFFER_LENGTH 80 // Durations for appendBiphaseData(). RC6A requires 76, Marantz 44.
+#define NO_DOUBLE_WIDTH_BIT             0xFF // aDoubleWidthBitIndex for appendBiphaseData()
+#define BIPHASE_DURATIONS_OVERFLOW      0xFF // Returned by appendMarkOrSpace() and appendBiphaseData() if the buffer is full
+#define BIPHASE_HALF_BIT_BUFFER_SIZE  12 // Bytes for getBiphaseHalfBits(). 95 half bits, RC6A requires 76, Marantz 46.
 
 #if defined(PARTICLE)
 #define F_CPU 16000000 // definition for a board for which F_CPU is not defined
@@ -112,6 +116,8 @@ typedef uint8_t IRRawbufType; // all timings up to 12750 us fit into 8 bit (for
 typedef uint16_t IRRawbufType; // Use 16 bit array
 #endif
 
+#define IR_BINARY_RECORD_START  0xB2 ///< First byte of a record written by writeIRResultAsBinaryRecord(). Contains the format version in the low nibble.
+
 /**********************************************************
  * Declarations for the receiver Interrupt Service Routine
  **********************************************************/
@@ -121,6 +127,16 @@ typedef uint16_t IRRawbufType; // Use 16 bit array
 #define IR_REC_STATE_SPACE     2 // A space was received and we are counting the duration of it. If space is too long, we assume end of frame.
 #define IR_REC_STATE_STOP      3 // Stopped until set to IR_REC_STATE_IDLE which can only be done by resume()
 
+#if defined(LONG_INTERVALS_BUFFER_LENGTH)
+/**
+ * Exact value of a mark or space longer than 12750 us, for which the 8 bit rawbuf contains the escape value UINT8_MAX
+ */
+struct IRLongInterval {
+    IRRawlenType Index;             ///< Index of the rawbuf entry, which contains the escape value UINT8_MAX
+    uint16_t Ticks;                 ///< The exact value of this entry
+};
+#endif
+
 /**
  * This struct contains the data and control used for receiver functions and the ISR (interrupt service routine)
  * Only StateForISR needs to be volatile. All the other fields are not written by ISR after available() == true and before start() / resume().
@@ -147,7 +163,14 @@ struct irparams_struct {
     bool OverflowFlag;                  ///< Raw buffer OverflowFlag occurred
     IRRawlenType rawlen;                ///< counter of entries in rawbuf
     uint16_t initialGapTicks;   ///< Tick counts of the length of the gap between previous and current IR frame. Pre 4.4: rawbuf[0].
+#if defined(USE_PROTOCOL_SPECIFIC_FRAME_GAP)
+    uint16_t FrameGapTicks;     ///< A space longer than this ends the current frame. RECORD_GAP_TICKS or the gap of the protocol detected by setProtocolSpecificFrameGap().
+#endif
     IRRawbufType rawbuf[RAW_BUFFER_LENGTH]; ///< raw data / tick counts per mark/space. With 8 bit we can only store up to 12.7 ms. First entry is empty to be backwards compatible.
+#if defined(LONG_INTERVALS_BUFFER_LENGTH)
+    uint8_t NumberOfLongIntervals;      ///< Number of valid entries in LongIntervals
+    IRLongInterval LongIntervals[LONG_INTERVALS_BUFFER_LENGTH];
+#endif
 };
 
 #if (__INT_WIDTH__ < 32)
@@ -188,6 +211,59 @@ struct IRData {
     uint16_t initialGapTicks;   ///< Contains the initial gap (pre 4.4: the value in rawbuf[0]) of the last received frame.
 };
 
+/**
+ * Data of a decoded frame, which does not fit into IRDecodedEvent.
+ * Stored in an IRPayloadPool and referenced by IRDecodedEvent.payloadHandle.
+ */
+struct IRPayload {
+    IRDecodedRawDataType decodedRawData; ///< All 32/64 bits of IRData.decodedRawData
+#if defined(DECODE_DISTANCE_WIDTH)
+    DistanceWidthTimingInfoStruct DistanceWidthTimingInfo;
+    IRDecodedRawDataType decodedRawDataArray[DECODED_RAW_DATA_ARRAY_SIZE];
+#endif
+};
+
+#define IR_NO_PAYLOAD_HANDLE    0xFF ///< Value of IRDecodedEvent.payloadHandle if the event requires no payload
+#define IR_LOST_PAYLOAD_HANDLE  0xFE ///< Value of IRDecodedEvent.payloadHandle if the payload could not be stored, because the pool was full
+#if !defined(IR_PAYLOAD_POOL_SIZE)
+#define IR_PAYLOAD_POOL_SIZE    4 ///< Number of payloads in an IRPayloadPool. Maximum is 8.
+#endif
+#if IR_PAYLOAD_POOL_SIZE > 8
+#error IR_PAYLOAD_POOL_SIZE must be <= 8, since the used entries are stored in an 8 bit mask.
+#endif
+
+/**
+ * Compact copy of IRData of 15 or 16 bytes, to store decoded frames in event queues and history buffers.
+ * Filled by IrReceiver.getDecodedEvent() and converted back by getIRDataFromDecodedEvent().
+ * Only distance width protocols and frames with more than 32 bits require an entry in an IRPayloadPool.
+ */
+struct IRDecodedEvent {
+    uint32_t decodedRawData;    ///< Lower 32 bit of IRData.decodedRawData
+    uint16_t address;
+    uint16_t command;
+    uint16_t extra;
+    uint16_t numberOfBits;
+    uint8_t protocol;           ///< decode_type_t
+    uint8_t flags;              ///< IRDATA_FLAGS_* of IRData.flags
+    uint8_t payloadHandle;      ///< Index in the IRPayloadPool, IR_NO_PAYLOAD_HANDLE or IR_LOST_PAYLOAD_HANDLE
+};
+
+/**
+ * Fixed size pool for the payloads of IRDecodedEvent.
+ * A payload allocated by getDecodedEvent() must be released by the application, if the event is no longer required.
+ */
+class IRPayloadPool {
+public:
+    uint8_t allocatePayload();
+    void releasePayload(uint8_t aPayloadHandle);
+    IRPayload* getPayload(uint8_t aPayloadHandle);
+    uint_fast8_t getNumberOfFreePayloads();
+
+private:
+    uint8_t usedPayloadsMask = 0; ///< Bit i is set if payloads[i] is allocated
+    IRPayload payloads[IR_PAYLOAD_POOL_SIZE];
+};
+
 /****************************************************
  *                     RECEIVING
  ****************************************************/
@@ -210,9 +286,112 @@ struct decode_results {
 };
 
 extern unsigned long sMicrosAtLastStopTimer; // Used to adjust TickCounterForISR with uncounted ticks between stopTimer() and restartTimer()
+#if defined(USE_RUNTIME_MICROS_PER_TICK)
+extern uint8_t sMicrosPerTick;      // MICROS_PER_TICK
+extern uint16_t sRecordGapTicks;    // RECORD_GAP_TICKS
+#  if defined(MINIMUM_PULSE_MICROS)
+extern uint8_t sMinimumPulseTicks;  // MINIMUM_PULSE_TICKS
+#  endif
+#endif
+
+#if defined(SUPPORT_RUNTIME_PROTOCOL_SELECTION) || defined(SUPPORT_DECODER_PROFILING)
+/**
+ * The state, which a decoder may change, saved by callDecoders() and restored if the decoded protocol is disabled.
+ */
+struct DecoderStateStruct {
+    uint8_t Flags;
+    uint8_t RepeatCount;
+    decode_type_t LastDecodedProtocol;
+    uint16_t LastDecodedAddress;
+    uint16_t LastDecodedCommand;
+#  if defined(DECODE_DISTANCE_WIDTH)
+    IRDecodedRawDataType LastDecodedRawData;
+#  endif
+};
+#endif
+
+#if defined(SUPPORT_DECODER_PROFILING)
+/**
+ * Statistics of one decoder, collected by decode() and printed by printDecoderProfile().
+ * Durations are in CPU cycles if DECODER_PROFILE_UNIT_STRING is "cycles", else in microseconds.
+ */
+struct DecoderProfileStruct {
+    uint32_t NumberOfCalls;
+    uint32_t NumberOfHits;              // Number of calls returning an enabled protocol
+    uint32_t SumOfHitDurations;
+    uint32_t SumOfMissDurations;
+    uint32_t MaximumDuration;
+    decode_type_t Protocol;             // The main protocol of the decoder, e.g. NEC for NEC, NEC2, Onkyo and Apple
+};
+/*
+ * Index of each decoder in decoderProfile[], in the order the decoders are called by decode()
+ */
+typedef enum {
+    DECODER_INDEX_NEC = 0, DECODER_INDEX_KASEIKYO, DECODER_INDEX_DENON, DECODER_INDEX_SONY, DECODER_INDEX_RC5, DECODER_INDEX_RC6,
+    DECODER_INDEX_LG, DECODER_INDEX_JVC, DECODER_INDEX_SAMSUNG, DECODER_INDEX_BANG_OLUFSEN, DECODER_INDEX_FAST, DECODER_INDEX_WHYNTER,
+    DECODER_INDEX_LEGO_PF, DECODER_INDEX_BOSEWAVE, DECODER_INDEX_MAGIQUEST, DECODER_INDEX_OPENLASIR,
+    DECODER_INDEX_PULSE_DISTANCE, /* universal distance width decoder */
+    DECODER_INDEX_UNKNOWN, /* hash decoder */
+    NUMBER_OF_PROFILED_DECODERS
+} decoder_index_t;
+#endif
+
+#if !defined(TOLERANCE_FOR_DECODERS_MARK_OR_SPACE_MATCHING_PERCENT)
+#define TOLERANCE_FOR_DECODERS_MARK_OR_SPACE_MATCHING_PERCENT    25 // Relative tolerance (in percent) for matchTicks(), matchMark() and matchSpace() functions used for protocol decoding.
+#endif
+
+#if defined(SUPPORT_RECEIVER_CALIBRATION)
+#define TIMING_STATISTICS_NUMBER_OF_BINS    64
+#define TIMING_STATISTICS_BIN_MICROS        10  // The histograms cover deviations from -320 to +319 us, greater deviations are counted in the first or last bin
+#define RECEIVER_CALIBRATION_TOLERANCE_MARGIN_PERCENT   10 // Added to the tolerance required for the receiver, for the clock deviation of the remotes
+#define RECEIVER_CALIBRATION_MAXIMUM_TOLERANCE_PERCENT  40
+/**
+ * Deviations of the received marks and spaces from the durations of reference frames, collected by addToTimingStatistics().
+ * Must be initialized with zeros, e.g. by IRTimingStatistics sStatistics; as global variable or by IRTimingStatistics tStatistics = { };
+ */
+struct IRTimingStatistics {
+    uint16_t NumberOfFrames;
+    uint16_t NumberOfMarks;
+    uint16_t NumberOfSpaces;
+    uint16_t MinimumReferenceMicros;                        // Shortest reference duration, 0 if no frame was added
+    int32_t SumOfMarkDeviations;                            // Received minus reference micros
+    int32_t SumOfSpaceDeviations;
+    uint16_t MarkHistogram[TIMING_STATISTICS_NUMBER_OF_BINS];
+    uint16_t SpaceHistogram[TIMING_STATISTICS_NUMBER_OF_BINS];
+};
+
+/**
+ * The values computed by computeReceiverCalibration(). Can be stored e.g. in EEPROM and applied at startup with setReceiverCalibration().
+ */
+struct IRReceiverCalibration {
+    int16_t MarkExcessMicros;
+    uint8_t TolerancePercent;
+};
+#endif
+
+/**
+ * Reference to the marks and spaces of a frame, which is stored outside of irparams.rawbuf, to decode it without copying.
+ * The layout is the same as irparams.rawbuf, i.e. index 0 is not used and index 1 contains the first mark.
+ */
+struct IRFrameView {
+    const IRRawbufType *RawbufPtr;
+    IRRawlenType Rawlen;        ///< Number of entries including the unused entry at index 0, like decodedIRData.rawlen
+    uint8_t MicrosPerTick;      ///< Resolution of the entries. Must be MICROS_PER_TICK for decoding.
+    uint16_t InitialGapTicks;   ///< Gap before the frame, used for repeat detection
+#if defined(LONG_INTERVALS_BUFFER_LENGTH)
+    const IRLongInterval *LongIntervalsPtr; ///< Exact values of the entries containing UINT8_MAX, like irparams.LongIntervals. Can be nullptr if NumberOfLongIntervals is 0.
+    uint8_t NumberOfLongIntervals;
+#endif
+};
 
 /**
  * Main class for receiving IR signals
+ * The state written by the decoders, i.e. decodedIRData, the last decoded values for repeat detection and rawbufForDecode,
+ * is contained in the instance. Thus additional instances can decode frames with decode(const IRFrameView&, IRData&)
+ * in parallel, e.g. one instance per thread on a host. Only the instance IrReceiver is connected to the receive ISR.
+ * The values set by setReceiverCalibration() are contained in the instance too.
+ * The timing values sMicrosPerTick, sRecordGapTicks and sMinimumPulseTicks of USE_RUNTIME_MICROS_PER_TICK are global and shared by all instances.
+ * They are only read by the decoders and must not be changed while another instance decodes.
  */
 #define USE_DEFAULT_FEEDBACK_LED_PIN        0xFF // we need it here
 class IRrecv {
@@ -231,11 +410,30 @@ public:
                     __attribute__ ((deprecated ("Please use the default IRrecv instance \"IrReceiver\" and IrReceiver.begin(), and not your own IRrecv instance..")));
 #endif
     void setReceivePin(uint_fast8_t aReceivePinNumber);
+#if defined(USE_RUNTIME_MICROS_PER_TICK)
+    void setMicrosPerTick(uint8_t aMicrosPerTick);
+#endif
 #if !defined(IR_REMOTE_DISABLE_RECEIVE_COMPLETE_CALLBACK)
     void registerReceiveCompleteCallback(void (*aReceiveCompleteCallbackFunction)(void));
 #endif
     void ReceiveInterruptHandler();
 
+    /*
+     * Capture backend interface
+     */
+    void feedCapturedDuration(uint_fast16_t aDurationTicks, bool aIsMark);
+    void handleCapturedFrameEnd();
+#if defined(USE_PROTOCOL_SPECIFIC_FRAME_GAP)
+    void setProtocolSpecificFrameGap();
+    void checkForBangOlufsenFrameStart();
+#endif
+    void replayRawFrame(const uint16_t *aDurationsMicros, IRRawlenType aNumberOfDurations, uint32_t aGapMicros = 200000);
+#if defined(USE_EDGE_CAPTURE_FOR_RECEIVE)
+    void EdgeInterruptHandler();
+    void handleCapturedFrameTimeout();
+    void checkForCapturedFrameTimeout();
+#endif
+
     /*
      * Stream like API
      */
@@ -258,12 +456,49 @@ public:
     void end(); // alias for stop
 
     bool isIdle();
+#if defined(USE_LOW_POWER_IDLE_FOR_RECEIVE)
+    bool isReceiveTimerParked();
+#endif
 
     /*
      * The main functions
      */
     bool decode();  // Check if available and try to decode
+    bool decode(const IRFrameView &aFrameView, IRData &aIRData); // Decode a frame stored outside of irparams
     void resume();  // Enable receiving of the next value
+#if defined(SUPPORT_RUNTIME_PROTOCOL_SELECTION)
+    void setEnabledProtocols(uint32_t aProtocolMask);
+    void enableProtocol(decode_type_t aProtocol);
+    void disableProtocol(decode_type_t aProtocol);
+    bool isProtocolEnabled(decode_type_t aProtocol);
+#endif
+#if defined(SUPPORT_DECODER_PROFILING)
+    void printDecoderProfile(Print *aSerial);
+    void resetDecoderProfile();
+#endif
+#if defined(SUPPORT_RECEIVER_CALIBRATION)
+    bool addToTimingStatistics(IRTimingStatistics *aStatistics, const uint16_t *aReferenceDurationsMicros,
+            IRRawlenType aNumberOfReferenceDurations);
+#  if defined(SUPPORT_ENCODE_TO_DURATION_SINK)
+    bool addToTimingStatistics(IRTimingStatistics *aStatistics, IRData *aReferenceIRData);
+#  endif
+    void computeReceiverCalibration(const IRTimingStatistics *aStatistics, IRReceiverCalibration *aCalibration);
+    void printTimingStatistics(const IRTimingStatistics *aStatistics, Print *aSerial);
+    void setReceiverCalibration(const IRReceiverCalibration *aCalibration);
+    void getReceiverCalibration(IRReceiverCalibration *aCalibration);
+    /*
+     * Match functions using the calibration of this instance. They hide the global match functions in the decoders.
+     */
+    bool matchTicks(uint16_t aMeasuredTicks, uint16_t aMatchValueMicros);
+    bool matchTicks(uint16_t aMeasuredTicks, uint16_t aMatchValueMicros, int16_t aCompensationMicrosForTicks);
+    bool matchMark(uint16_t aMeasuredTicks, uint16_t aMatchValueMicros);
+    bool matchSpace(uint16_t aMeasuredTicks, uint16_t aMatchValueMicros);
+    bool matchTicksWithGreaterRange(uint16_t aMeasuredTicks, uint16_t aMatchValueMicros);
+    bool matchTicksWithGreaterRange(uint16_t aMeasuredTicks, uint16_t aMatchValueMicros, int16_t aCompensationMicrosForTicks);
+    bool matchMarkWithGreaterRange(uint16_t aMeasuredTicks, uint16_t aMatchValueMicros);
+    bool matchSpaceWithGreaterRange(uint16_t aMeasuredTicks, uint16_t aMatchValueMicros);
+#endif
+    bool getDecodedEvent(IRDecodedEvent *aDecodedEvent, IRPayloadPool *aPayloadPool = nullptr);
 
     /*
      * Useful info and print functions
@@ -276,6 +511,11 @@ public:
     uint8_t getMaximumSpaceTicksFromRawData();
     uint8_t getMaximumTicksFromRawData(bool aSearchSpaceInsteadOfMark);
     uint32_t getTotalDurationOfRawData();
+    uint_fast16_t getRawbufTicks(IRRawlenType aIndex);
+    uint_fast16_t getRawbufTicksForDecode(IRRawlenType aIndex);
+#if defined(LONG_INTERVALS_BUFFER_LENGTH)
+    void storeLongInterval(IRRawlenType aIndex, uint16_t aTicks);
+#endif
 
     /*
      * Next 4 functions are also available as non member functions
@@ -300,6 +540,8 @@ public:
      * Store the data for further processing
      */
     void compensateAndStoreIRResultInArray(uint8_t *aArrayPtr);
+    size_t writeIRResultAsBinaryRecord(Print *aSerial);
+    size_t readBinaryRecord(const uint8_t *aRecord, size_t aMaximumLength, IRData *aRecordedIRData = nullptr);
     size_t compensateAndStorePronto(String *aString, uint16_t frequency = 38000U);
 
     /*
@@ -336,6 +578,9 @@ public:
     void initBiphaselevel(uint_fast8_t aRCDecodeRawbuffOffset, uint16_t aBiphaseTimeUnit);
     static uint8_t getNumberOfUnitsInInterval(uint16_t aCurrentInterval, uint16_t aTimeUnit);
     uint_fast8_t getBiphaselevel();
+    uint_fast8_t getBiphaseHalfBits(uint8_t *aHalfBitBuffer, uint_fast8_t aHalfBitBufferSize, uint_fast8_t aRCDecodeRawbuffOffset,
+            uint16_t aBiphaseTimeUnit);
+    static uint_fast8_t getBiphaseHalfBit(const uint8_t *aHalfBitBuffer, uint_fast8_t aHalfBitIndex);
 #endif
 
     /*
@@ -396,14 +641,30 @@ public:
      * Internal functions
      */
     void initDecodedIRData();
+    void initDecodedIRData(bool aWasOverflow);
     uint_fast8_t compare(uint16_t oldval, uint16_t newval);
     bool checkHeader(PulseDistanceWidthProtocolConstants *aProtocolConstants);
     bool checkHeader_P(PulseDistanceWidthProtocolConstants const *aProtocolConstantsPGM);
     void checkForRepeatSpaceTicksAndSetFlag(uint16_t aMaximumRepeatSpaceTicks);
     bool checkForRecordGapsMicros(Print *aSerial);
+#if defined(SUPPORT_RUNTIME_PROTOCOL_SELECTION)
+    void saveDecoderState(DecoderStateStruct *aDecoderState);
+    bool checkDecodedProtocolIsEnabled(DecoderStateStruct const *aDecoderState);
+#endif
+    bool callDecoders();
+#if defined(SUPPORT_DECODER_PROFILING)
+    bool callAndProfileDecoder(decoder_index_t aDecoderIndex, decode_type_t aProtocol, bool (IRrecv::*aDecoderFunction)(),
+            DecoderStateStruct const *aDecoderState);
+#endif
 
     irparams_struct irparams;
     IRData decodedIRData;       // Decoded IR data for the application
+    // The frame read by the decoders. Only differs from irparams.rawbuf during decode(IRFrameView). Set again by each decode(), since a copy of the instance points to the rawbuf of its source.
+    const IRRawbufType *rawbufForDecode = irparams.rawbuf;
+#if defined(LONG_INTERVALS_BUFFER_LENGTH)
+    const IRLongInterval *longIntervalsForDecode; // Only valid during decode(IRFrameView)
+    uint8_t numberOfLongIntervalsForDecode;
+#endif
 
     // Last decoded IR data for repeat detection and to fill in JVC, LG, NEC repeat values. Parity for Denon autorepeat
     decode_type_t lastDecodedProtocol;
@@ -414,6 +675,16 @@ public:
 #endif
 
     uint8_t repeatCount;        // Used e.g. for Denon decode for autorepeat decoding.
+#if defined(SUPPORT_RUNTIME_PROTOCOL_SELECTION)
+    uint32_t enabledProtocolsMask = ALL_PROTOCOLS_MASK; // Bit n set means protocol n (of decode_type_t) is enabled for decode()
+#endif
+#if defined(SUPPORT_DECODER_PROFILING)
+    DecoderProfileStruct decoderProfile[NUMBER_OF_PROFILED_DECODERS] = { };
+#endif
+#if defined(SUPPORT_RECEIVER_CALIBRATION)
+    int16_t markExcessMicros = MARK_EXCESS_MICROS;  // MARK_EXCESS_MICROS_FOR_DECODE, set by setReceiverCalibration()
+    uint8_t tolerancePercent = TOLERANCE_FOR_DECODERS_MARK_OR_SPACE_MATCHING_PERCENT; // Tolerance of the match functions
+#endif
 };
 
 void printIRResultShort(Print *aSerial, IRData *aIRDataPtr, bool aPrintRepeatGap)
@@ -423,6 +694,8 @@ void printIRResultShort(Print *aSerial, IRData *aIRDataPtr)
 ;
 // A static function to be able to print send or copied received data.
 void printIRDataShort(Print *aSerial, IRData *aIRDataPtr);
+// Restores the IRData of an event stored by getDecodedEvent(), e.g. to print or send it.
+bool getIRDataFromDecodedEvent(IRData *aIRDataPtr, const IRDecodedEvent *aDecodedEvent, IRPayloadPool *aPayloadPool = nullptr);
 
 /*
  * Mark & Space matching functions
@@ -434,6 +707,9 @@ bool matchSpace(uint16_t aMeasuredTicks, uint16_t aMatchValueMicros);
 bool matchTicksWithGreaterRange(uint16_t aMeasuredTicks, uint16_t aMatchValueMicros);
 bool matchTicksWithGreaterRange(uint16_t aMeasuredTicks, uint16_t aMatchValueMicros, int16_t aCompensationMicrosForTicks);
 bool matchMarkWithGreaterRange(uint16_t aMeasuredTicks, uint16_t aMatchValueMicros);
+#if defined(SUPPORT_RECEIVER_CALIBRATION)
+bool matchMicrosWithTolerance(uint16_t aMeasuredMicros, uint16_t aMatchValueMicros, uint8_t aTolerancePercent);
+#endif
 bool matchSpaceWithGreaterRange(uint16_t aMeasuredTicks, uint16_t aMatchValueMicros);
 
 /*
@@ -470,12 +746,9 @@ void setBlinkPin(uint8_t aFeedbackLEDPin) __attribute__ ((deprecated ("Please us
  * First MARK is the one after the long gap
  * Pulse parameters in microseconds
  */
-#if !defined(TOLERANCE_FOR_DECODERS_MARK_OR_SPACE_MATCHING_PERCENT)
-#define TOLERANCE_FOR_DECODERS_MARK_OR_SPACE_MATCHING_PERCENT    25 // Relative tolerance (in percent) for matchTicks(), matchMark() and matchSpace() functions used for protocol decoding.
-#endif
 
 #define TICKS(us)       ((us)/MICROS_PER_TICK)  // (us)/50
-#if MICROS_PER_TICK == 50 && TOLERANCE_FOR_DECODERS_MARK_OR_SPACE_MATCHING_PERCENT == 25           // Defaults
+#if !defined(USE_RUNTIME_MICROS_PER_TICK) && MICROS_PER_TICK == 50 && TOLERANCE_FOR_DECODERS_MARK_OR_SPACE_MATCHING_PERCENT == 25 // Defaults
 #define TICKS_LOW(us)   ((us)/67 )       // =(us * 0.75 /MICROS_PER_TICK), 67 = MICROS_PER_TICK / ((100-25)/100) = (MICROS_PER_TICK * 100) / (100-25)
 #define TICKS_HIGH(us)  (((us)/40) + 1)  // =(us * 1,25 /MICROS_PER_TICK), 40 = MICROS_PER_TICK / ((100+25)/100) = (MICROS_PER_TICK * 100) / (100+25)
 #else
@@ -509,6 +782,42 @@ void IRReceiveTimerInterruptHandler();
 #define NO_REPEATS  0
 #define SEND_REPEAT_COMMAND true ///< used for e.g. NEC, where a repeat is different from just repeating the data.
 
+#if defined(SUPPORT_ENCODE_TO_DURATION_SINK)
+/**
+ * Interface for the receiver of the marks and spaces generated by IRsend::encode().
+ * Consecutive spaces are possible, e.g. the last space of a frame followed by the gap to the next repeat.
+ */
+class IRDurationSink {
+public:
+    virtual void setFrequency(uint_fast16_t aFrequencyKHz) = 0; ///< Called at the start of each frame like enableIROut()
+    virtual void mark(uint16_t aMarkMicros) = 0;
+    virtual void space(uint32_t aSpaceMicros) = 0; ///< Gaps between repeats can be longer than 65535 us
+};
+
+/**
+ * Stores the durations generated by IRsend::encode() in a caller provided array, which can be sent later by sendRaw().
+ * Consecutive marks or consecutive spaces are merged, so the array starts with a mark and marks and spaces alternate.
+ * Durations longer than 65535 us, e.g. long gaps between repeats, are stored as 65535 and hasClippedDuration is set.
+ */
+class IRDurationBuffer: public IRDurationSink {
+public:
+    IRDurationBuffer(uint16_t *aDurationsMicros, uint16_t aMaximumNumberOfDurations);
+    void reset();
+    void setFrequency(uint_fast16_t aFrequencyKHz) override;
+    void mark(uint16_t aMarkMicros) override;
+    void space(uint32_t aSpaceMicros) override;
+
+    uint16_t *DurationsMicros;
+    uint16_t MaximumNumberOfDurations;
+    uint16_t NumberOfDurations;
+    uint16_t FrequencyKHz;      ///< The value of the last setFrequency() call
+    bool hasOverflow;           ///< Set if more than MaximumNumberOfDurations durations were generated
+    bool hasClippedDuration;    ///< Set if a duration was longer than 65535 us and was stored as 65535
+private:
+    void append(uint32_t aDurationMicros, bool aIsMark);
+};
+#endif
+
 /**
  * Main class for sending IR signals
  */
@@ -534,11 +843,20 @@ public:
             __attribute__ ((deprecated ("Use begin(aSendPin, aFeedbackLEDPin) instead.")));
 #  endif
 
-    size_t write(IRData *aIRSendData, int_fast8_t aNumberOfRepeats = NO_REPEATS);
+    size_t write(const IRData *aIRSendData, int_fast8_t aNumberOfRepeats = NO_REPEATS);
     size_t write(decode_type_t aProtocol, uint16_t aAddress, uint16_t aCommand, int_fast8_t aNumberOfRepeats = NO_REPEATS);
+    size_t writeBatch(IRData const aIRSendDataArray[], uint_fast8_t aNumberOfFrames, int_fast8_t aNumberOfRepeats = NO_REPEATS);
+    static uint32_t getMinimumFrameGapMicros(decode_type_t aProtocol);
+#if defined(SUPPORT_ENCODE_TO_DURATION_SINK)
+    size_t encode(IRData *aIRSendData, IRDurationSink *aDurationSink, int_fast8_t aNumberOfRepeats = NO_REPEATS);
+    IRDurationSink *durationSinkForEncode = nullptr;    // Not nullptr while encode() is running
+    uint32_t encodedSignalMicros;                       // Sum of all durations generated by the running encode(), replaces micros() for repeat timing
+#endif
+    unsigned long getMillisForFrameTiming();
+    void delayBetweenFrames(unsigned long aMillis);
 
     void enableIROut(uint_fast8_t aFrequencyKHz);
-#if defined(SEND_PWM_BY_TIMER)
+#if defined(SEND_PWM_BY_TIMER) || defined(IR_SEND_BACKEND) || defined(SUPPORT_ENCODE_TO_DURATION_SINK)
     void enableHighFrequencyIROut(uint_fast16_t aFrequencyKHz); // Used for Bang&Olufsen
 #endif
 
@@ -583,10 +901,22 @@ public:
             int_fast8_t aNumberOfRepeats, void (*aSpecialSendRepeatFunction)() = nullptr);
     void sendPulseDistanceWidthData(uint16_t aOneMarkMicros, uint16_t aOneSpaceMicros, uint16_t aZeroMarkMicros,
             uint16_t aZeroSpaceMicros, IRDecodedRawDataType aData, uint_fast8_t aNumberOfBits, uint8_t aFlags);
+    /*
+     * Variants with compile time PulseDistanceWidthProtocolDescriptor
+     */
+    template<typename ProtocolDescriptor>
+    void sendPulseDistanceWidth(IRDecodedRawDataType aData, uint_fast8_t aNumberOfBits, int_fast8_t aNumberOfRepeats);
+    template<typename ProtocolDescriptor>
+    void sendPulseDistanceWidthData(IRDecodedRawDataType aData, uint_fast8_t aNumberOfBits);
+
     void sendBiphaseData(uint16_t aBiphaseTimeUnit, uint32_t aData, uint_fast8_t aNumberOfBits, bool aSendStartBit = true);
+    static uint_fast8_t appendMarkOrSpace(uint16_t aDurationsMicros[], uint_fast8_t aNumberOfDurations, uint_fast8_t aLevel,
+            uint16_t aDurationMicros);
+    static uint_fast8_t appendBiphaseData(uint16_t aDurationsMicros[], uint_fast8_t aNumberOfDurations, uint16_t aBiphaseTimeUnit,
+            uint64_t aData, uint_fast8_t aNumberOfBits, bool aOneIsMarkSpace, uint_fast8_t aDoubleWidthBitIndex = NO_DOUBLE_WIDTH_BIT);
 
     void mark(uint16_t aMarkMicros);
-    static void space(uint16_t aSpaceMicros);
+    void space(uint16_t aSpaceMicros);
     void IRLedOff();
 
 // 8 Bit array
@@ -741,6 +1071,23 @@ public:
 
 #if !defined(IR_SEND_PIN)
     uint8_t sendPin;
+#endif
+#if defined(USE_MULTIPLE_SEND_PINS)
+    void setSendPins(const uint8_t aSendPins[], uint_fast8_t aNumberOfSendPins);
+    void writeSendPins(bool aActive);
+    uint8_t sendPins[MAXIMUM_NUMBER_OF_SEND_PINS];
+    uint8_t numberOfSendPins; // 0 -> only sendPin is used
+#  if defined(portOutputRegister)
+#    if defined(__AVR__)
+    typedef uint8_t IRSendPortMaskType;
+#    else
+    typedef uint32_t IRSendPortMaskType;
+#    endif
+    // One output register and the mask of all send pins at this port for each port used
+    volatile IRSendPortMaskType *sendPortRegisters[MAXIMUM_NUMBER_OF_SEND_PINS];
+    IRSendPortMaskType sendPortMasks[MAXIMUM_NUMBER_OF_SEND_PINS];
+    uint8_t numberOfSendPorts;
+#  endif
 #endif
     uint16_t periodTimeMicros;
     uint16_t periodOnTimeMicros; // compensated with PULSE_CORRECTION_NANOS for duration of digitalWrite. Around 8 microseconds for 38 kHz.
@@ -33,9 +33,9 @@
  * @{
  */
 
-#define VERSION_TINYIR "2.3.0"
+#define VERSION_TINYIR "2.4.0"
 #define VERSION_TINYIR_MAJOR 2
-#define VERSION_TINYIR_MINOR 3
+#define VERSION_TINYIR_MINOR 4
 #define VERSION_TINYIR_PATCH 0
 // The change log is at the bottom of the file
 
@@ -275,6 +275,46 @@ void sendNECMinimal(uint8_t aSendPin, uint16_t aAddress, uint16_t aCommand, uint
 void sendNEC(uint8_t aSendPin, uint16_t aAddress, uint16_t aCommand, uint_fast8_t aNumberOfRepeats = 0, bool aSendNEC2Repeats = false);
 void sendExtendedNEC(uint8_t aSendPin, uint16_t aAddress, uint16_t aCommand, uint_fast8_t aNumberOfRepeats = 0, bool aSendNEC2Repeats = false);
 
+#if defined(USE_TIMER_FOR_TINY_SENDER)
+/*
+ * Index positions of the duration list for NEC: 0 + 1 header, 2 to 65 data, 66 stop bit, 67 gap.
+ * For NEC special repeats, the repeat frame is appended: 68 + 69 header, 70 stop bit, 71 gap.
+ * Even indexes are marks, odd indexes are spaces.
+ */
+#define TINY_SENDER_MAXIMUM_NUMBER_OF_DURATIONS  (2 + (2 * NEC_BITS) + 1 + 1 + 3 + 1) // 72
+
+/**
+ * Control data for the non blocking sender. Requires 81 bytes RAM.
+ */
+struct TinyIRSenderControlStruct {
+    uint8_t DurationUnits[TINY_SENDER_MAXIMUM_NUMBER_OF_DURATIONS]; ///< Mark and space durations in multiples of the protocol unit.
+    uint8_t Index;              ///< Index of the current mark or space.
+    uint8_t FirstGapIndex;      ///< Index of the gap after the first frame.
+    uint8_t RepeatStartIndex;   ///< 0 or index of the NEC special repeat frame.
+    uint8_t EndIndex;           ///< Index after the gap of the last frame in list.
+    uint8_t NumberOfRepeats;    ///< Remaining repeats to send.
+    uint8_t PeriodsPerUnit;     ///< Number of carrier periods for one protocol unit.
+    uint8_t RemainingPeriods;   ///< Remaining carrier periods of the current unit.
+    uint8_t RemainingUnits;     ///< Remaining units of the current mark or space.
+    bool isBusy;                ///< Is true from start of first frame to end of stop bit of last repeat.
+};
+extern volatile TinyIRSenderControlStruct TinyIRSenderControl;
+
+bool isTinyIRSenderBusy();
+void startSendFAST(uint16_t aCommand, uint_fast8_t aNumberOfRepeats = 0);
+void startSendONKYO(uint16_t aAddress, uint16_t aCommand, uint_fast8_t aNumberOfRepeats = 0, bool aSendNEC2Repeats = false);
+void startSendNEC(uint16_t aAddress, uint16_t aCommand, uint_fast8_t aNumberOfRepeats = 0, bool aSendNEC2Repeats = false);
+void startSendExtendedNEC(uint16_t aAddress, uint16_t aCommand, uint_fast8_t aNumberOfRepeats = 0, bool aSendNEC2Repeats = false);
+
+#  if defined(USE_CALLBACK_FOR_TINY_SENDER)
+/*
+ * This function is called in ISR context after the stop bit of the last repeat is sent and must be implemented in the file (user code)
+ * which includes this library if USE_CALLBACK_FOR_TINY_SENDER is activated.
+ */
+extern void handleTinyIRSenderDone();
+#  endif
+#endif // defined(USE_TIMER_FOR_TINY_SENDER)
+
 #if defined(NO_LED_FEEDBACK_CODE)
 #  if !defined(NO_LED_RECEIVE_FEEDBACK_CODE)
 #define NO_LED_RECEIVE_FEEDBACK_CODE
@@ -289,6 +329,9 @@ void sendExtendedNEC(uint8_t aSendPin, uint16_t aAddress, uint16_t aCommand, uin
 #endif
 
 /*
+ *  Version 2.4.0 - 10/2026
+ *  - New non blocking sending functions startSendNEC() etc. activated by USE_TIMER_FOR_TINY_SENDER.
+ *
  *  Version 2.3.0 - 3/2026
  *  - Renamed TinyReceiver*() functions to TinyIRReceiver*().
  *
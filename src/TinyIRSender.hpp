@@ -50,6 +50,8 @@
 
 //#define NO_LED_SEND_FEEDBACK_CODE     // Disables the LED feedback code for receive.
 //#define IR_FEEDBACK_LED_PIN     12    // Use this, to disable use of LED_BUILTIN definition for IR_FEEDBACK_LED_PIN
+//#define USE_TIMER_FOR_TINY_SENDER     // Enables the non blocking startSend*() functions, which use a hardware timer. Only for ATtiny85 and ATmega328.
+//#define USE_CALLBACK_FOR_TINY_SENDER  // Call the user provided function "void handleTinyIRSenderDone()" after the last repeat is sent.
 #include "TinyIR.h" // Defines protocol timings
 
 #include "digitalWriteFast.h"
@@ -406,6 +408,281 @@ void sendFAST(uint8_t aSendPin, uint16_t aCommand, uint_fast8_t aNumberOfRepeats
 #endif
 }
 
+#if defined(USE_TIMER_FOR_TINY_SENDER)
+/*****************************************************************************************************************
+ * Non blocking sending, using a hardware timer
+ * The frame is precomputed into a list of mark and space durations, given in multiples of the protocol unit.
+ * The 38 kHz carrier is generated by hardware PWM and the timer interrupt at the end of each carrier period
+ * counts down the durations and connects / disconnects the PWM output to / from the send pin.
+ * The interrupt handler requires around 35 clock cycles. This results in a CPU load of around 17% at 8 MHz during sending.
+ * Repeats including the gap up to the next repeat are handled by the interrupt too.
+ *
+ * Supported CPUs are ATtiny25/45/85 using timer 1 and pin 4 / PB4 (OC1B)
+ * and ATmega328, ATmega168 using timer 2 and pin 3 / PD3 (OC2B). Timer 2 is also used by tone() and IRremote.
+ *****************************************************************************************************************/
+#if !defined(TINY_SENDER_DUTY_CYCLE_PERCENT)
+#define TINY_SENDER_DUTY_CYCLE_PERCENT  30
+#endif
+#define TINY_SENDER_KHZ                 38
+
+#define NEC_CARRIER_PERIODS_PER_UNIT    (((NEC_UNIT * TINY_SENDER_KHZ) + 500) / 1000)  // 21
+#define FAST_CARRIER_PERIODS_PER_UNIT   (((FAST_UNIT * TINY_SENDER_KHZ) + 500) / 1000) // 20
+#define NEC_REPEAT_PERIOD_UNITS         (NEC_REPEAT_PERIOD / NEC_UNIT)   // 196
+#define FAST_REPEAT_PERIOD_UNITS        (FAST_REPEAT_PERIOD / FAST_UNIT) // 95
+#define NEC_REPEAT_FRAME_UNITS          ((NEC_HEADER_MARK / NEC_UNIT) + (NEC_REPEAT_HEADER_SPACE / NEC_UNIT) + 1) // 21
+
+#if F_CPU < 8000000L
+#error "Non blocking TinyIRSender requires at least 8 MHz CPU clock, since the interrupt is called every 26 us."
+#endif
+
+#if (defined(__AVR_ATtiny25__) || defined(__AVR_ATtiny45__) || defined(__AVR_ATtiny85__)) && !defined(ARDUINO_AVR_DIGISPARK)
+// standard ATTinyCore settings use timer 0 for millis() and micros(), Digispark uses timer 1
+#define TINY_SENDER_TIMER_SEND_PIN      4 // PB4 / OC1B
+#define TINY_SENDER_TIMER_INTR_NAME     TIMER1_COMPA_vect
+
+void tinySenderTimerStart() {
+#  if (((F_CPU / 1000) / TINY_SENDER_KHZ) < 256)
+    const uint16_t tPWMWrapValue = (F_CPU / 1000) / TINY_SENDER_KHZ; // 210 @8 MHz
+    TCCR1 = _BV(CTC1) | _BV(CS10); // CTC1 = 1: TOP value set to OCR1C, CS10 No Prescaling
+#  else
+    const uint16_t tPWMWrapValue = ((F_CPU / 2) / 1000) / TINY_SENDER_KHZ; // 210 @16 MHz
+    TCCR1 = _BV(CTC1) | _BV(CS11); // CTC1 = 1: TOP value set to OCR1C, CS11 Prescaling by 2
+#  endif
+    OCR1C = tPWMWrapValue - 1;
+    OCR1B = ((tPWMWrapValue * TINY_SENDER_DUTY_CYCLE_PERCENT) / 100) - 1;
+    OCR1A = 0; // Compare match A is used as carrier period interrupt
+    TCNT1 = 0;
+    // COM1B1 only: OC1B cleared at compare match and set at BOTTOM, the inverted output at PB3 stays disconnected
+    GTCCR = (GTCCR & ~(_BV(COM1B1) | _BV(COM1B0))) | _BV(PWM1B) | _BV(COM1B1); // Start with a mark
+    TIFR = _BV(OCF1A); // clear pending interrupt
+    TIMSK |= _BV(OCIE1A);
+}
+void tinySenderTimerStop() {
+    TIMSK &= ~(_BV(OCIE1A));
+    GTCCR &= ~(_BV(PWM1B) | _BV(COM1B1));
+    TCCR1 = 0;
+}
+#define tinySenderEnablePWMOutput()     (GTCCR |= _BV(PWM1B) | _BV(COM1B1))
+#define tinySenderDisablePWMOutput()    (GTCCR &= ~(_BV(PWM1B) | _BV(COM1B1))) // Pin is then LOW by PORT register
+
+#elif defined(__AVR_ATmega328P__) || defined(__AVR_ATmega328__) || defined(__AVR_ATmega168__) || defined(__AVR_ATmega168P__)
+#define TINY_SENDER_TIMER_SEND_PIN      3 // PD3 / OC2B
+#define TINY_SENDER_TIMER_INTR_NAME     TIMER2_OVF_vect // Overflow is at BOTTOM, i.e. once each carrier period
+
+void tinySenderTimerStart() {
+    const uint16_t tPWMWrapValue = (F_CPU / 2000) / TINY_SENDER_KHZ; // 210 @16 MHz. 2000 instead of 1000 because of Phase Correct PWM
+    TCCR2A = _BV(WGM20) | _BV(COM2B1); // PWM, Phase Correct, Top is OCR2A. Start with a mark
+    TCCR2B = _BV(WGM22) | _BV(CS20); // CS20 -> no prescaling
+    OCR2A = tPWMWrapValue - 1;
+    OCR2B = ((tPWMWrapValue * TINY_SENDER_DUTY_CYCLE_PERCENT) / 100) - 1;
+    TCNT2 = 0;
+    TIFR2 = _BV(TOV2); // clear pending interrupt
+    TIMSK2 = _BV(TOIE2);
+}
+void tinySenderTimerStop() {
+    TIMSK2 = 0;
+    TCCR2A = 0;
+    TCCR2B = 0;
+}
+#define tinySenderEnablePWMOutput()     (TCCR2A |= _BV(COM2B1))
+#define tinySenderDisablePWMOutput()    (TCCR2A &= ~(_BV(COM2B1))) // Pin is then LOW by PORT register
+
+#else
+#error "Non blocking TinyIRSender is only supported for ATtiny25/45/85 with ATTinyCore and ATmega328/168."
+#endif
+
+#if defined(IR_SEND_PIN) && (IR_SEND_PIN != TINY_SENDER_TIMER_SEND_PIN)
+#warning "Non blocking TinyIRSender always uses the PWM pin of the timer and ignores IR_SEND_PIN."
+#endif
+
+volatile TinyIRSenderControlStruct TinyIRSenderControl;
+
+bool isTinyIRSenderBusy() {
+    return TinyIRSenderControl.isBusy;
+}
+
+/*
+ * Writes header, data, stop bit and gap to the duration list, starting at aIndex.
+ * Bit timing of NEC and FAST is the same, only the unit and the header differ.
+ * @return the index after the gap
+ */
+uint_fast8_t storeTinySenderFrame(uint_fast8_t aIndex, uint8_t aHeaderMarkUnits, uint8_t aHeaderSpaceUnits, uint32_t aData,
+        uint_fast8_t aNumberOfBits, uint8_t aRepeatPeriodUnits) {
+    uint8_t *tDurationUnits = (uint8_t*) &TinyIRSenderControl.DurationUnits[aIndex];
+    uint8_t tFrameUnits = aHeaderMarkUnits + aHeaderSpaceUnits + 1; // + stop bit
+    *tDurationUnits++ = aHeaderMarkUnits;
+    *tDurationUnits++ = aHeaderSpaceUnits;
+    for (uint_fast8_t i = 0; i < aNumberOfBits; ++i) {
+        *tDurationUnits++ = 1; // constant mark length
+        if (aData & 1) {
+            *tDurationUnits++ = 3;
+            tFrameUnits += 4;
+        } else {
+            *tDurationUnits++ = 1;
+            tFrameUnits += 2;
+        }
+        aData >>= 1; // shift command for next bit
+    }
+    *tDurationUnits++ = 1; // stop bit
+    *tDurationUnits = aRepeatPeriodUnits - tFrameUnits; // gap up to the start of the next repeat
+    return aIndex + 2 + (2 * aNumberOfBits) + 2;
+}
+
+/*
+ * Starts the transmission of the precomputed duration list
+ */
+void startTinySender(uint8_t aPeriodsPerUnit, uint_fast8_t aFirstGapIndex, uint_fast8_t aRepeatStartIndex, uint_fast8_t aEndIndex,
+        uint_fast8_t aNumberOfRepeats) {
+    TinyIRSenderControl.PeriodsPerUnit = aPeriodsPerUnit;
+    TinyIRSenderControl.RemainingPeriods = aPeriodsPerUnit;
+    TinyIRSenderControl.RemainingUnits = TinyIRSenderControl.DurationUnits[0];
+    TinyIRSenderControl.Index = 0;
+    TinyIRSenderControl.FirstGapIndex = aFirstGapIndex;
+    TinyIRSenderControl.RepeatStartIndex = aRepeatStartIndex;
+    TinyIRSenderControl.EndIndex = aEndIndex;
+    TinyIRSenderControl.NumberOfRepeats = aNumberOfRepeats;
+    TinyIRSenderControl.isBusy = true;
+
+    pinModeFast(TINY_SENDER_TIMER_SEND_PIN, OUTPUT);
+    digitalWriteFast(TINY_SENDER_TIMER_SEND_PIN, LOW);
+#if defined(LED_SEND_FEEDBACK_CODE) && defined(IR_FEEDBACK_LED_PIN)
+    pinModeFast(IR_FEEDBACK_LED_PIN, OUTPUT);
+#  if defined(FEEDBACK_LED_IS_ACTIVE_LOW)
+    digitalWriteFast(IR_FEEDBACK_LED_PIN, LOW);
+#  else
+    digitalWriteFast(IR_FEEDBACK_LED_PIN, HIGH);
+#  endif
+#endif
+    tinySenderTimerStart();
+}
+
+/*
+ * Common part of all NEC variants.
+ * Waits for end of a running transmission, since we must not overwrite its duration list.
+ */
+void startSendNECRawData(uint32_t aRawData, uint_fast8_t aNumberOfRepeats, bool aSendNEC2Repeats) {
+    while (TinyIRSenderControl.isBusy) {
+        // wait for end of previous transmission
+    }
+    uint_fast8_t tEndIndex = storeTinySenderFrame(0, NEC_HEADER_MARK / NEC_UNIT, NEC_HEADER_SPACE / NEC_UNIT, aRawData, NEC_BITS,
+    NEC_REPEAT_PERIOD_UNITS);
+    uint_fast8_t tRepeatStartIndex = 0;
+    if (!aSendNEC2Repeats) {
+        // append the NEC special repeat frame
+        tRepeatStartIndex = tEndIndex;
+        TinyIRSenderControl.DurationUnits[tEndIndex++] = NEC_HEADER_MARK / NEC_UNIT;
+        TinyIRSenderControl.DurationUnits[tEndIndex++] = NEC_REPEAT_HEADER_SPACE / NEC_UNIT;
+        TinyIRSenderControl.DurationUnits[tEndIndex++] = 1; // stop bit
+        TinyIRSenderControl.DurationUnits[tEndIndex++] = NEC_REPEAT_PERIOD_UNITS - NEC_REPEAT_FRAME_UNITS;
+    }
+    startTinySender(NEC_CARRIER_PERIODS_PER_UNIT, 2 + (2 * NEC_BITS) + 1, tRepeatStartIndex, tEndIndex, aNumberOfRepeats);
+}
+
+/*
+ * Non blocking versions of sendNEC(), sendExtendedNEC(), sendONKYO() and sendFAST().
+ * The send pin is determined by the timer used. If a transmission is still running, they wait for it to end.
+ * Use isTinyIRSenderBusy() to check before calling, if you cannot afford to wait.
+ */
+void startSendNEC(uint16_t aAddress, uint16_t aCommand, uint_fast8_t aNumberOfRepeats, bool aSendNEC2Repeats) {
+    LongUnion tData;
+    if (aAddress > 0xFF) {
+        tData.UWord.LowWord = aAddress;
+    } else {
+        tData.UByte.LowByte = aAddress; // LSB first
+        tData.UByte.MidLowByte = ~aAddress;
+    }
+    if (aCommand > 0xFF) {
+        tData.UWord.HighWord = aCommand;
+    } else {
+        tData.UByte.MidHighByte = aCommand;
+        tData.UByte.HighByte = ~aCommand; // LSB first
+    }
+    startSendNECRawData(tData.ULong, aNumberOfRepeats, aSendNEC2Repeats);
+}
+
+void startSendExtendedNEC(uint16_t aAddress, uint16_t aCommand, uint_fast8_t aNumberOfRepeats, bool aSendNEC2Repeats) {
+    LongUnion tData;
+    tData.UWord.LowWord = aAddress;
+    if (aCommand > 0xFF) {
+        tData.UWord.HighWord = aCommand;
+    } else {
+        tData.UByte.MidHighByte = aCommand;
+        tData.UByte.HighByte = ~aCommand; // LSB first
+    }
+    startSendNECRawData(tData.ULong, aNumberOfRepeats, aSendNEC2Repeats);
+}
+
+void startSendONKYO(uint16_t aAddress, uint16_t aCommand, uint_fast8_t aNumberOfRepeats, bool aSendNEC2Repeats) {
+    LongUnion tData;
+    tData.UWord.LowWord = aAddress;
+    tData.UWord.HighWord = aCommand;
+    startSendNECRawData(tData.ULong, aNumberOfRepeats, aSendNEC2Repeats);
+}
+
+void startSendFAST(uint16_t aCommand, uint_fast8_t aNumberOfRepeats) {
+    while (TinyIRSenderControl.isBusy) {
+        // wait for end of previous transmission
+    }
+    uint16_t tData;
+    if (aCommand > 0xFF) {
+        tData = aCommand;
+    } else {
+        tData = aCommand | (((uint8_t) (~aCommand)) << 8); // LSB first
+    }
+    uint_fast8_t tEndIndex = storeTinySenderFrame(0, FAST_HEADER_MARK / FAST_UNIT, FAST_HEADER_SPACE / FAST_UNIT, tData, FAST_BITS,
+    FAST_REPEAT_PERIOD_UNITS);
+    // FAST repeats are complete frames
+    startTinySender(FAST_CARRIER_PERIODS_PER_UNIT, tEndIndex - 1, 0, tEndIndex, aNumberOfRepeats);
+}
+
+/*
+ * Called at each carrier period. The fast path is only 2 decrements and compares.
+ */
+ISR(TINY_SENDER_TIMER_INTR_NAME) {
+    if (--TinyIRSenderControl.RemainingPeriods != 0) {
+        return;
+    }
+    TinyIRSenderControl.RemainingPeriods = TinyIRSenderControl.PeriodsPerUnit;
+    if (--TinyIRSenderControl.RemainingUnits != 0) {
+        return;
+    }
+
+    /*
+     * Current mark or space has ended, switch to next duration
+     */
+    uint_fast8_t tIndex = TinyIRSenderControl.Index + 1;
+    if (tIndex == TinyIRSenderControl.EndIndex) {
+        tIndex = TinyIRSenderControl.RepeatStartIndex;
+    }
+    if (tIndex == TinyIRSenderControl.FirstGapIndex || tIndex == TinyIRSenderControl.EndIndex - 1) {
+        // Stop bit has ended, check for repeats
+        if (TinyIRSenderControl.NumberOfRepeats == 0) {
+            tinySenderTimerStop();
+#if defined(LED_SEND_FEEDBACK_CODE) && defined(IR_FEEDBACK_LED_PIN)
+#  if defined(FEEDBACK_LED_IS_ACTIVE_LOW)
+            digitalWriteFast(IR_FEEDBACK_LED_PIN, HIGH);
+#  else
+            digitalWriteFast(IR_FEEDBACK_LED_PIN, LOW);
+#  endif
+#endif
+            TinyIRSenderControl.isBusy = false;
+#if defined(USE_CALLBACK_FOR_TINY_SENDER)
+            handleTinyIRSenderDone();
+#endif
+            return;
+        }
+        TinyIRSenderControl.NumberOfRepeats--;
+    }
+    TinyIRSenderControl.Index = tIndex;
+    TinyIRSenderControl.RemainingUnits = TinyIRSenderControl.DurationUnits[tIndex];
+    if (tIndex & 1) {
+        tinySenderDisablePWMOutput();
+    } else {
+        tinySenderEnablePWMOutput();
+    }
+}
+#endif // defined(USE_TIMER_FOR_TINY_SENDER)
+
 /** @}*/
 
 #endif // _TINY_IR_SENDER_HPP
@@ -3,7 +3,7 @@
  *
  *  Contains functions for receiving and sending Bang & Olufsen IR and Datalink '86 protocols
  *  To receive B&O and ENABLE_BEO_WITHOUT_FRAME_GAP is NOT defined, you must set RECORD_GAP_MICROS to
- *  at least 16000 to accommodate the unusually long 3. start space.
+ *  at least 16000 to accommodate the unusually long 3. start space, or define USE_PROTOCOL_SPECIFIC_FRAME_GAP.
  *
  *  This file is part of Arduino-IRremote https://github.com/Arduino-IRremote/Arduino-IRremote.
  *
@@ -73,6 +73,8 @@
 // Mode 1: Mode with gaps between frames
 // Do NOT define ENABLE_BEO_WITHOUT_FRAME_GAP and set RECORD_GAP_MICROS to at least 16000 to accept the unusually long 3. start space
 // Can only receive single messages. Back to back repeats will result in overflow
+// Defining USE_PROTOCOL_SPECIFIC_FRAME_GAP selects this mode, but the long frame gap is only used for frames starting with B&O start bits.
+// All other protocols are still ended after RECORD_GAP_MICROS, so e.g. Sony can be decoded at the same time.
 //
 // Mode 2: Break at start mode
 // Define ENABLE_BEO_WITHOUT_FRAME_GAP and set RECORD_GAP_MICROS to less than 15000
@@ -111,7 +113,9 @@
 /*
  * Options for this decoder
  */
+#if !defined(USE_PROTOCOL_SPECIFIC_FRAME_GAP)
 #define ENABLE_BEO_WITHOUT_FRAME_GAP // Requires additional 30 bytes program memory. Enabled by default, see https://github.com/Arduino-IRremote/Arduino-IRremote/discussions/1181
+#endif
 //#define SUPPORT_BEO_DATALINK_TIMING_FOR_DECODE // This also supports headers up to 32 bit. Requires additional 150 bytes program memory.
 #if defined(DECODE_BEO)
 #  if defined(ENABLE_BEO_WITHOUT_FRAME_GAP)
@@ -119,7 +123,7 @@
 #warning If defined ENABLE_BEO_WITHOUT_FRAME_GAP, RECORD_GAP_MICROS must be set to <= 15000 by "#define RECORD_GAP_MICROS 12750"
 #    endif
 #  else
-#    if RECORD_GAP_MICROS < 16000 && !defined(SUPPRESS_BEO_RECORD_GAP_MICROS_WARNING)
+#    if RECORD_GAP_MICROS < 16000 && !defined(USE_PROTOCOL_SPECIFIC_FRAME_GAP) && !defined(SUPPRESS_BEO_RECORD_GAP_MICROS_WARNING)
 #error If not defined ENABLE_BEO_WITHOUT_FRAME_GAP, RECORD_GAP_MICROS must be set to a value >= 16000 by "#define RECORD_GAP_MICROS 16000"
 #    endif
 #  endif
@@ -145,6 +149,7 @@
 #define BEO_TRAILING_BIT_SPACE  (4 * BEO_UNIT)   // 12500 The length of the space of stop bit
 #define BEO_START_BIT_SPACE     (5 * BEO_UNIT)   // 15625
 #define BEO_REPEAT_PERIOD       100000 // 100 ms - Not used yet
+#define BEO_FRAME_GAP_MICROS    (BEO_START_BIT_SPACE + (BEO_UNIT / 2)) // 17187 Used for USE_PROTOCOL_SPECIFIC_FRAME_GAP
 
 // It is not allowed to send two ones or zeros, you must send a one or zero and a equal instead.
 
@@ -175,16 +180,24 @@ void IRsend::sendBangOlufsenDataLink(uint32_t aHeader, uint8_t aData, int_fast8_
  * @param aBackToBack   If true send data back to back, which cannot be decoded if ENABLE_BEO_WITHOUT_FRAME_GAP is NOT defined
  */
 void IRsend::sendBangOlufsenRaw(uint32_t aRawData, int_fast8_t aBits, bool aBackToBack) {
-#if defined(USE_NO_SEND_PWM) || defined(SEND_PWM_BY_TIMER) || BEO_KHZ == 38 // BEO_KHZ == 38 is for unit test which runs the B&O protocol with 38 kHz
+#if defined(USE_NO_SEND_PWM) || defined(SEND_PWM_BY_TIMER) || defined(IR_SEND_BACKEND) || defined(SUPPORT_ENCODE_TO_DURATION_SINK) \
+    || BEO_KHZ == 38 // BEO_KHZ == 38 is for unit test which runs the B&O protocol with 38 kHz
 
+#  if !(defined(USE_NO_SEND_PWM) || defined(SEND_PWM_BY_TIMER) || defined(IR_SEND_BACKEND) || BEO_KHZ == 38)
+    if (durationSinkForEncode == nullptr) {
+        return; // Only encoding is supported here
+    }
+#  endif
     /*
      * 455 kHz PWM is currently only supported with SEND_PWM_BY_TIMER defined, otherwise maximum is 180 kHz
      */
 #  if !defined(USE_NO_SEND_PWM)
-#    if defined(SEND_PWM_BY_TIMER)
+#    if defined(SEND_PWM_BY_TIMER) || defined(IR_SEND_BACKEND)
     enableHighFrequencyIROut (BEO_KHZ);
 #    elif (BEO_KHZ == 38)
     enableIROut (BEO_KHZ); // currently only for unit test
+#    elif defined(SUPPORT_ENCODE_TO_DURATION_SINK)
+    enableHighFrequencyIROut (BEO_KHZ);
 #    endif
 #  endif
 
@@ -298,6 +311,40 @@ void IRsend::sendBangOlufsenRawDataLink(uint64_t aRawData, int_fast8_t aBits, bo
 #endif
 }
 
+#if defined(USE_PROTOCOL_SPECIFIC_FRAME_GAP)
+/*
+ * Called by setProtocolSpecificFrameGap() in the ISR, after the first 3 marks and 2 spaces of a frame are recorded.
+ * If they are the first 3 B&O start bits, the frame is not ended by the following long 3. start space.
+ * Marks must be short and the first 2 periods must be 3125 us +/- 25%.
+ * This rejects e.g. the Sony header mark of 2400 us, the RC5 mark of 889 us and the Denon one bit period of 2100 us.
+ */
+#if defined(ESP8266) || defined(ESP32)
+IRAM_ATTR
+#endif
+void IRrecv::checkForBangOlufsenFrameStart() {
+#  if defined(SUPPORT_BEO_DATALINK_TIMING_FOR_DECODE)
+    const uint16_t tMaximumMarkTicks = (BEO_DATALINK_BIT_MARK + (BEO_DATALINK_BIT_MARK / 2)) / MICROS_PER_TICK;
+#  else
+    const uint16_t tMaximumMarkTicks = (2 * BEO_BIT_MARK_FOR_DECODE) / MICROS_PER_TICK;
+#  endif
+    const uint16_t tMinimumPeriodTicks = (BEO_ZERO_SPACE - (BEO_ZERO_SPACE / 4)) / MICROS_PER_TICK;
+    const uint16_t tMaximumPeriodTicks = (BEO_ZERO_SPACE + (BEO_ZERO_SPACE / 4)) / MICROS_PER_TICK;
+
+    for (uint_fast8_t i = 1; i <= 5; i += 2) {
+        if (irparams.rawbuf[i] > tMaximumMarkTicks) {
+            return;
+        }
+    }
+    for (uint_fast8_t i = 1; i <= 3; i += 2) {
+        uint16_t tPeriodTicks = irparams.rawbuf[i] + irparams.rawbuf[i + 1];
+        if (tPeriodTicks < tMinimumPeriodTicks || tPeriodTicks > tMaximumPeriodTicks) {
+            return;
+        }
+    }
+    irparams.FrameGapTicks = BEO_FRAME_GAP_MICROS / MICROS_PER_TICK;
+}
+#endif
+
 #define BEO_MATCH_DELTA (BEO_UNIT / 2 - MICROS_PER_TICK) // use a bigger margin for match than regular matching function
 static bool matchBeoLength(uint16_t aMeasuredTicks, uint16_t aMatchValueMicros) {
     const uint16_t tMeasuredMicros = aMeasuredTicks * MICROS_PER_TICK;
@@ -340,15 +387,15 @@ bool IRrecv::decodeBangOlufsen() {
          * Here we have the AGC part of the "Break at start mode"  i.e. start bit 1 and 2.
          * Test start bit 2 using IR or Datalink timing
          */
-        if ((matchMarkWithGreaterRange(irparams.rawbuf[3], BEO_BIT_MARK_FOR_DECODE)
-                && (matchSpace(irparams.rawbuf[4], BEO_ZERO_SPACE - BEO_BIT_MARK_FOR_DECODE)))
-                || (matchMark(irparams.rawbuf[3], BEO_DATALINK_BIT_MARK)
-                        && matchSpace(irparams.rawbuf[4], BEO_ZERO_SPACE - BEO_DATALINK_BIT_MARK))) {
+        if ((matchMarkWithGreaterRange(rawbufForDecode[3], BEO_BIT_MARK_FOR_DECODE)
+                && (matchSpace(rawbufForDecode[4], BEO_ZERO_SPACE - BEO_BIT_MARK_FOR_DECODE)))
+                || (matchMark(rawbufForDecode[3], BEO_DATALINK_BIT_MARK)
+                        && matchSpace(rawbufForDecode[4], BEO_ZERO_SPACE - BEO_DATALINK_BIT_MARK))) {
             TRACE_PRINTLN(F("B&O: AGC only part (start bits 1 + 2 of 4) detected"));
         } else {
             DEBUG_PRINTLN(F("B&O: No AGC only part (start bits 1 + 2 of 4) detected"));
             DEBUG_PRINT(F("matchMarkWithGreaterRange([3], 250)="));
-            DEBUG_PRINTLN(matchMarkWithGreaterRange(irparams.rawbuf[3], BEO_BIT_MARK_FOR_DECODE));
+            DEBUG_PRINTLN(matchMarkWithGreaterRange(rawbufForDecode[3], BEO_BIT_MARK_FOR_DECODE));
             return false;
         }
     } else {
@@ -362,10 +409,10 @@ bool IRrecv::decodeBangOlufsen() {
             return false;
         }
 
-        if (matchMarkWithGreaterRange(irparams.rawbuf[1], BEO_BIT_MARK_FOR_DECODE)) {
+        if (matchMarkWithGreaterRange(rawbufForDecode[1], BEO_BIT_MARK_FOR_DECODE)) {
 #  if defined(SUPPORT_BEO_DATALINK_TIMING_FOR_DECODE)
             protocolMarkLength = BEO_BIT_MARK_FOR_DECODE;
-        } else if (matchMark(irparams.rawbuf[1], BEO_DATALINK_BIT_MARK)) {
+        } else if (matchMark(rawbufForDecode[1], BEO_DATALINK_BIT_MARK)) {
             protocolMarkLength = BEO_DATALINK_BIT_MARK;
 #  endif
         } else {
@@ -379,8 +426,12 @@ bool IRrecv::decodeBangOlufsen() {
     for (uint8_t tRawBufferMarkIndex = 1; tRawBufferMarkIndex < decodedIRData.rawlen; tRawBufferMarkIndex += 2) {
 #endif // defined(ENABLE_BEO_WITHOUT_FRAME_GAP)
 
-            uint16_t markLength = irparams.rawbuf[tRawBufferMarkIndex];
-            uint16_t spaceLength = irparams.rawbuf[tRawBufferMarkIndex + 1];
+            uint16_t markLength = rawbufForDecode[tRawBufferMarkIndex];
+#if defined(ENABLE_BEO_WITHOUT_FRAME_GAP)
+            uint16_t spaceLength = rawbufForDecode[tRawBufferMarkIndex + 1];
+#else
+            uint16_t spaceLength = getRawbufTicksForDecode(tRawBufferMarkIndex + 1); // The 3. start space is longer than 12750 us
+#endif
 
             TRACE_PRINT(tPulseNumber);
             TRACE_PRINT(' ');
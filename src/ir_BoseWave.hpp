@@ -76,7 +76,7 @@ bool IRrecv::decodeBoseWave() {
     decodePulseDistanceWidthData_P(&BoseWaveProtocolConstants, BOSEWAVE_BITS);
 
     // Stop bit
-    if (!matchMark(irparams.rawbuf[3 + (2 * BOSEWAVE_BITS)], BOSEWAVE_BIT_MARK)) {
+    if (!matchMark(rawbufForDecode[3 + (2 * BOSEWAVE_BITS)], BOSEWAVE_BIT_MARK)) {
         DEBUG_PRINTLN(F("Bose: Stop bit mark length is wrong"));
         return false;
     }
@@ -145,12 +145,12 @@ void IRsend::sendDenon(uint8_t aAddress, uint8_t aCommand, int_fast8_t aNumberOf
         sendPulseDistanceWidthData_P(&DenonProtocolConstants, tData, DENON_BITS);
 
         // Inverted autorepeat frame
-        delay(DENON_AUTO_REPEAT_DISTANCE / MICROS_IN_ONE_MILLI);
+        delayBetweenFrames(DENON_AUTO_REPEAT_DISTANCE / MICROS_IN_ONE_MILLI);
         sendPulseDistanceWidthData_P(&DenonProtocolConstants, tInvertedData, DENON_BITS);
 
         tNumberOfCommands--;
         // send repeated command with a fixed space gap
-        delay( DENON_AUTO_REPEAT_DISTANCE / MICROS_IN_ONE_MILLI);
+        delayBetweenFrames(DENON_AUTO_REPEAT_DISTANCE / MICROS_IN_ONE_MILLI);
     }
     /*
      * always end with a normal frame
@@ -177,7 +177,7 @@ bool IRrecv::decodeDenon() {
 
     // Check for first mark, which is no AGC or start bit. This prevents Sony15 from being decoded as Denon.
     // matchMark is too sensitive!
-    if (irparams.rawbuf[1] >= ((2 * DENON_HEADER_MARK) / MICROS_PER_TICK)) {
+    if (rawbufForDecode[1] >= ((2 * DENON_HEADER_MARK) / MICROS_PER_TICK)) {
         DEBUG_PRINTLN(F("Denon: First mark length is wrong"));
         return false;
     }
@@ -4,8 +4,8 @@
  * Contains only the decoder functions for universal pulse width or pulse distance protocols!
  * The send functions are used by almost all protocols and are therefore located in IRSend.hpp.
  *
- * If RAM is not more than 2k, the decoder only accepts mark or space durations up to 50 * 50 (MICROS_PER_TICK) = 2500 microseconds
- * to save RAM space, otherwise it accepts durations up to 10 ms.
+ * If RAM is not more than 2k, the decoder only accepts mark or space durations up to 50 * 50 us = 2500 microseconds
+ * to save RAM space, otherwise it accepts durations up to 10 ms. Both limits do not depend on MICROS_PER_TICK.
  *
  * This decoder tries to decode the protocols:
  * - Pulse distance with constant pulse length
@@ -78,12 +78,23 @@
 
 #if !defined(DISTANCE_WIDTH_DECODER_DURATION_ARRAY_SIZE)
 #  if (defined(RAMSIZE) && RAMSIZE <= 0x800) || (defined(RAMEND) && RAMEND <= 0x8FF)
-#define DISTANCE_WIDTH_DECODER_DURATION_ARRAY_SIZE 50 // To save program space, the decoder only accepts mark or space durations up to 50 * 50 (MICROS_PER_TICK) = 2500 microseconds
+#define DISTANCE_WIDTH_DECODER_DURATION_ARRAY_SIZE 50 // To save program space, the decoder only accepts mark or space durations up to 50 * 50 us = 2500 microseconds
 #  else
-#define DISTANCE_WIDTH_DECODER_DURATION_ARRAY_SIZE 200 // The decoder accepts mark or space durations up to 200 * 50 (MICROS_PER_TICK) = 10 milliseconds
+#define DISTANCE_WIDTH_DECODER_DURATION_ARRAY_SIZE 200 // The decoder accepts mark or space durations up to 200 * 50 us = 10 milliseconds
 #  endif
 #endif
 
+/*
+ * The index of the duration array has a resolution of 50 us independent of MICROS_PER_TICK,
+ * otherwise 10 us ticks would reduce the maximum duration to 500 us for the small array.
+ */
+#define DISTANCE_WIDTH_DECODER_MICROS_PER_INDEX     50
+#if defined(USE_RUNTIME_MICROS_PER_TICK) || (MICROS_PER_TICK != DISTANCE_WIDTH_DECODER_MICROS_PER_INDEX)
+#define DISTANCE_WIDTH_DECODER_TICKS_TO_INDEX(aTicks)   ((uint16_t) ((((uint32_t) (aTicks) * MICROS_PER_TICK) + (DISTANCE_WIDTH_DECODER_MICROS_PER_INDEX / 2)) / DISTANCE_WIDTH_DECODER_MICROS_PER_INDEX))
+#else
+#define DISTANCE_WIDTH_DECODER_TICKS_TO_INDEX(aTicks)   (aTicks)
+#endif
+
 // Switch the decoding according to your needs
 //#define USE_MSB_DECODING_FOR_DISTANCE_DECODER // If active, it resembles LG, otherwise LSB first as most other protocols e.g. NEC and Kaseikyo/Panasonic
 
@@ -140,7 +151,7 @@ void printDurations(uint8_t aArray[], uint8_t aMaxIndex) {
         Serial.print(aArray[i]);
         if (aArray[i] != 0) {
             Serial.print('x');
-            Serial.print(i * (uint16_t) MICROS_PER_TICK);
+            Serial.print(i * (uint16_t) DISTANCE_WIDTH_DECODER_MICROS_PER_INDEX);
         }
         Serial.print(F(" | "));
     }
@@ -199,14 +210,15 @@ bool aggregateArrayCounts(uint8_t aArray[], uint8_t aMaxIndex, uint8_t *aShortIn
  *
  * Restrictions:
  * Only protocols with at least 7 bits (+ start and trailing stop bit) are accepted.
- * Pulse or pause duration must be below 2500 us (depends on DISTANCE_WIDTH_DECODER_DURATION_ARRAY_SIZE).
+ * Pulse or pause duration must be below 2500 us (depends on DISTANCE_WIDTH_DECODER_DURATION_ARRAY_SIZE), independent of MICROS_PER_TICK.
  *
  * calloc() version is 700 bytes larger :-(
  */
 bool IRrecv::decodeDistanceWidth() {
     /*
-     * Array for up to 49 ticks / 2500 us (or 199  ticks / 10 ms us if RAM > 2k)
-     * tick array index 0 covers mark or space durations from 0 to 49 us, and index 49 from 2450 to 2499 us
+     * Array for up to 49 * 50 us / 2500 us (or 199 * 50 us / 10 ms if RAM > 2k)
+     * Index 0 covers mark or space durations from 0 to 49 us, and index 49 from 2450 to 2499 us.
+     * The short and long durations below are indexes of this array, i.e. 50 us ticks.
      */
     uint8_t tDurationArray[DISTANCE_WIDTH_DECODER_DURATION_ARRAY_SIZE];
 
@@ -232,9 +244,9 @@ bool IRrecv::decodeDistanceWidth() {
      */
     for (IRRawlenType i = 3; i < decodedIRData.rawlen - 2; i += 2) {
 #if(DISTANCE_WIDTH_DECODER_DURATION_ARRAY_SIZE > 0xFF)
-        uint16_t tDurationTicks = irparams.rawbuf[i];
+        uint16_t tDurationTicks = DISTANCE_WIDTH_DECODER_TICKS_TO_INDEX(rawbufForDecode[i]);
 #else
-        auto tDurationTicks = irparams.rawbuf[i];
+        auto tDurationTicks = DISTANCE_WIDTH_DECODER_TICKS_TO_INDEX(rawbufForDecode[i]);
 #endif
         if (tDurationTicks < DISTANCE_WIDTH_DECODER_DURATION_ARRAY_SIZE) {
             tDurationArray[tDurationTicks]++; // count duration if less than DISTANCE_WIDTH_DECODER_DURATION_ARRAY_SIZE
@@ -244,9 +256,9 @@ bool IRrecv::decodeDistanceWidth() {
         } else {
 #if defined(LOCAL_DEBUG) || defined(SHOW_DISTANCE_WIDTH_DECODER_ERRORS)
             Serial.print(F("PULSE_DISTANCE_WIDTH: Mark "));
-            Serial.print(tDurationTicks * MICROS_PER_TICK);
+            Serial.print(tDurationTicks * DISTANCE_WIDTH_DECODER_MICROS_PER_INDEX);
             Serial.print(F(" is longer than maximum "));
-            Serial.print(DISTANCE_WIDTH_DECODER_DURATION_ARRAY_SIZE * MICROS_PER_TICK);
+            Serial.print(DISTANCE_WIDTH_DECODER_DURATION_ARRAY_SIZE * DISTANCE_WIDTH_DECODER_MICROS_PER_INDEX);
             Serial.print(F(" us. Index="));
             Serial.println(i);
 #endif
@@ -280,7 +292,7 @@ bool IRrecv::decodeDistanceWidth() {
      */
     tIndexOfMaxDuration = 0;
     for (IRRawlenType i = 4; i < decodedIRData.rawlen - 2; i += 2) {
-        auto tDurationTicks = irparams.rawbuf[i];
+        auto tDurationTicks = DISTANCE_WIDTH_DECODER_TICKS_TO_INDEX(rawbufForDecode[i]);
         if (tDurationTicks < DISTANCE_WIDTH_DECODER_DURATION_ARRAY_SIZE) {
             tDurationArray[tDurationTicks]++;
             if (tIndexOfMaxDuration < tDurationTicks) {
@@ -289,9 +301,9 @@ bool IRrecv::decodeDistanceWidth() {
         } else {
 #if defined(LOCAL_DEBUG) || defined(SHOW_DISTANCE_WIDTH_DECODER_ERRORS)
             Serial.print(F("PULSE_DISTANCE_WIDTH: Space "));
-            Serial.print(tDurationTicks * MICROS_PER_TICK);
+            Serial.print(tDurationTicks * DISTANCE_WIDTH_DECODER_MICROS_PER_INDEX);
             Serial.print(F(" is longer than maximum "));
-            Serial.print(DISTANCE_WIDTH_DECODER_DURATION_ARRAY_SIZE * MICROS_PER_TICK);
+            Serial.print(DISTANCE_WIDTH_DECODER_DURATION_ARRAY_SIZE * DISTANCE_WIDTH_DECODER_MICROS_PER_INDEX);
             Serial.print(F(" us. Index="));
             Serial.println(i);
 #endif
@@ -346,25 +358,25 @@ bool IRrecv::decodeDistanceWidth() {
     Serial.print(F("DistanceWidthTimingInfoStruct: "));
     Serial.print(tNumberOfBits);
     Serial.print(F(", "));
-    Serial.print(irparams.rawbuf[1] * MICROS_PER_TICK);
+    Serial.print(rawbufForDecode[1] * MICROS_PER_TICK);
     Serial.print(F(", "));
-    Serial.print(irparams.rawbuf[2] * MICROS_PER_TICK);
+    Serial.print(rawbufForDecode[2] * MICROS_PER_TICK);
     Serial.print(F(", "));
     if(tMarkTicksLong == 0) {
-        Serial.print(tMarkTicksShort * MICROS_PER_TICK);
+        Serial.print(tMarkTicksShort * DISTANCE_WIDTH_DECODER_MICROS_PER_INDEX);
     } else {
-        Serial.print(tMarkTicksLong * MICROS_PER_TICK);
+        Serial.print(tMarkTicksLong * DISTANCE_WIDTH_DECODER_MICROS_PER_INDEX);
     }
     Serial.print(F(", "));
     if(tSpaceTicksLong == 0) {
-        Serial.print(tSpaceTicksShort * MICROS_PER_TICK);
+        Serial.print(tSpaceTicksShort * DISTANCE_WIDTH_DECODER_MICROS_PER_INDEX);
     } else {
-        Serial.print(tSpaceTicksLong * MICROS_PER_TICK);
+        Serial.print(tSpaceTicksLong * DISTANCE_WIDTH_DECODER_MICROS_PER_INDEX);
     }
     Serial.print(F(", "));
-    Serial.print(tMarkTicksShort * MICROS_PER_TICK);
+    Serial.print(tMarkTicksShort * DISTANCE_WIDTH_DECODER_MICROS_PER_INDEX);
     Serial.print(F(", "));
-    Serial.println(tSpaceTicksShort * MICROS_PER_TICK);
+    Serial.println(tSpaceTicksShort * DISTANCE_WIDTH_DECODER_MICROS_PER_INDEX);
 #endif
 
     uint8_t tNumberOfAdditionalArrayValues = (tNumberOfBits - 1) / BITS_IN_DECODED_RAW_DATA_TYPE;
@@ -387,10 +399,10 @@ bool IRrecv::decodeDistanceWidth() {
             Serial.println(F("PULSE_DISTANCE_WIDTH signal found"));
         }
 #endif
-    tSpaceMicrosShort = tSpaceTicksShort * MICROS_PER_TICK;
-    unsigned int tMarkMicrosShort = tMarkTicksShort * MICROS_PER_TICK;
-    unsigned int tMarkMicrosLong = tMarkTicksLong * MICROS_PER_TICK;
-    unsigned int tSpaceMicrosLong = tSpaceTicksLong * MICROS_PER_TICK;
+    tSpaceMicrosShort = tSpaceTicksShort * DISTANCE_WIDTH_DECODER_MICROS_PER_INDEX;
+    unsigned int tMarkMicrosShort = tMarkTicksShort * DISTANCE_WIDTH_DECODER_MICROS_PER_INDEX;
+    unsigned int tMarkMicrosLong = tMarkTicksLong * DISTANCE_WIDTH_DECODER_MICROS_PER_INDEX;
+    unsigned int tSpaceMicrosLong = tSpaceTicksLong * DISTANCE_WIDTH_DECODER_MICROS_PER_INDEX;
     IRRawlenType tStartIndex = 3;  // skip leading start bit for decoding.
 
     for (uint_fast8_t i = 0; i <= tNumberOfAdditionalArrayValues; ++i) {
@@ -409,7 +421,7 @@ bool IRrecv::decodeDistanceWidth() {
             decodedIRData.protocol = PULSE_DISTANCE; // NEC etc. + PULSE_DISTANCE_WIDTH
 #if defined(USE_THRESHOLD_DECODER)
             decodeWithThresholdPulseDistanceWidthData(tNumberOfBitsForOneDecode, tStartIndex,
-                    ((tSpaceMicrosLong + tSpaceMicrosShort) / 2) + MARK_EXCESS_MICROS, // MARK_EXCESS_MICROS is 0 here if not explicitly specified by user
+                    ((tSpaceMicrosLong + tSpaceMicrosShort) / 2) + MARK_EXCESS_MICROS_FOR_DECODE, // MARK_EXCESS_MICROS is 0 here if not explicitly specified by user
 #else
             decodePulseDistanceWidthData(tNumberOfBitsForOneDecode, tStartIndex, tSpaceMicrosLong,
 #endif
@@ -430,7 +442,7 @@ bool IRrecv::decodeDistanceWidth() {
             decodedIRData.protocol = PULSE_WIDTH; // Sony
 #if defined(USE_THRESHOLD_DECODER)
             decodeWithThresholdPulseDistanceWidthData(tNumberOfBitsForOneDecode, tStartIndex,
-                    ((tMarkMicrosLong+ tMarkMicrosShort) / 2) - MARK_EXCESS_MICROS, // MARK_EXCESS_MICROS is 0 here if not explicitly specified by user
+                    ((tMarkMicrosLong+ tMarkMicrosShort) / 2) - MARK_EXCESS_MICROS_FOR_DECODE, // MARK_EXCESS_MICROS is 0 here if not explicitly specified by user
 #else
             decodePulseDistanceWidthData(tNumberOfBitsForOneDecode, tStartIndex, tMarkMicrosLong,
 #endif
@@ -472,8 +484,8 @@ bool IRrecv::decodeDistanceWidth() {
     /*
      * Store timing data to reproduce frame for sending
      */
-    decodedIRData.DistanceWidthTimingInfo.HeaderMarkMicros = (irparams.rawbuf[1] * MICROS_PER_TICK);
-    decodedIRData.DistanceWidthTimingInfo.HeaderSpaceMicros = (irparams.rawbuf[2] * MICROS_PER_TICK);
+    decodedIRData.DistanceWidthTimingInfo.HeaderMarkMicros = (rawbufForDecode[1] * MICROS_PER_TICK);
+    decodedIRData.DistanceWidthTimingInfo.HeaderSpaceMicros = (rawbufForDecode[2] * MICROS_PER_TICK);
     decodedIRData.DistanceWidthTimingInfo.ZeroMarkMicros = tMarkMicrosShort;
     decodedIRData.DistanceWidthTimingInfo.ZeroSpaceMicros = tSpaceMicrosShort;
     if (tMarkMicrosLong != 0) {
@@ -501,7 +513,7 @@ bool IRrecv::decodeDistanceWidth() {
 
 #if defined(LOCAL_DEBUG)
     Serial.print(F("DistanceWidthTimingInfo="));
-    IrReceiver.printDistanceWidthTimingInfo(&Serial, &decodedIRData.DistanceWidthTimingInfo);
+    printDistanceWidthTimingInfo(&Serial, &decodedIRData.DistanceWidthTimingInfo);
     Serial.println();
 #endif
     return true;
@@ -88,7 +88,7 @@ void IRsend::sendFAST(uint8_t aCommand, int_fast8_t aNumberOfRepeats) {
         // skip last delay!
         if (tNumberOfCommands > 0) {
             // send repeated command in a fixed raster
-            delay(FAST_REPEAT_DISTANCE / MICROS_IN_ONE_MILLI);
+            delayBetweenFrames(FAST_REPEAT_DISTANCE / MICROS_IN_ONE_MILLI);
         }
     }
 }
@@ -107,7 +107,7 @@ void IRsend::sendJVC(uint8_t aAddress, uint8_t aCommand, int_fast8_t aNumberOfRe
         // skip last delay!
         if (tNumberOfCommands > 0) {
             // send repeated command in a fixed raster
-            delay(JVC_REPEAT_DISTANCE / MICROS_IN_ONE_MILLI);
+            delayBetweenFrames(JVC_REPEAT_DISTANCE / MICROS_IN_ONE_MILLI);
         }
     }
 }
@@ -131,8 +131,8 @@ bool IRrecv::decodeJVC() {
          */
         if (lastDecodedProtocol == JVC
                 && decodedIRData.initialGapTicks < ((JVC_REPEAT_DISTANCE + (JVC_REPEAT_DISTANCE / 4) / MICROS_PER_TICK))
-                && matchMark(irparams.rawbuf[1], JVC_BIT_MARK)
-                && matchMark(irparams.rawbuf[decodedIRData.rawlen - 1], JVC_BIT_MARK)) {
+                && matchMark(rawbufForDecode[1], JVC_BIT_MARK)
+                && matchMark(rawbufForDecode[decodedIRData.rawlen - 1], JVC_BIT_MARK)) {
             /*
              * We have a repeat here, so do not check for start bit
              */
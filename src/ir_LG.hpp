@@ -104,12 +104,16 @@
 
 #define LG_REPEAT_HEADER_SPACE  (4 * LG_UNIT)  // 2104
 #define LG_REPEAT_PERIOD        110000 // Commands are repeated every 110 ms (measured from start to start) for as long as the key on the remote control is held down.
-//#define LG_AVERAGE_DURATION     58000 // LG_HEADER_MARK + LG_HEADER_SPACE  + 32 * 2,5 * LG_UNIT) + LG_UNIT // 2.5 because we assume more zeros than ones
+#define LG_AVERAGE_DURATION     58000 // LG_HEADER_MARK + LG_HEADER_SPACE  + 32 * 2,5 * LG_UNIT) + LG_UNIT // 2.5 because we assume more zeros than ones
 //#define LG_REPEAT_DURATION      (LG_HEADER_MARK  + LG_REPEAT_HEADER_SPACE + LG_BIT_MARK)
-//#define LG_REPEAT_DISTANCE      (LG_REPEAT_PERIOD - LG_AVERAGE_DURATION) // 52 ms
+#define LG_REPEAT_DISTANCE      (LG_REPEAT_PERIOD - LG_AVERAGE_DURATION) // 52 ms
 
-struct PulseDistanceWidthProtocolConstants const LGProtocolConstants PROGMEM= {LG, LG_KHZ, LG_HEADER_MARK, LG_HEADER_SPACE, LG_BIT_MARK,
-    LG_ONE_SPACE, LG_BIT_MARK, LG_ZERO_SPACE, PROTOCOL_IS_MSB_FIRST | PROTOCOL_IS_PULSE_DISTANCE, (LG_REPEAT_PERIOD / MICROS_IN_ONE_MILLI), &sendLGSpecialRepeat};
+struct PulseDistanceWidthProtocolConstants constexpr LGProtocolConstants PROGMEM= {LG, LG_KHZ, LG_HEADER_MARK, LG_HEADER_SPACE, LG_BIT_MARK,
+    LG_ONE_SPACE, LG_BIT_MARK, LG_ZERO_SPACE, PROTOCOL_IS_MSB_FIRST | PROTOCOL_IS_PULSE_DISTANCE, (LG_REPEAT_PERIOD / MICROS_IN_ONE_MILLI),
+    SPECIAL_SEND_REPEAT_FUNCTION(sendLGSpecialRepeat, sendLGRepeat)};
+
+// Compile time view of the constants above, used if USE_TEMPLATE_SEND_FUNCTIONS is defined. Requires constexpr constants.
+typedef PulseDistanceWidthProtocolDescriptor<LGProtocolConstants> LGProtocolDescriptor;
 
 /************************************
  * Start of send and decode functions
@@ -151,7 +155,11 @@ uint32_t IRsend::computeLGRawDataAndChecksum(uint8_t aAddress, uint16_t aCommand
 }
 
 void IRsend::sendLG(uint8_t aAddress, uint16_t aCommand, int_fast8_t aNumberOfRepeats) {
+#if defined(USE_TEMPLATE_SEND_FUNCTIONS)
+    sendPulseDistanceWidth<LGProtocolDescriptor>(computeLGRawDataAndChecksum(aAddress, aCommand), LG_BITS, aNumberOfRepeats);
+#else
     sendPulseDistanceWidth_P(&LGProtocolConstants, computeLGRawDataAndChecksum(aAddress, aCommand), LG_BITS, aNumberOfRepeats);
+#endif
 }
 
 /*
@@ -176,15 +184,15 @@ bool IRrecv::decodeLG() {
     }
 
 // Check header "mark" this must be done for repeat and data
-    if (!matchMark(irparams.rawbuf[1], LG_HEADER_MARK)) {
+    if (!matchMark(rawbufForDecode[1], LG_HEADER_MARK)) {
         DEBUG_PRINTLN(F("LG: Header mark is wrong"));
         return false;
     }
 
 // Check for repeat - here we have another header space length
     if (decodedIRData.rawlen == 4) {
-        if (lastDecodedProtocol == LG && matchSpace(irparams.rawbuf[2], LG_REPEAT_HEADER_SPACE)
-                && matchMark(irparams.rawbuf[3], LG_BIT_MARK)) {
+        if (lastDecodedProtocol == LG && matchSpace(rawbufForDecode[2], LG_REPEAT_HEADER_SPACE)
+                && matchMark(rawbufForDecode[3], LG_BIT_MARK)) {
             decodedIRData.flags = IRDATA_FLAGS_IS_REPEAT | IRDATA_FLAGS_IS_MSB_FIRST;
             decodedIRData.address = lastDecodedAddress;
             decodedIRData.command = lastDecodedCommand;
@@ -196,7 +204,7 @@ bool IRrecv::decodeLG() {
     }
 
 // Check command header space
-    if (!matchSpace(irparams.rawbuf[2], tHeaderSpace)) {
+    if (!matchSpace(rawbufForDecode[2], tHeaderSpace)) {
         DEBUG_PRINTLN(F("LG: Header space length is wrong"));
         return false;
     }
@@ -246,7 +254,11 @@ bool IRrecv::decodeLG() {
  * @param aNumberOfRepeats If < 0 then only a special repeat frame will be sent.
  */
 void IRsend::sendLGRaw(uint32_t aRawData, int_fast8_t aNumberOfRepeats) {
+#if defined(USE_TEMPLATE_SEND_FUNCTIONS)
+    sendPulseDistanceWidth<LGProtocolDescriptor>(aRawData, LG_BITS, aNumberOfRepeats);
+#else
     sendPulseDistanceWidth_P(&LGProtocolConstants, aRawData, LG_BITS, aNumberOfRepeats);
+#endif
 }
 
 bool IRrecv::decodeLGMSB(decode_results *aResults) {
@@ -143,15 +143,6 @@ void IRsend::sendLegoPowerFunctions(uint16_t aRawData, uint8_t aChannel, bool aD
  */
 bool IRrecv::decodeLegoPowerFunctions() {
 
-    /*
-     * Check header timings
-     * Since LEGO_HEADER_MARK is just 158 us use a relaxed threshold compare (237) for it instead of matchMark()
-     */
-    if (!(matchMarkWithGreaterRange(irparams.rawbuf[1], LEGO_HEADER_MARK) && (matchSpace(irparams.rawbuf[2], LEGO_HEADER_SPACE)))) {
-        DEBUG_PRINTLN(F("LEGO: No header mark and space"));
-        return false;
-    }
-
     // Check we have enough data - +4 for initial gap, start bit mark and space + stop bit mark
     if (decodedIRData.rawlen != (2 * LEGO_BITS) + 4) {
         DEBUG_PRINT(F("LEGO: Data length="));
@@ -160,10 +151,19 @@ bool IRrecv::decodeLegoPowerFunctions() {
         return false;
     }
 
+    /*
+     * Check header timings
+     * Since LEGO_HEADER_MARK is just 158 us use a relaxed threshold compare (237) for it instead of matchMark()
+     */
+    if (!(matchMarkWithGreaterRange(rawbufForDecode[1], LEGO_HEADER_MARK) && (matchSpace(rawbufForDecode[2], LEGO_HEADER_SPACE)))) {
+        DEBUG_PRINTLN(F("LEGO: No header mark and space"));
+        return false;
+    }
+
     decodePulseDistanceWidthData(&LegoProtocolConstants, LEGO_BITS);
 
     // Stop bit, use threshold decoding - not required :-)
-//    if (irparams.rawbuf[3 + (2 * LEGO_BITS)] > (2 * LEGO_BIT_MARK)) {
+//    if (rawbufForDecode[3 + (2 * LEGO_BITS)] > (2 * LEGO_BIT_MARK)) {
 //        DEBUG_PRINT(F("LEGO: "));
 //        DEBUG_PRINTLN(F("Stop bit mark length is wrong"));
 //        return false;
@@ -198,14 +198,16 @@ bool IRrecv::decodeMagiQuest() {
 
     /*
      * Decode the 9 bit Magnitude + 8 bit checksum
+     * The space of the last bit is the gap after the frame, which is not contained in rawbuf. So the last bit is taken from its mark.
      */
-    decodePulseDistanceWidthData_P(&MagiQuestProtocolConstants, MAGIQUEST_MAGNITUDE_BITS + MAGIQUEST_CHECKSUM_BITS,
+    decodePulseDistanceWidthData_P(&MagiQuestProtocolConstants, MAGIQUEST_MAGNITUDE_BITS + MAGIQUEST_CHECKSUM_BITS - 1,
             ((MAGIQUEST_WAND_ID_BITS + MAGIQUEST_START_BITS) * 2) + 1);
 
 #if defined(USE_THRESHOLD_DECODER)
-    decodedIRData.decodedRawData = decodedIRData.decodedRawData ^ 0x0001FFFF; // We have 17 bit. For Magiquest a small pause is a 1 which is inverse to threshold decoding
-
+    decodedIRData.decodedRawData = decodedIRData.decodedRawData ^ 0x0000FFFF; // We have 16 bit. For Magiquest a small pause is a 1 which is inverse to threshold decoding
 #endif
+    decodedIRData.decodedRawData = (decodedIRData.decodedRawData << 1)
+            | matchMark(rawbufForDecode[decodedIRData.rawlen - 1], MAGIQUEST_ONE_MARK);
 
     DEBUG_PRINT(F("Magnitude + checksum=0x"));
     DEBUG_PRINTLN(decodedIRData.decodedRawData, HEX);
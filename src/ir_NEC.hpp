@@ -113,14 +113,18 @@
 
 #define APPLE_ADDRESS           0x87EE
 
-struct PulseDistanceWidthProtocolConstants const NECProtocolConstants PROGMEM = {NEC, NEC_KHZ, NEC_HEADER_MARK, NEC_HEADER_SPACE, NEC_BIT_MARK,
+struct PulseDistanceWidthProtocolConstants constexpr NECProtocolConstants PROGMEM = {NEC, NEC_KHZ, NEC_HEADER_MARK, NEC_HEADER_SPACE, NEC_BIT_MARK,
      NEC_ONE_SPACE, NEC_BIT_MARK, NEC_ZERO_SPACE, PROTOCOL_IS_LSB_FIRST | PROTOCOL_IS_PULSE_DISTANCE, (NEC_REPEAT_PERIOD / MICROS_IN_ONE_MILLI),
-     &sendNECSpecialRepeat};
+     SPECIAL_SEND_REPEAT_FUNCTION(sendNECSpecialRepeat, sendNECRepeat)};
 
 // Like NEC but repeats are full frames instead of special NEC repeats
-struct PulseDistanceWidthProtocolConstants const NEC2ProtocolConstants PROGMEM = {NEC2, NEC_KHZ, NEC_HEADER_MARK, NEC_HEADER_SPACE, NEC_BIT_MARK,
+struct PulseDistanceWidthProtocolConstants constexpr NEC2ProtocolConstants PROGMEM = {NEC2, NEC_KHZ, NEC_HEADER_MARK, NEC_HEADER_SPACE, NEC_BIT_MARK,
     NEC_ONE_SPACE, NEC_BIT_MARK, NEC_ZERO_SPACE, PROTOCOL_IS_LSB_FIRST | PROTOCOL_IS_PULSE_DISTANCE, (NEC_REPEAT_PERIOD / MICROS_IN_ONE_MILLI), nullptr};
 
+// Compile time view of the constants above, used if USE_TEMPLATE_SEND_FUNCTIONS is defined. Requires constexpr constants.
+typedef PulseDistanceWidthProtocolDescriptor<NECProtocolConstants> NECProtocolDescriptor;
+typedef PulseDistanceWidthProtocolDescriptor<NEC2ProtocolConstants> NEC2ProtocolDescriptor;
+
 /************************************
  * Start of send and decode functions
  ************************************/
@@ -178,7 +182,11 @@ uint32_t IRsend::computeNECRawDataAndChecksum(uint16_t aAddress, uint16_t aComma
  * @param aNumberOfRepeats  If < 0 then only a special NEC repeat frame will be sent by calling NECProtocolConstants.SpecialSendRepeatFunction().
  */
 void IRsend::sendNEC(uint16_t aAddress, uint16_t aCommand, int_fast8_t aNumberOfRepeats) {
+#if defined(USE_TEMPLATE_SEND_FUNCTIONS)
+    sendPulseDistanceWidth<NECProtocolDescriptor>(computeNECRawDataAndChecksum(aAddress, aCommand), NEC_BITS, aNumberOfRepeats);
+#else
     sendPulseDistanceWidth_P(&NECProtocolConstants, computeNECRawDataAndChecksum(aAddress, aCommand), NEC_BITS, aNumberOfRepeats);
+#endif
 }
 
 /**
@@ -187,7 +195,11 @@ void IRsend::sendNEC(uint16_t aAddress, uint16_t aCommand, int_fast8_t aNumberOf
  *                          will be sent by calling NECProtocolConstants.SpecialSendRepeatFunction().
  */
 void IRsend::sendOnkyo(uint16_t aAddress, uint16_t aCommand, int_fast8_t aNumberOfRepeats) {
+#if defined(USE_TEMPLATE_SEND_FUNCTIONS)
+    sendPulseDistanceWidth<NECProtocolDescriptor>((uint32_t) aCommand << 16 | aAddress, NEC_BITS, aNumberOfRepeats);
+#else
     sendPulseDistanceWidth_P(&NECProtocolConstants, (uint32_t) aCommand << 16 | aAddress, NEC_BITS, aNumberOfRepeats);
+#endif
 }
 
 /**
@@ -196,7 +208,11 @@ void IRsend::sendOnkyo(uint16_t aAddress, uint16_t aCommand, int_fast8_t aNumber
  * @param aNumberOfRepeats  If < 0 then nothing is sent.
  */
 void IRsend::sendNEC2(uint16_t aAddress, uint16_t aCommand, int_fast8_t aNumberOfRepeats) {
+#if defined(USE_TEMPLATE_SEND_FUNCTIONS)
+    sendPulseDistanceWidth<NEC2ProtocolDescriptor>(computeNECRawDataAndChecksum(aAddress, aCommand), NEC_BITS, aNumberOfRepeats);
+#else
     sendPulseDistanceWidth_P(&NEC2ProtocolConstants, computeNECRawDataAndChecksum(aAddress, aCommand), NEC_BITS, aNumberOfRepeats);
+#endif
 }
 
 /**
@@ -217,7 +233,11 @@ void IRsend::sendApple(uint8_t aDeviceId, uint8_t aCommand, int_fast8_t aNumberO
     tRawData.UByte.MidHighByte = aCommand;
     tRawData.UByte.HighByte = aDeviceId; // e.g. 0xD7
 
+#if defined(USE_TEMPLATE_SEND_FUNCTIONS)
+    sendPulseDistanceWidth<NECProtocolDescriptor>(tRawData.ULong, NEC_BITS, aNumberOfRepeats);
+#else
     sendPulseDistanceWidth_P(&NECProtocolConstants, tRawData.ULong, NEC_BITS, aNumberOfRepeats);
+#endif
 }
 
 /**
@@ -226,7 +246,11 @@ void IRsend::sendApple(uint8_t aDeviceId, uint8_t aCommand, int_fast8_t aNumberO
  *                          will be sent by calling NECProtocolConstants.SpecialSendRepeatFunction().
  */
 void IRsend::sendNECRaw(uint32_t aRawData, int_fast8_t aNumberOfRepeats) {
+#if defined(USE_TEMPLATE_SEND_FUNCTIONS)
+    sendPulseDistanceWidth<NECProtocolDescriptor>(aRawData, NEC_BITS, aNumberOfRepeats);
+#else
     sendPulseDistanceWidth_P(&NECProtocolConstants, aRawData, NEC_BITS, aNumberOfRepeats);
+#endif
 }
 
 /**
@@ -247,14 +271,14 @@ bool IRrecv::decodeNEC() {
     }
 
     // Check header "mark" this must be done for repeat and data
-    if (!matchMark(irparams.rawbuf[1], NEC_HEADER_MARK)) {
+    if (!matchMark(rawbufForDecode[1], NEC_HEADER_MARK)) {
         return false;
     }
 
     // Check for repeat - here we have another header space length
     if (decodedIRData.rawlen == 4) {
-        if (matchSpace(irparams.rawbuf[2], NEC_REPEAT_HEADER_SPACE)
-                && matchMark(irparams.rawbuf[3], NEC_BIT_MARK)) {
+        if (matchSpace(rawbufForDecode[2], NEC_REPEAT_HEADER_SPACE)
+                && matchMark(rawbufForDecode[3], NEC_BIT_MARK)) {
             decodedIRData.flags = IRDATA_FLAGS_IS_REPEAT | IRDATA_FLAGS_IS_LSB_FIRST;
             decodedIRData.address = lastDecodedAddress;
             decodedIRData.command = lastDecodedCommand;
@@ -265,7 +289,7 @@ bool IRrecv::decodeNEC() {
     }
 
     // Check command header space
-    if (!matchSpace(irparams.rawbuf[2], NEC_HEADER_SPACE)) {
+    if (!matchSpace(rawbufForDecode[2], NEC_HEADER_SPACE)) {
         DEBUG_PRINTLN(F("NEC: Header space length is wrong"));
         return false;
     }
@@ -242,26 +242,26 @@ bool IRrecv::decodeOpenLASIR() {
     }
 
     // Check header "mark" - this must be done for repeat and data
-    if (!matchMark(irparams.rawbuf[1], NEC_HEADER_MARK)) {
+    if (!matchMark(rawbufForDecode[1], NEC_HEADER_MARK)) {
         return false;
     }
 
-#if !defined(DECODE_NEC) // This code is also contained in NEC sources and does also decode LASIR Repeats :-)
     // Check for repeat - here we have another header space length
     if (decodedIRData.rawlen == 4) {
-        if (matchSpace(irparams.rawbuf[2], NEC_REPEAT_HEADER_SPACE) && matchMark(irparams.rawbuf[3], NEC_BIT_MARK)) {
+#if !defined(DECODE_NEC) // This code is also contained in NEC sources and does also decode LASIR Repeats :-)
+        if (matchSpace(rawbufForDecode[2], NEC_REPEAT_HEADER_SPACE) && matchMark(rawbufForDecode[3], NEC_BIT_MARK)) {
             decodedIRData.flags = IRDATA_FLAGS_IS_REPEAT | IRDATA_FLAGS_IS_LSB_FIRST;
             decodedIRData.address = lastDecodedAddress;
             decodedIRData.command = lastDecodedCommand;
             decodedIRData.protocol = lastDecodedProtocol; // Allow recognition of repeats of another look alike protocol
             return true;
         }
-        return false;
-    }
 #endif
+        return false; // Do not decode 32 bit from a repeat frame
+    }
 
     // Check command header space
-    if (!matchSpace(irparams.rawbuf[2], NEC_HEADER_SPACE)) {
+    if (!matchSpace(rawbufForDecode[2], NEC_HEADER_SPACE)) {
         DEBUG_PRINTLN(F("OpenLASIR: Header space length is wrong"));
         return false;
     }
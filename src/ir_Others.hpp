@@ -215,9 +215,9 @@ void IRsend::sendVelux(uint8_t aCommand, uint8_t aMotorNumber, uint8_t aMotorSet
 void IRsend::sendVelux(uint32_t aData, int_fast8_t aNumberOfRepeats) {
     do {
         sendPulseDistanceWidth_P(&VeluxProtocolConstants, aData, VELUX_BITS, 0);
-        delay(VELUX_AUTOREPEAT_SPACE / MICROS_IN_ONE_MILLI);
+        delayBetweenFrames(VELUX_AUTOREPEAT_SPACE / MICROS_IN_ONE_MILLI);
         sendPulseDistanceWidth_P(&VeluxProtocolConstants, aData, VELUX_BITS, 0);
-        delay(VELUX_REPEAT_SPACE / MICROS_IN_ONE_MILLI);
+        delayBetweenFrames(VELUX_REPEAT_SPACE / MICROS_IN_ONE_MILLI);
         aNumberOfRepeats--;
     } while (aNumberOfRepeats >= 0);
 }
@@ -117,12 +117,12 @@ void IRsend::sendPronto(const uint16_t *data, uint16_t length, int_fast8_t aNumb
      * Now send the trailing space/gap of the intro and all the repeats
      */
     if (intros >= 2) {
-        delay(durations[intros - 1] / MICROS_IN_ONE_MILLI); // equivalent to space(durations[intros - 1]); but allow bigger values for the gap
+        delayBetweenFrames(durations[intros - 1] / MICROS_IN_ONE_MILLI); // equivalent to space(durations[intros - 1]); but allow bigger values for the gap
     }
     for (int i = 0; i < aNumberOfRepeats; i++) {
         sendRaw(durations + intros, repeats - 1, khz);
         if ((i + 1) < aNumberOfRepeats) { // skip last trailing space/gap, see above
-            delay(durations[intros + repeats - 1] / MICROS_IN_ONE_MILLI);
+            delayBetweenFrames(durations[intros + repeats - 1] / MICROS_IN_ONE_MILLI);
         }
     }
 }
@@ -262,7 +262,7 @@ void IRrecv::compensateAndPrintIRResultAsPronto(Print *aSerial, uint16_t aFreque
     dumpNumberHex(aSerial, (decodedIRData.rawlen + 1) / 2);
     dumpNumberHex(aSerial, 0); // no repeat data
     uint16_t timebase = toTimebase(aFrequencyHertz);
-    compensateAndDumpSequence(aSerial, &irparams.rawbuf[1], decodedIRData.rawlen - 1, timebase); // skip leading space
+    compensateAndDumpSequence(aSerial, &rawbufForDecode[1], decodedIRData.rawlen - 1, timebase); // skip leading space
     aSerial->println(F("\";"));
 }
 
@@ -331,7 +331,7 @@ size_t IRrecv::compensateAndStorePronto(String *aString, uint16_t frequency) {
     size += dumpNumberHex(aString, toFrequencyCode(frequency));
     size += dumpNumberHex(aString, (decodedIRData.rawlen + 1) / 2);
     size += dumpNumberHex(aString, 0);
-    size += compensateAndDumpSequence(aString, &irparams.rawbuf[1], decodedIRData.rawlen - 1, timebase); // skip leading space
+    size += compensateAndDumpSequence(aString, &rawbufForDecode[1], decodedIRData.rawlen - 1, timebase); // skip leading space
 
     return size;
 }
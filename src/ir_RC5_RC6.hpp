@@ -202,21 +202,36 @@ void IRsend::sendRC5Marantz(uint8_t aAddress, uint8_t aCommand, int_fast8_t aNum
         tIRData |= 1 << RC5_ADDRESS_BITS;
     }
 
+#if defined(USE_BIPHASE_DURATION_LIST_FOR_SEND)
+    uint16_t tDurationsMicros[BIPHASE_DURATIONS_BUFFER_LENGTH];
+    // start bit 1 followed by the field bit and toggle bit and address
+    uint_fast8_t tNumberOfDurations = appendBiphaseData(tDurationsMicros, 0, RC5_UNIT,
+            tIRData | (1 << (RC5_COMMAND_FIELD_BIT + RC5_TOGGLE_BIT + RC5_ADDRESS_BITS)),
+            1 + RC5_COMMAND_FIELD_BIT + RC5_TOGGLE_BIT + RC5_ADDRESS_BITS, false);
+    tNumberOfDurations = appendMarkOrSpace(tDurationsMicros, tNumberOfDurations, SPACE, MARANTZ_PAUSE_DURATION);
+    tNumberOfDurations = appendBiphaseData(tDurationsMicros, tNumberOfDurations, RC5_UNIT, tIRExtData,
+            RC5_COMMAND_BITS + MARANTZ_COMMAND_EXTENSION_BITS, false);
+#endif
+
     uint_fast8_t tNumberOfCommands = aNumberOfRepeats + 1;
     while (tNumberOfCommands > 0) {
 
+#if defined(USE_BIPHASE_DURATION_LIST_FOR_SEND)
+        sendRaw(tDurationsMicros, tNumberOfDurations, RC5_RC6_KHZ);
+#else
         // start bit is sent by sendBiphaseData followed by the field bit and toggle bit and address
         sendBiphaseData(RC5_UNIT, tIRData, RC5_COMMAND_FIELD_BIT + RC5_TOGGLE_BIT + RC5_ADDRESS_BITS);
         // pause before the bits of command and command extension to indicate that it's Marantz-RC5x
         space(MARANTZ_PAUSE_DURATION); // 3556, Marantz-RC5x has a pause before the bits of command and command extension
         // send command and command extension
         sendBiphaseData(RC5_UNIT, tIRExtData, RC5_COMMAND_BITS + MARANTZ_COMMAND_EXTENSION_BITS, false);
+#endif
 
         tNumberOfCommands--;
         // skip last delay!
         if (tNumberOfCommands > 0) {
             // send repeated command in a fixed raster of 100 ms
-            delay(MARANTZ_REPEAT_DISTANCE / MICROS_IN_ONE_MILLI);
+            delayBetweenFrames(MARANTZ_REPEAT_DISTANCE / MICROS_IN_ONE_MILLI);
         }
     }
 }
@@ -255,17 +270,26 @@ void IRsend::sendRC5(uint8_t aAddress, uint8_t aCommand, int_fast8_t aNumberOfRe
         tIRData |= 1 << (RC5_ADDRESS_BITS + RC5_COMMAND_BITS);
     }
 
+#if defined(USE_BIPHASE_DURATION_LIST_FOR_SEND)
+    uint16_t tDurationsMicros[BIPHASE_DURATIONS_BUFFER_LENGTH];
+    uint_fast8_t tNumberOfDurations = appendBiphaseData(tDurationsMicros, 0, RC5_UNIT, tIRData | (1 << RC5_BITS), 1 + RC5_BITS, false); // with start bit
+#endif
+
     uint_fast8_t tNumberOfCommands = aNumberOfRepeats + 1;
     while (tNumberOfCommands > 0) {
 
+#if defined(USE_BIPHASE_DURATION_LIST_FOR_SEND)
+        sendRaw(tDurationsMicros, tNumberOfDurations, RC5_RC6_KHZ);
+#else
         // start bit is sent by sendBiphaseData
         sendBiphaseData(RC5_UNIT, tIRData, RC5_BITS);
+#endif
 
         tNumberOfCommands--;
         // skip last delay!
         if (tNumberOfCommands > 0) {
             // send repeated command in a fixed raster
-            delay(RC5_REPEAT_DISTANCE / MICROS_IN_ONE_MILLI);
+            delayBetweenFrames(RC5_REPEAT_DISTANCE / MICROS_IN_ONE_MILLI);
         }
     }
 }
@@ -299,6 +323,7 @@ uint8_t IRrecv::getNumberOfUnitsInInterval(uint16_t aCurrentInterval, uint16_t a
  *                1   0   0   0   1   1   0   1   0   1   1  - Space
  *
  * Returns current level [MARK or SPACE] or NO_MARK_OR_SPACE for error (measured time interval is not a multiple of BiphaseTimeUnit).
+ * The library decoders use the faster getBiphaseHalfBits() now, this function is kept for user decoders.
  */
 uint_fast8_t IRrecv::getBiphaselevel() {
     uint_fast8_t tLevelOfCurrentInterval; // Return value: 0 (SPACE) or 1 (MARK)
@@ -314,8 +339,8 @@ uint_fast8_t IRrecv::getBiphaselevel() {
      * i.e. we went to next rawbuf interval
      */
     if (irparams.AlreadyUsedTimingIntervalsOfCurrentInterval == 0) {
-        uint16_t tCurrentIntervalWithMicros = irparams.rawbuf[irparams.RawbuffOffsetForNextBiphaseLevel] * MICROS_PER_TICK;
-        uint16_t tMarkExcessCorrectionMicros = (tLevelOfCurrentInterval == MARK) ? MARK_EXCESS_MICROS : -MARK_EXCESS_MICROS;
+        uint16_t tCurrentIntervalWithMicros = rawbufForDecode[irparams.RawbuffOffsetForNextBiphaseLevel] * MICROS_PER_TICK;
+        uint16_t tMarkExcessCorrectionMicros = (tLevelOfCurrentInterval == MARK) ? MARK_EXCESS_MICROS_FOR_DECODE : -MARK_EXCESS_MICROS_FOR_DECODE;
         irparams.NumberOfTimingIntervalsInCurrentInterval = getNumberOfUnitsInInterval(
                 tCurrentIntervalWithMicros + tMarkExcessCorrectionMicros, irparams.BiphaseTimeUnit);
         // 666 is 3/4 of RC5 time unit
@@ -343,6 +368,68 @@ uint_fast8_t IRrecv::getBiphaselevel() {
 
     return tLevelOfCurrentInterval;
 }
+
+/**
+ * Converts the rawbuf timings starting at aRCDecodeRawbuffOffset in one pass into a packed stream of half bits (time units),
+ * 1 for MARK and 0 for SPACE, half bit 0 is stored in bit 0 of aHalfBitBuffer[0].
+ * This replaces the multiplication and division of getBiphaselevel() for each rawbuf entry by comparisons with tick thresholds,
+ * which are computed once per call. Only intervals longer than 3.5 units, like the Marantz pause, use the division.
+ * The buffer is cleared before, so all half bits after the end of the stream are SPACE, like for getBiphaselevel().
+ * @return Number of half bits or 0 for error, i.e. an interval is shorter than half a unit or the buffer is too small.
+ */
+uint_fast8_t IRrecv::getBiphaseHalfBits(uint8_t *aHalfBitBuffer, uint_fast8_t aHalfBitBufferSize, uint_fast8_t aRCDecodeRawbuffOffset,
+        uint16_t aBiphaseTimeUnit) {
+    /*
+     * Minimum ticks for 1, 2, 3 and 4 units of a SPACE and a MARK interval. Margin is 1/2 of unit, like for getNumberOfUnitsInInterval().
+     */
+    uint16_t tMinimumTicksForUnits[2][4];
+    for (uint_fast8_t i = 0; i < 4; i++) {
+        uint16_t tMinimumMicros = ((i + 1) * aBiphaseTimeUnit) - (aBiphaseTimeUnit / 2);
+        tMinimumTicksForUnits[SPACE][i] = (tMinimumMicros + MARK_EXCESS_MICROS_FOR_DECODE + (MICROS_PER_TICK - 1)) / MICROS_PER_TICK;
+        tMinimumTicksForUnits[MARK][i] = (tMinimumMicros - MARK_EXCESS_MICROS_FOR_DECODE + (MICROS_PER_TICK - 1)) / MICROS_PER_TICK;
+    }
+
+    memset(aHalfBitBuffer, 0, aHalfBitBufferSize);
+    uint_fast8_t tMaximumNumberOfHalfBits = (aHalfBitBufferSize * 8) - 1; // Keep one SPACE for reading pairs of half bits
+    uint_fast8_t tNumberOfHalfBits = 0;
+
+    for (IRRawlenType i = aRCDecodeRawbuffOffset; i < decodedIRData.rawlen; i++) {
+        uint_fast8_t tLevel = i & 1; // on odd rawbuf offsets we have mark timings
+        IRRawbufType tTicks = rawbufForDecode[i];
+        uint16_t *tMinimumTicksPtr = tMinimumTicksForUnits[tLevel];
+        uint_fast8_t tNumberOfUnits;
+        if (tTicks < tMinimumTicksPtr[0]) {
+            return 0;
+        } else if (tTicks < tMinimumTicksPtr[1]) {
+            tNumberOfUnits = 1;
+        } else if (tTicks < tMinimumTicksPtr[2]) {
+            tNumberOfUnits = 2;
+        } else if (tTicks < tMinimumTicksPtr[3]) {
+            tNumberOfUnits = 3;
+        } else {
+            uint16_t tMarkExcessCorrectionMicros = (tLevel == MARK) ? MARK_EXCESS_MICROS_FOR_DECODE : -MARK_EXCESS_MICROS_FOR_DECODE;
+            tNumberOfUnits = getNumberOfUnitsInInterval((tTicks * MICROS_PER_TICK) + tMarkExcessCorrectionMicros, aBiphaseTimeUnit);
+        }
+
+        if (tNumberOfUnits > tMaximumNumberOfHalfBits - tNumberOfHalfBits) {
+            return 0;
+        }
+        if (tLevel == MARK) {
+            for (uint_fast8_t j = 0; j < tNumberOfUnits; j++) {
+                aHalfBitBuffer[(tNumberOfHalfBits + j) / 8] |= 1 << ((tNumberOfHalfBits + j) % 8);
+            }
+        }
+        tNumberOfHalfBits += tNumberOfUnits;
+    }
+    return tNumberOfHalfBits;
+}
+
+/**
+ * @return MARK or SPACE of the half bit at aHalfBitIndex in the stream generated by getBiphaseHalfBits()
+ */
+uint_fast8_t IRrecv::getBiphaseHalfBit(const uint8_t *aHalfBitBuffer, uint_fast8_t aHalfBitIndex) {
+    return (aHalfBitBuffer[aHalfBitIndex / 8] >> (aHalfBitIndex % 8)) & 1;
+}
 # endif // defined(DECODE_RC5) || defined(DECODE_MARANTZ) || defined(DECODE_RC6)
 
 #if defined(DECODE_RC5) || defined(DECODE_MARANTZ)
@@ -365,9 +452,6 @@ bool IRrecv::decodeRC5() {
     uint8_t tBitIndex;
     uint32_t tDecodedRawData = 0;
 
-    // Set Biphase decoding start values
-    initBiphaselevel(1, RC5_UNIT); // Skip gap space
-
     // Check we have the right amount of data (14 to 26). The +1 is for initial gap. +2 for initial gap and mark of last bit which is a 1
     if (decodedIRData.rawlen < (RC5_BITS + 1)  /* 14 */ ||
 #if defined(DECODE_MARANTZ)
@@ -388,56 +472,55 @@ bool IRrecv::decodeRC5() {
     }
 
     // Check length of first mark / header
-    if (irparams.rawbuf[1] > (((2 * RC5_UNIT) + (RC5_UNIT / 2)) / MICROS_PER_TICK)) {
+    if (rawbufForDecode[1] > (((2 * RC5_UNIT) + (RC5_UNIT / 2)) / MICROS_PER_TICK)) {
         DEBUG_PRINTLN(F("RC5: first MARK is too long"));
         return false;
     }
 
-    // Check start bit, the first space is included in the gap
-    if (getBiphaselevel() != MARK) {
-        DEBUG_PRINTLN(F("RC5: first getBiphaselevel() is not MARK"));
+    uint8_t tHalfBits[BIPHASE_HALF_BIT_BUFFER_SIZE];
+    uint_fast8_t tNumberOfHalfBits = getBiphaseHalfBits(tHalfBits, sizeof(tHalfBits), 1, RC5_UNIT); // Skip gap space
+    if (tNumberOfHalfBits == 0) {
+        DEBUG_PRINTLN(F("RC5: mark or space length is no multiple of unit"));
         return false;
     }
 
     /*
+     * Skip the mark of the start bit, the first space is included in the gap. It is always a MARK, since rawbuf[1] is a mark.
      * Get data bits - MSB first
      */
 #if defined(DECODE_MARANTZ)
     bool RC5Marantz = false;
 #endif
-    for (tBitIndex = 0; irparams.RawbuffOffsetForNextBiphaseLevel < decodedIRData.rawlen; tBitIndex++) {
+    uint_fast8_t tHalfBitIndex = 1;
+    for (tBitIndex = 0; tHalfBitIndex < tNumberOfHalfBits; tBitIndex++) {
         // get next 2 levels and check for transition
-        uint8_t tStartLevel = getBiphaselevel();
-        uint8_t tEndLevel = getBiphaselevel();
-
-        if ((tStartLevel == SPACE) && (tEndLevel == MARK)) {
-            // we have a space to mark transition here
-            tDecodedRawData = (tDecodedRawData << 1) | 1;
-        } else if ((tStartLevel == MARK) && (tEndLevel == SPACE)) {
-            // we have a mark to space transition here
-            tDecodedRawData = (tDecodedRawData << 1) | 0;
+        uint_fast8_t tStartLevel = getBiphaseHalfBit(tHalfBits, tHalfBitIndex);
+        uint_fast8_t tEndLevel = getBiphaseHalfBit(tHalfBits, tHalfBitIndex + 1);
+        tHalfBitIndex += 2;
+
+        if (tStartLevel ^ tEndLevel) {
+            // we have a space to mark transition -> 1 or a mark to space transition -> 0 here
+            tDecodedRawData = (tDecodedRawData << 1) | tEndLevel;
 #if defined(DECODE_MARANTZ)
-        } else if (tBitIndex == MARANTZ_PAUSE_BIT_INDEX) {
+        } else if (tBitIndex == MARANTZ_PAUSE_BIT_INDEX && tStartLevel == SPACE) {
             /*
              * Check for RC5 Marantz format i.e. long space after 8 bits (including start bit)
-             * Check if timing buffer contains a pause, which is longer than 3/4 the expected pause
-             * Some dumb compiler throw a warning: comparison is always false due to limited range of data type [-Wtype-limits] which is nonsense
+             * Here we are at the space interval and have 4 cases:
+             * With 0 -> mark+space and 1 -> space+mark and pause = 4*space we get the following space length
+             * 0 | pause | 0 -> 5*space
+             * 0 | pause | 1 -> 6*space
+             * 1 | pause | 0 -> 4*space
+             * 1 | pause | 1 -> 5*space
+             * We already consumed 2 units of the pause to get here, so the next 2 units must be a space too.
              */
-            if (irparams.rawbuf[irparams.RawbuffOffsetForNextBiphaseLevel] > ((MARANTZ_PAUSE_DURATION * 3L) / (MICROS_PER_TICK * 4L))) { // 3556 * 3 / 200 = 53
+            if (tHalfBitIndex + 2 <= tNumberOfHalfBits && getBiphaseHalfBit(tHalfBits, tHalfBitIndex) == SPACE
+                    && getBiphaseHalfBit(tHalfBits, tHalfBitIndex + 1) == SPACE) {
                 RC5Marantz = true;
                 DEBUG_PRINTLN(F("Marantz detected"));
-                /*
-                 * Here we are at the space interval and have 4 cases:
-                 * With 0 -> mark+space and 1 -> space+mark and pause = 4*space we get the following space length
-                 * 0 | pause | 0 -> 5*space
-                 * 0 | pause | 1 -> 6*space
-                 * 1 | pause | 0 -> 4*space
-                 * 1 | pause | 1 -> 5*space
-                 */
-                irparams.AlreadyUsedTimingIntervalsOfCurrentInterval += 2; // We already consumed 2 to get here
-                if (irparams.AlreadyUsedTimingIntervalsOfCurrentInterval >= irparams.NumberOfTimingIntervalsInCurrentInterval){
-                    irparams.RawbuffOffsetForNextBiphaseLevel++;
-                }
+                tHalfBitIndex += 2;
+            } else {
+                DEBUG_PRINTLN(F("RC5: no transition and no Marantz pause found, decode failed"));
+                return false;
             }
 #endif
         } else {
@@ -600,6 +683,9 @@ void IRsend::sendRC6(uint32_t aRawData, uint8_t aNumberOfBitsToSend) { // Deprec
     sendRC6Raw(aRawData, aNumberOfBitsToSend);
 }
 void IRsend::sendRC6Raw(uint32_t aRawData, uint8_t aNumberOfBitsToSend) {
+#if defined(USE_BIPHASE_DURATION_LIST_FOR_SEND)
+    sendRC6Raw((uint64_t) aRawData, aNumberOfBitsToSend);
+#else
 // Set IR carrier frequency
     enableIROut (RC5_RC6_KHZ);
 
@@ -624,6 +710,7 @@ void IRsend::sendRC6Raw(uint32_t aRawData, uint8_t aNumberOfBitsToSend) {
             mark(t);
         }
     }
+#endif
 }
 
 /**
@@ -634,6 +721,21 @@ void IRsend::sendRC6(uint64_t aRawData, uint8_t aNumberOfBitsToSend) { // Deprec
     sendRC6Raw(aRawData, aNumberOfBitsToSend);
 }
 void IRsend::sendRC6Raw(uint64_t aRawData, uint8_t aNumberOfBitsToSend) {
+#if defined(USE_BIPHASE_DURATION_LIST_FOR_SEND)
+    uint16_t tDurationsMicros[BIPHASE_DURATIONS_BUFFER_LENGTH];
+    tDurationsMicros[0] = RC6_HEADER_MARK;
+    tDurationsMicros[1] = RC6_HEADER_SPACE;
+    // Leading bit 1, appended separately, since 64 data bits plus the leading bit do not fit into aData
+    uint_fast8_t tNumberOfDurations = appendBiphaseData(tDurationsMicros, 2, RC6_UNIT, 1, 1, true);
+    // Data MSB first. The fourth data bit is the double width toggle bit.
+    tNumberOfDurations = appendBiphaseData(tDurationsMicros, tNumberOfDurations, RC6_UNIT, aRawData, aNumberOfBitsToSend, true,
+            RC6_TOGGLE_BIT_INDEX);
+    if (tNumberOfDurations != BIPHASE_DURATIONS_OVERFLOW) {
+        sendRaw(tDurationsMicros, tNumberOfDurations, RC5_RC6_KHZ);
+        return;
+    }
+    // More than 38 bits may not fit into the buffer, so send them bit by bit with the code below
+#endif
 // Set IR carrier frequency
     enableIROut (RC5_RC6_KHZ);
 
@@ -697,7 +799,7 @@ void IRsend::sendRC6(uint8_t aAddress, uint8_t aCommand, int_fast8_t aNumberOfRe
         // skip last delay!
         if (tNumberOfCommands > 0) {
             // send repeated command in a fixed raster
-            delay(RC6_REPEAT_DISTANCE / MICROS_IN_ONE_MILLI);
+            delayBetweenFrames(RC6_REPEAT_DISTANCE / MICROS_IN_ONE_MILLI);
         }
     }
 }
@@ -743,7 +845,7 @@ void IRsend::sendRC6A(uint8_t aAddress, uint8_t aCommand, int_fast8_t aNumberOfR
         // skip last delay!
         if (tNumberOfCommands > 0) {
             // send repeated command in a fixed raster
-            delay(RC6_REPEAT_DISTANCE / MICROS_IN_ONE_MILLI);
+            delayBetweenFrames(RC6_REPEAT_DISTANCE / MICROS_IN_ONE_MILLI);
         }
     }
 }
@@ -780,64 +882,57 @@ bool IRrecv::decodeRC6() {
     }
 
     // Check header "mark" and "space", this must be done for repeat and data
-    if (!matchMark(irparams.rawbuf[1], RC6_HEADER_MARK) || !matchSpace(irparams.rawbuf[2], RC6_HEADER_SPACE)) {
+    if (!matchMark(rawbufForDecode[1], RC6_HEADER_MARK) || !matchSpace(rawbufForDecode[2], RC6_HEADER_SPACE)) {
         // no debug output, since this check is mainly to determine the received protocol
         DEBUG_PRINTLN(F("RC6: Header mark or space length is wrong"));
         return false;
     }
 
-    // Set Biphase decoding start values
-    initBiphaselevel(3, RC6_UNIT); // Skip gap-space and start-bit mark and space
+    uint8_t tHalfBits[BIPHASE_HALF_BIT_BUFFER_SIZE];
+    uint_fast8_t tNumberOfHalfBits = getBiphaseHalfBits(tHalfBits, sizeof(tHalfBits), 3, RC6_UNIT); // Skip gap-space and start-bit mark and space
+    if (tNumberOfHalfBits == 0) {
+        DEBUG_PRINTLN(F("RC6: mark or space length is no multiple of unit"));
+        return false;
+    }
 
     /*
      * Check first bit, which is known to be a 1 (mark->space)
      */
-    if (getBiphaselevel() != MARK) {
-        DEBUG_PRINTLN(F("RC6: first getBiphaselevel() is not MARK"));
-        return false;
-    }
-    if (getBiphaselevel() != SPACE) {
-        DEBUG_PRINTLN(F("RC6: second getBiphaselevel() is not SPACE"));
+    if (getBiphaseHalfBit(tHalfBits, 0) != MARK || getBiphaseHalfBit(tHalfBits, 1) != SPACE) {
+        DEBUG_PRINTLN(F("RC6: first bit is not 1"));
         return false;
     }
 
     // Now start decoding at bit 2 / mode bits
-    for (tBitIndex = 0; irparams.RawbuffOffsetForNextBiphaseLevel < decodedIRData.rawlen; tBitIndex++) {
-        uint8_t tStartLevel; // start level of coded bit
-        uint8_t tEndLevel;   // end level of coded bit
-
-        tStartLevel = getBiphaselevel();
-        tEndLevel = getBiphaselevel();
+    uint_fast8_t tHalfBitIndex = 2;
+    for (tBitIndex = 0; tHalfBitIndex < tNumberOfHalfBits; tBitIndex++) {
+        uint_fast8_t tStartLevel = getBiphaseHalfBit(tHalfBits, tHalfBitIndex); // start level of coded bit
+        uint_fast8_t tEndLevel = getBiphaseHalfBit(tHalfBits, tHalfBitIndex + 1); // end level of coded bit
+        tHalfBitIndex += 2;
 
         if (tBitIndex == RC6_TOGGLE_BIT_INDEX) {
             /*
              * Toggle bit is double wide; level of 1. and 2. time slot and 3. and 4.time slot must be equal
              */
-            if (tStartLevel != tEndLevel) { // 1. and 2. time slot must be equal
-                DEBUG_PRINTLN(F("RC6: Toggle mark or space length is wrong"));
-                return false;
-            }
-            tEndLevel = getBiphaselevel();
-            if (tEndLevel != getBiphaselevel()) { // 3. and 4. time slot must be equal
+            tEndLevel = getBiphaseHalfBit(tHalfBits, tHalfBitIndex);
+            if (tStartLevel != getBiphaseHalfBit(tHalfBits, tHalfBitIndex - 1)
+                    || tEndLevel != getBiphaseHalfBit(tHalfBits, tHalfBitIndex + 1)) {
                 DEBUG_PRINTLN(F("RC6: Toggle mark or space length is wrong"));
                 return false;
             }
+            tHalfBitIndex += 2;
         }
 
         /*
          * Determine tDecodedRawData bit value by checking the transition type
+         * mark to space transition -> 1, space to mark transition -> 0, inverted value compared to RC5
          */
-        if ((tStartLevel == MARK) && (tEndLevel == SPACE)) {
-            // we have a mark to space transition here -> 1
-            tDecodedRawData = (tDecodedRawData << 1) | 1;  // inverted value compared to RC5
-        } else if ((tStartLevel == SPACE) && (tEndLevel == MARK)) {
-            // we have a space to mark transition here -> 0
-            tDecodedRawData = (tDecodedRawData << 1);
-        } else {
+        if ((tStartLevel ^ tEndLevel) == 0) {
             DEBUG_PRINTLN(F("RC6: Decode failed"));
-            // we have no transition here or one level is -1 -> error
+            // we have no transition here -> error
             return false;            // Error
         }
+        tDecodedRawData = (tDecodedRawData << 1) | tStartLevel;
     }
 
 // Success
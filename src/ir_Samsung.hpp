@@ -93,19 +93,23 @@
 #define SAMSUNG_ONE_SPACE           (3 * SAMSUNG_UNIT) // 1690 | 33.8  TICKS_LOW = 25.07 TICKS_HIGH = 45.0
 #define SAMSUNG_ZERO_SPACE          SAMSUNG_UNIT
 
-#define SAMSUNG_AVERAGE_DURATION    55000 // Not used. SAMSUNG_HEADER_MARK + SAMSUNG_HEADER_SPACE  + 32 * 2,5 * SAMSUNG_UNIT + SAMSUNG_UNIT // 2.5 because we assume more zeros than ones
+#define SAMSUNG_AVERAGE_DURATION    55000 // Used for writeBatch(). SAMSUNG_HEADER_MARK + SAMSUNG_HEADER_SPACE  + 32 * 2,5 * SAMSUNG_UNIT + SAMSUNG_UNIT // 2.5 because we assume more zeros than ones
 #define SAMSUNG_REPEAT_DURATION     (SAMSUNG_HEADER_MARK  + SAMSUNG_HEADER_SPACE + SAMSUNG_BIT_MARK + SAMSUNG_ZERO_SPACE + SAMSUNG_BIT_MARK)
 #define SAMSUNG_REPEAT_PERIOD       110000 // Commands are repeated every 110 ms (measured from start to start) for as long as the key on the remote control is held down.
 #define SAMSUNG_MAXIMUM_REPEAT_DISTANCE     (SAMSUNG_REPEAT_PERIOD + (SAMSUNG_REPEAT_PERIOD / 4)) // 137000 - Just a guess
 
 // 19 byte RAM
-struct PulseDistanceWidthProtocolConstants const SamsungProtocolConstants PROGMEM = {SAMSUNG, SAMSUNG_KHZ, SAMSUNG_HEADER_MARK,
+struct PulseDistanceWidthProtocolConstants constexpr SamsungProtocolConstants PROGMEM = {SAMSUNG, SAMSUNG_KHZ, SAMSUNG_HEADER_MARK,
     SAMSUNG_HEADER_SPACE, SAMSUNG_BIT_MARK, SAMSUNG_ONE_SPACE, SAMSUNG_BIT_MARK, SAMSUNG_ZERO_SPACE, PROTOCOL_IS_LSB_FIRST | PROTOCOL_IS_PULSE_DISTANCE,
     (SAMSUNG_REPEAT_PERIOD / MICROS_IN_ONE_MILLI), nullptr};
 
-struct PulseDistanceWidthProtocolConstants const SamsungLGProtocolConstants PROGMEM = {SAMSUNGLG, SAMSUNG_KHZ, SAMSUNG_HEADER_MARK,
+struct PulseDistanceWidthProtocolConstants constexpr SamsungLGProtocolConstants PROGMEM = {SAMSUNGLG, SAMSUNG_KHZ, SAMSUNG_HEADER_MARK,
     SAMSUNG_HEADER_SPACE, SAMSUNG_BIT_MARK, SAMSUNG_ONE_SPACE, SAMSUNG_BIT_MARK, SAMSUNG_ZERO_SPACE, PROTOCOL_IS_LSB_FIRST | PROTOCOL_IS_PULSE_DISTANCE,
-    (SAMSUNG_REPEAT_PERIOD / MICROS_IN_ONE_MILLI), &sendSamsungLGSpecialRepeat};
+    (SAMSUNG_REPEAT_PERIOD / MICROS_IN_ONE_MILLI), SPECIAL_SEND_REPEAT_FUNCTION(sendSamsungLGSpecialRepeat, sendSamsungLGRepeat)};
+
+// Compile time view of the constants above, used if USE_TEMPLATE_SEND_FUNCTIONS is defined. Requires constexpr constants.
+typedef PulseDistanceWidthProtocolDescriptor<SamsungProtocolConstants> SamsungProtocolDescriptor;
+typedef PulseDistanceWidthProtocolDescriptor<SamsungLGProtocolConstants> SamsungLGProtocolDescriptor;
 /************************************
  * Start of send and decode functions
  ************************************/
@@ -158,7 +162,11 @@ void IRsend::sendSamsungLG(uint16_t aAddress, uint16_t aCommand, int_fast8_t aNu
     tRawData.UByte.MidHighByte = aCommand;
     tRawData.UByte.HighByte = ~aCommand;
 
+#if defined(USE_TEMPLATE_SEND_FUNCTIONS)
+    sendPulseDistanceWidth<SamsungLGProtocolDescriptor>(tRawData.ULong, SAMSUNG_BITS, aNumberOfRepeats);
+#else
     sendPulseDistanceWidth_P(&SamsungLGProtocolConstants, tRawData.ULong, SAMSUNG_BITS, aNumberOfRepeats);
+#endif
 }
 
 /**
@@ -192,7 +200,11 @@ void IRsend::sendSamsung(uint16_t aAddress, uint16_t aCommand, int_fast8_t aNumb
         tSendValue.UWords[1] = aCommand;
     }
 
+#if defined(USE_TEMPLATE_SEND_FUNCTIONS)
+    sendPulseDistanceWidth<SamsungProtocolDescriptor>(tSendValue.ULong, SAMSUNG_BITS, aNumberOfRepeats);
+#else
     sendPulseDistanceWidth_P(&SamsungProtocolConstants, tSendValue.ULong, SAMSUNG_BITS, aNumberOfRepeats);
+#endif
 }
 
 /**
@@ -209,7 +221,11 @@ void IRsend::sendSamsung16BitAddressAnd8BitCommand(uint16_t aAddress, uint8_t aC
     tSendValue.UBytes[2] = aCommand;
     tSendValue.UBytes[3] = ~aCommand;
 
+#if defined(USE_TEMPLATE_SEND_FUNCTIONS)
+    sendPulseDistanceWidth<SamsungProtocolDescriptor>(tSendValue.ULong, SAMSUNG_BITS, aNumberOfRepeats);
+#else
     sendPulseDistanceWidth_P(&SamsungProtocolConstants, tSendValue.ULong, SAMSUNG_BITS, aNumberOfRepeats);
+#endif
 }
 
 /**
@@ -225,7 +241,11 @@ void IRsend::sendSamsung16BitAddressAndCommand(uint16_t aAddress, uint16_t aComm
     // Send 16 command bits
     tSendValue.UWords[1] = aCommand;
 
+#if defined(USE_TEMPLATE_SEND_FUNCTIONS)
+    sendPulseDistanceWidth<SamsungProtocolDescriptor>(tSendValue.ULong, SAMSUNG_BITS, aNumberOfRepeats);
+#else
     sendPulseDistanceWidth_P(&SamsungProtocolConstants, tSendValue.ULong, SAMSUNG_BITS, aNumberOfRepeats);
+#endif
 }
 /**
  * Here we send Samsung48
@@ -282,13 +302,16 @@ bool IRrecv::decodeSamsung() {
         return false;
     }
 
-    // Check for SansungLG style repeat
-    if (lastDecodedProtocol == SAMSUNGLG && decodedIRData.rawlen == 6) {
-        decodedIRData.flags = IRDATA_FLAGS_IS_REPEAT | IRDATA_FLAGS_IS_PROTOCOL_WITH_DIFFERENT_REPEAT | IRDATA_FLAGS_IS_LSB_FIRST;
-        decodedIRData.address = lastDecodedAddress;
-        decodedIRData.command = lastDecodedCommand;
-        decodedIRData.protocol = SAMSUNGLG;
-        return true;
+    // Check for SansungLG style repeat. The first frame of SamsungLG is decoded as Samsung, since it is binary identical.
+    if (decodedIRData.rawlen == 6) {
+        if (lastDecodedProtocol == SAMSUNGLG || lastDecodedProtocol == SAMSUNG) {
+            decodedIRData.flags = IRDATA_FLAGS_IS_REPEAT | IRDATA_FLAGS_IS_PROTOCOL_WITH_DIFFERENT_REPEAT | IRDATA_FLAGS_IS_LSB_FIRST;
+            decodedIRData.address = lastDecodedAddress;
+            decodedIRData.command = lastDecodedCommand;
+            decodedIRData.protocol = SAMSUNGLG;
+            return true;
+        }
+        return false; // Do not decode 32 bit from the 1 bit of a repeat frame
     }
 
     /*
@@ -86,11 +86,15 @@
 #define SONY_DURATION_MIN       17400 // SONY_HEADER_MARK + SONY_SPACE + 12 * 2 * SONY_UNIT = 29 * SONY_UNIT
 #define SONY_DURATION_MAX       37200 // SONY_HEADER_MARK + SONY_SPACE + 20 * 3 * SONY_UNIT = 65 * SONY_UNIT
 #define SONY_REPEAT_PERIOD      45000 // Commands are repeated every 45 ms (measured from start to start) for as long as the key on the remote control is held down.
-#define SONY_MAXIMUM_REPEAT_DISTANCE    (SONY_REPEAT_PERIOD - SONY_DURATION_MIN) // 27,6 ms
+// The last space is not part of the frame and senders like ours compute the gap with millisecond resolution
+#define SONY_MAXIMUM_REPEAT_DISTANCE    (SONY_REPEAT_PERIOD - SONY_DURATION_MIN + SONY_SPACE + MICROS_IN_ONE_MILLI) // 29,2 ms
 
-struct PulseDistanceWidthProtocolConstants const SonyProtocolConstants PROGMEM = { SONY, SONY_KHZ, SONY_HEADER_MARK, SONY_SPACE, SONY_ONE_MARK,
+struct PulseDistanceWidthProtocolConstants constexpr SonyProtocolConstants PROGMEM = { SONY, SONY_KHZ, SONY_HEADER_MARK, SONY_SPACE, SONY_ONE_MARK,
 SONY_SPACE, SONY_ZERO_MARK, SONY_SPACE, PROTOCOL_IS_LSB_FIRST | PROTOCOL_IS_PULSE_WIDTH, (SONY_REPEAT_PERIOD / MICROS_IN_ONE_MILLI), nullptr };
 
+// Compile time view of the constants above, used if USE_TEMPLATE_SEND_FUNCTIONS is defined. Requires constexpr constants.
+typedef PulseDistanceWidthProtocolDescriptor<SonyProtocolConstants> SonyProtocolDescriptor;
+
 /************************************
  * Start of send and decode functions
  ************************************/
@@ -101,7 +105,11 @@ SONY_SPACE, SONY_ZERO_MARK, SONY_SPACE, PROTOCOL_IS_LSB_FIRST | PROTOCOL_IS_PULS
 void IRsend::sendSony(uint16_t aAddress, uint8_t aCommand, int_fast8_t aNumberOfRepeats, uint8_t numberOfBits) {
     uint32_t tData = (uint32_t) aAddress << 7 | (aCommand & 0x7F);
     // send 5, 8, 13 address bits LSB first
+#if defined(USE_TEMPLATE_SEND_FUNCTIONS)
+    sendPulseDistanceWidth<SonyProtocolDescriptor>(tData, numberOfBits, aNumberOfRepeats);
+#else
     sendPulseDistanceWidth_P(&SonyProtocolConstants, tData, numberOfBits, aNumberOfRepeats);
+#endif
 }
 
 bool IRrecv::decodeSony() {
@@ -31,7 +31,7 @@
  and add your protocol in the same way as it is already done for BOSEWAVE.
 
  You have to change the following files:
- IRSend.hpp     IRsend::write(IRData *aIRSendData + int_fast8_t aNumberOfRepeats)
+ IRSend.hpp     IRsend::write(const IRData *aIRSendData + int_fast8_t aNumberOfRepeats)
  IRProtocol.h   Add it to decode_type_t
  IRReceive.hpp  IRrecv::decode() + printActiveIRProtocols(Print *aSerial) + getProtocolString(decode_type_t aProtocol)
  IRremote.hpp   At 3 occurrences of DECODE_XXX
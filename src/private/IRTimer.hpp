@@ -529,19 +529,19 @@ void timerDisableReceiveInterrupt() {
 #define TIMER_COUNT_TOP  (F_CPU * MICROS_PER_TICK / MICROS_IN_ONE_SECOND)
 
 void timerConfigForReceive() {
-#  if (TIMER_COUNT_TOP < 256)
-    TCCR2A = _BV(WGM21);
-    TCCR2B = _BV(CS20);
-    OCR2A = TIMER_COUNT_TOP;
-    OCR2B = TIMER_COUNT_TOP;
-    TCNT2 = 0;
-#  else
-    TCCR2A = _BV(WGM21);
-    TCCR2B = _BV(CS21);
-    OCR2A = TIMER_COUNT_TOP / 8;
-    OCR2B = TIMER_COUNT_TOP / 8;
-    TCNT2 = 0;
-#  endif
+    if (TIMER_COUNT_TOP < 256) { // TIMER_COUNT_TOP is a variable for USE_RUNTIME_MICROS_PER_TICK
+        TCCR2A = _BV(WGM21);
+        TCCR2B = _BV(CS20);
+        OCR2A = TIMER_COUNT_TOP;
+        OCR2B = TIMER_COUNT_TOP;
+        TCNT2 = 0;
+    } else {
+        TCCR2A = _BV(WGM21);
+        TCCR2B = _BV(CS21);
+        OCR2A = TIMER_COUNT_TOP / 8;
+        OCR2B = TIMER_COUNT_TOP / 8;
+        TCNT2 = 0;
+    }
 }
 
 #  if defined(SEND_PWM_BY_TIMER)
@@ -768,13 +768,23 @@ void timerDisableReceiveInterrupt() {
 #define TIMER_INTR_NAME             TIMER4_OVF_vect
 
 void timerConfigForReceive() {
+    /*
+     * OCR4C has only 10 bits. 100 us at 16 MHz requires 1600, so the prescaler is doubled until the value fits.
+     * The prescaler values CS43 to CS40 = 1, 2, 3 select clock / 1, 2, 4.
+     */
+    uint16_t tTimerCountTop = F_CPU * MICROS_PER_TICK / MICROS_IN_ONE_SECOND; // 800 at 16 MHz
+    uint8_t tClockSelect = _BV(CS40);
+    while (tTimerCountTop > 1023) {
+        tTimerCountTop >>= 1;
+        tClockSelect++;
+    }
     TCCR4A = 0;
-    TCCR4B = _BV(CS40);
+    TCCR4B = tClockSelect;
     TCCR4C = 0;
     TCCR4D = 0;
     TCCR4E = 0;
-    TC4H = (F_CPU * MICROS_PER_TICK / MICROS_IN_ONE_SECOND) >> 8;
-    OCR4C = (F_CPU * MICROS_PER_TICK / MICROS_IN_ONE_SECOND) & 255;
+    TC4H = tTimerCountTop >> 8;
+    OCR4C = tTimerCountTop & 255;
     TC4H = 0;
     TCNT4 = 0;
 }
@@ -939,17 +949,17 @@ void timerDisableReceiveInterrupt() {
 #define TIMER_COUNT_TOP  (F_CPU * MICROS_PER_TICK / MICROS_IN_ONE_SECOND)
 
 void timerConfigForReceive() {
-#  if (TIMER_COUNT_TOP < 256)
-    TCCR0A = _BV(WGM01); // CTC, Top is OCR0A
-    TCCR0B = _BV(CS00);// No prescaling
-    OCR0A = TIMER_COUNT_TOP;
-    TCNT0 = 0;
-#  else
-    TCCR0A = _BV(WGM01);
-    TCCR0B = _BV(CS01); // prescaling by 8
-    OCR0A = TIMER_COUNT_TOP / 8;
-    TCNT0 = 0;
-#  endif
+    if (TIMER_COUNT_TOP < 256) { // TIMER_COUNT_TOP is a variable for USE_RUNTIME_MICROS_PER_TICK
+        TCCR0A = _BV(WGM01); // CTC, Top is OCR0A
+        TCCR0B = _BV(CS00);// No prescaling
+        OCR0A = TIMER_COUNT_TOP;
+        TCNT0 = 0;
+    } else {
+        TCCR0A = _BV(WGM01);
+        TCCR0B = _BV(CS01); // prescaling by 8
+        OCR0A = TIMER_COUNT_TOP / 8;
+        TCNT0 = 0;
+    }
 }
 
 #  if defined(SEND_PWM_BY_TIMER)
@@ -1009,17 +1019,17 @@ void timerDisableReceiveInterrupt() {
 #define TIMER_COUNT_TOP  (F_CPU * MICROS_PER_TICK / MICROS_IN_ONE_SECOND)
 
 void timerConfigForReceive() {
-#  if (TIMER_COUNT_TOP < 256)
-    TCCR1 = _BV(CTC1) | _BV(CS10); // Clear Timer/Counter on Compare Match, Top is OCR1C, No prescaling
-    GTCCR = 0;// normal, non-PWM mode
-    OCR1C = TIMER_COUNT_TOP;
-    TCNT1 = 0;
-#  else
-    TCCR1 = _BV(CTC1) | _BV(CS12); // Clear Timer/Counter on Compare Match, Top is OCR1C, prescaling by 8
-    GTCCR = 0; // normal, non-PWM mode
-    OCR1C = TIMER_COUNT_TOP / 8;
-    TCNT1 = 0;
-#  endif
+    if (TIMER_COUNT_TOP < 256) { // TIMER_COUNT_TOP is a variable for USE_RUNTIME_MICROS_PER_TICK
+        TCCR1 = _BV(CTC1) | _BV(CS10); // Clear Timer/Counter on Compare Match, Top is OCR1C, No prescaling
+        GTCCR = 0;// normal, non-PWM mode
+        OCR1C = TIMER_COUNT_TOP;
+        TCNT1 = 0;
+    } else {
+        TCCR1 = _BV(CTC1) | _BV(CS12); // Clear Timer/Counter on Compare Match, Top is OCR1C, prescaling by 8
+        GTCCR = 0; // normal, non-PWM mode
+        OCR1C = TIMER_COUNT_TOP / 8;
+        TCNT1 = 0;
+    }
 }
 
 #  if defined(SEND_PWM_BY_TIMER)
@@ -1597,7 +1607,7 @@ void timerConfigForReceive() {
      * TIM_DIV256 = 3  //312.5Khz (1 tick = 3.2us - 26843542.4 us max)
      */
     timer1_enable(TIM_DIV16, TIM_EDGE, TIM_LOOP);
-    timer1_write((80 / 16) * MICROS_PER_TICK); // 80 for 80 and 160! MHz clock, 16 for TIM_DIV16 above
+    timer1_write((80 / 16) * MICROS_PER_TICK); // 80 for 80 and 160! MHz clock, 16 for TIM_DIV16 above. 50 to 500 for USE_RUNTIME_MICROS_PER_TICK
 }
 
 /**********************************************************
@@ -1839,7 +1849,7 @@ void timerConfigForReceive() {
         ; // CTRL.SWRST will be cleared by hardware when the peripheral has been reset.
 
     // SAMD51 has F_CPU = 120 MHz
-    TC->CC[0].reg = ((MICROS_PER_TICK * (F_CPU / MICROS_IN_ONE_SECOND)) / 16) - 1;   // (375 - 1);
+    TC->CC[0].reg = ((MICROS_PER_TICK * (F_CPU / MICROS_IN_ONE_SECOND)) / 16) - 1;   // (375 - 1); 74 for 10 us to 749 for 100 us, odd values are 0.07 us short
 
     /*
      * Set timer counter mode to 16 bits, set mode as match frequency, prescaler is DIV16 => 7.5 MHz clock, start counter
@@ -1864,7 +1874,7 @@ void timerConfigForReceive() {
         ; // CTRL.SWRST will be cleared by hardware when the peripheral has been reset.
 
     // SAMD51 has F_CPU = 48 MHz
-    TC->CC[0].reg = ((MICROS_PER_TICK * (F_CPU / MICROS_IN_ONE_SECOND)) / 16) - 1;   // (150 - 1);
+    TC->CC[0].reg = ((MICROS_PER_TICK * (F_CPU / MICROS_IN_ONE_SECOND)) / 16) - 1;   // (150 - 1); 29 for 10 us to 299 for 100 us
 
     /*
      * Set timer counter mode to 16 bits, set mode as match frequency, prescaler is DIV16 => 3 MHz clock, start counter
@@ -2320,6 +2330,34 @@ void timerConfigForSend(uint8_t aFrequencyKHz) {
 }
 #  endif // defined(SEND_PWM_BY_TIMER)
 
+/**********************************************************************************************************************
+ * Host build for the tools in extras/host, activated by the Arduino.h of extras/host.
+ * There is no timer, received frames are supplied by the capture backend functions like replayRawFrame().
+ **********************************************************************************************************************/
+#elif defined(IR_HOST_BUILD)
+void timerEnableReceiveInterrupt() {
+}
+void timerDisableReceiveInterrupt() {
+}
+
+#  if defined(ISR)
+#undef ISR
+#  endif
+#define ISR() void IRTimerInterruptHandler(void)
+
+void timerConfigForReceive() {
+}
+
+#  if defined(SEND_PWM_BY_TIMER)
+void enableSendPWMByTimer() {
+}
+void disableSendPWMByTimer() {
+}
+void timerConfigForSend(uint16_t aFrequencyKHz) {
+    (void) aFrequencyKHz;
+}
+#  endif // defined(SEND_PWM_BY_TIMER)
+
 #else // CPU types
 /***************************************
  * Unknown CPU board